@@ -781,6 +781,7 @@ void olc_delete_ability(char_data *ch, any_vnum vnum) {
 			if (plab->vnum == vnum) {
 				HASH_DEL(GET_ABILITY_HASH(chiter), plab);
 				free(plab);
+				GET_SKILL_CACHE(chiter).valid = FALSE;
 				found = TRUE;
 			}
 		}
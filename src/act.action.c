@@ -544,7 +544,7 @@ void start_picking(char_data *ch) {
 */
 void start_quarrying(char_data *ch) {	
 	if (CAN_INTERACT_ROOM(IN_ROOM(ch), INTERACT_QUARRY) && IS_COMPLETE(IN_ROOM(ch))) {
-		if (get_depletion(IN_ROOM(ch), DPLTN_QUARRY) >= config_get_int("common_depletion")) {
+		if (get_depletion(IN_ROOM(ch), DPLTN_QUARRY) >= CONFIG_INT(CONF_COMMON_DEPLETION)) {
 			msg_to_char(ch, "There's not enough left to quarry here.\r\n");
 		}
 		else {
@@ -1875,7 +1875,7 @@ void process_picking(char_data *ch) {
 	if (GET_ACTION_TIMER(ch) <= 0) {
 		GET_ACTION(ch) = ACT_NONE;
 		
-		if (get_depletion(IN_ROOM(ch), DPLTN_PICK) >= (ROOM_SECT_FLAGGED(IN_ROOM(ch), SECTF_CROP) ? pick_depletion : (IS_ANY_BUILDING(IN_ROOM(ch)) ? garden_depletion : config_get_int("common_depletion")))) {
+		if (get_depletion(IN_ROOM(ch), DPLTN_PICK) >= (ROOM_SECT_FLAGGED(IN_ROOM(ch), SECTF_CROP) ? pick_depletion : (IS_ANY_BUILDING(IN_ROOM(ch)) ? garden_depletion : CONFIG_INT(CONF_COMMON_DEPLETION)))) {
 			msg_to_char(ch, "You can't find anything here left to pick.\r\n");
 			act("$n stops looking for things to pick as $e comes up empty-handed.", TRUE, ch, NULL, NULL, TO_ROOM);
 		}
@@ -2001,7 +2001,7 @@ void process_prospecting(char_data *ch) {
 void process_quarrying(char_data *ch) {
 	room_data *in_room;
 	
-	if (!CAN_INTERACT_ROOM(IN_ROOM(ch), INTERACT_QUARRY) || !IS_COMPLETE(IN_ROOM(ch)) || get_depletion(IN_ROOM(ch), DPLTN_QUARRY) >= config_get_int("common_depletion")) {
+	if (!CAN_INTERACT_ROOM(IN_ROOM(ch), INTERACT_QUARRY) || !IS_COMPLETE(IN_ROOM(ch)) || get_depletion(IN_ROOM(ch), DPLTN_QUARRY) >= CONFIG_INT(CONF_COMMON_DEPLETION)) {
 		msg_to_char(ch, "You can't quarry anything here.\r\n");
 		cancel_action(ch);
 		return;
@@ -50,6 +50,7 @@ extern const char *trade_overunder[];
 // external funcs
 extern bool can_claim(char_data *ch);
 extern int city_points_available(empire_data *emp);
+void clear_map_icon_cache(room_data *room, struct map_data *map);
 void clear_private_owner(int id);
 void deactivate_workforce(empire_data *emp, int island_id, int type);
 void deactivate_workforce_room(empire_data *emp, room_data *room);
@@ -1219,6 +1220,7 @@ void downgrade_city(char_data *ch, char *argument) {
 
 	if (city->type > 0) {
 		city->type--;
+		clear_map_icon_cache(city->location, NULL);
 		log_to_empire(emp, ELOG_TERRITORY, "%s has downgraded %s to a %s", PERS(ch, ch, 1), city->name, city_type[city->type].name);
 	}
 	else {
@@ -1576,6 +1578,7 @@ void upgrade_city(char_data *ch, char *argument) {
 	}
 	
 	city->type++;
+	clear_map_icon_cache(city->location, NULL);
 	
 	log_to_empire(emp, ELOG_TERRITORY, "%s has upgraded %s to a %s", PERS(ch, ch, 1), city->name, city_type[city->type].name);
 	read_empire_territory(emp, FALSE);
@@ -3728,6 +3731,10 @@ ACMD(do_empire_inventory) {
 
 
 ACMD(do_enroll) {
+	void add_npc_to_worker_cells(empire_data *emp, struct empire_npc_data *npc);
+	void remove_territory_chores(empire_data *emp, struct empire_territory_data *ter);
+	void schedule_territory_chores(empire_data *emp, struct empire_territory_data *ter);
+	
 	struct empire_island *from_isle, *next_isle, *isle;
 	struct empire_territory_data *ter, *next_ter;
 	struct empire_npc_data *npc;
@@ -3947,11 +3954,16 @@ ACMD(do_enroll) {
 				// switch npc allegiance
 				for (npc = ter->npcs; npc; npc = npc->next) {
 					npc->empire_id = EMPIRE_VNUM(e);
+					add_npc_to_worker_cells(e, npc);	// moves it from the old empire's index
 				}
 				
 				// move territory over
+				remove_territory_chores(old, ter);
+				HASH_DEL(EMPIRE_TERRITORY_HASH(old), ter);
 				ter->next = EMPIRE_TERRITORY_LIST(e);
 				EMPIRE_TERRITORY_LIST(e) = ter;
+				HASH_ADD_INT(EMPIRE_TERRITORY_HASH(e), vnum, ter);
+				schedule_territory_chores(e, ter);
 			}
 			
 			EMPIRE_TERRITORY_LIST(old) = NULL;
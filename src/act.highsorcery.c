@@ -37,6 +37,7 @@
 // external vars
 
 // external funcs
+void clear_map_icon_cache(room_data *room, struct map_data *map);	// mapview.c
 void scale_item_to_level(obj_data *obj, int level);
 extern bool trigger_counterspell(char_data *ch);	// spells.c
 void trigger_distrust_from_hostile(char_data *ch, empire_data *emp);	// fight.c
@@ -1043,6 +1044,7 @@ ACMD(do_mirrorimage) {
 	
 	// restrings
 	GET_PC_NAME(mob) = str_dup(PERS(ch, ch, FALSE));
+	index_char_keywords(mob);
 	GET_SHORT_DESC(mob) = str_dup(GET_PC_NAME(mob));
 	GET_REAL_SEX(mob) = GET_SEX(ch);	// need this for some desc stuff
 	
@@ -1531,6 +1533,7 @@ RITUAL_FINISH_FUNC(perform_chant_of_illusions) {
 	
 	SET_BIT(ROOM_AFF_FLAGS(IN_ROOM(ch)), ROOM_AFF_CHAMELEON);
 	SET_BIT(ROOM_BASE_FLAGS(IN_ROOM(ch)), ROOM_AFF_CHAMELEON);
+	clear_map_icon_cache(IN_ROOM(ch), NULL);
 	msg_to_char(ch, "As you finish the chant, the road is cloaked in illusion!\r\n");
 }
 
@@ -1811,6 +1814,7 @@ RITUAL_FINISH_FUNC(perform_ritual_of_defense) {
 	}
 	SET_BIT(ROOM_AFF_FLAGS(IN_ROOM(ch)), ROOM_AFF_NO_FLY);
 	SET_BIT(ROOM_BASE_FLAGS(IN_ROOM(ch)), ROOM_AFF_NO_FLY);
+	clear_map_icon_cache(IN_ROOM(ch), NULL);
 }
 
 
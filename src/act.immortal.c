@@ -1499,6 +1499,7 @@ int perform_set(char_data *ch, char_data *vict, int mode, char *val_arg) {
 			GET_LASTNAME(vict) = str_dup(val_arg);
     		sprintf(output, "%s's last name is now: %s", GET_NAME(vict), GET_LASTNAME(vict));
 		}
+		update_player_name_index(vict);
 	}
 	else if SET_CASE("bonustrait") {
 		void apply_bonus_trait(char_data *ch, bitvector_t trait, bool add);
@@ -1765,6 +1766,7 @@ int perform_set(char_data *ch, char_data *vict, int mode, char *val_arg) {
 			free(GET_PC_NAME(vict));
 		}
 		GET_PC_NAME(vict) = strdup(CAP(newname));
+		update_player_name_index(vict);
 		
 		// ensure we really have the right index
 		if ((found_index = find_player_index_by_idnum(GET_IDNUM(vict)))) {
@@ -2006,6 +2008,34 @@ struct show_island_data *find_or_make_show_island(int island, struct show_island
 }
 
 
+SHOW(show_input) {
+	char line[256];
+	descriptor_data *d;
+	size_t size;
+	
+	size = snprintf(buf, sizeof(buf), "Input limits: %d commands/sec (burst %d), %d bytes/sec (burst %d), queue %d\r\n", CONFIG_INT(CONF_INPUT_COMMANDS_PER_SECOND), CONFIG_INT(CONF_INPUT_COMMAND_BURST), CONFIG_INT(CONF_INPUT_BYTES_PER_SECOND), CONFIG_INT(CONF_INPUT_BYTE_BURST), CONFIG_INT(CONF_MAX_INPUT_QUEUE));
+	size += snprintf(buf + size, sizeof(buf) - size, " %-20.20s %5s %6s %7s %9s %11s %8s %7s\r\n", "Name", "Queue", "Cmds", "Bytes", "Commands", "Total bytes", "Deferred", "Dropped");
+	
+	for (d = descriptor_list; d; d = d->next) {
+		if (d->character && !CAN_SEE(ch, d->character)) {
+			continue;
+		}
+		
+		snprintf(line, sizeof(line), " %-20.20s %5d %6.1f %7.0f %9lu %11lu %8lu %7lu\r\n", d->character ? GET_NAME(d->character) : "(connecting)", d->input.count, d->cmd_tokens, d->byte_tokens, d->input_commands, d->input_bytes, d->input_deferred, d->input_dropped);
+		if (size + strlen(line) < sizeof(buf)) {
+			strcat(buf, line);
+			size += strlen(line);
+		}
+		else {
+			size += snprintf(buf + size, sizeof(buf) - size, "OVERFLOW\r\n");
+			break;
+		}
+	}
+	
+	page_string(ch->desc, buf, TRUE);
+}
+
+
 SHOW(show_islands) {
 	struct empire_unique_storage *uniq;
 	struct empire_storage_data *store;
@@ -2278,6 +2308,24 @@ SHOW(show_stats) {
 }
 
 
+SHOW(show_slabs) {
+	struct slab_pool *sp;
+	int iter, free_slots;
+	
+	msg_to_char(ch, "Slab pools%s:\r\n", SLAB_POISON ? " (poisoning freed slots)" : "");
+	msg_to_char(ch, " %-14s %5s %8s %8s %8s %7s %11s %11s\r\n", "Pool", "Size", "In use", "Peak", "Free", "Blocks", "Allocs", "Frees");
+	
+	for (iter = 0; iter < NUM_SLABS; ++iter) {
+		if (!(sp = slab_pool_info(iter))) {
+			continue;
+		}
+		
+		free_slots = sp->num_blocks * sp->per_block - sp->in_use;
+		msg_to_char(ch, " %-14s %5d %8d %8d %8d %7d %11llu %11llu\r\n", sp->name, (int) sp->size, sp->in_use, sp->peak, free_slots, sp->num_blocks, sp->total_allocs, sp->total_frees);
+	}
+}
+
+
 SHOW(show_site) {
 	char buf[MAX_STRING_LENGTH], line[256];
 	player_index_data *index, *next_index;
@@ -2480,14 +2528,27 @@ SHOW(show_players) {
 SHOW(show_terrain) {
 	extern int stats_get_crop_count(crop_data *cp);
 	extern int stats_get_sector_count(sector_data *sect);
-	void update_world_count();
+	int update_world_count(bool verify);
 	
+	char arg[MAX_INPUT_LENGTH];
 	sector_data *sect, *next_sect;
 	crop_data *crop, *next_crop;
 	int count, total, this;
 	
-	// fresh numbers
-	update_world_count();
+	// counts are kept live; 'verify' recounts the whole map to check them
+	one_word(argument, arg);
+	if (!str_cmp(arg, "verify")) {
+		if ((count = update_world_count(TRUE)) > 0) {
+			msg_to_char(ch, "Recounted the world: %d count%s had drifted (see the syslog).\r\n", count, PLURAL(count));
+		}
+		else {
+			msg_to_char(ch, "Recounted the world: all counts were correct.\r\n");
+		}
+	}
+	else if (*arg) {
+		msg_to_char(ch, "Usage: show terrain [verify]\r\n");
+		return;
+	}
 	
 	// output
 	total = count = 0;
@@ -4943,6 +5004,7 @@ ACMD(do_clearabilities) {
 
 ACMD(do_date) {
 	extern time_t boot_time;
+	extern unsigned long pulse_overruns, pulses_behind;
 	char *tmstr;
 	time_t mytime;
 	int d, h, m;
@@ -4964,6 +5026,7 @@ ACMD(do_date) {
 		m = (mytime / 60) % 60;
 
 		sprintf(buf, "Up since %s: %d day%s, %d:%02d\r\n", tmstr, d, ((d == 1) ? "" : "s"), h, m);
+		sprintf(buf + strlen(buf), "Pulse overruns: %lu (%lu pulse%s behind)\r\n", pulse_overruns, pulses_behind, PLURAL(pulses_behind));
 	}
 
 	send_to_char(buf, ch);
@@ -6031,6 +6094,7 @@ ACMD(do_oset) {
 				GET_OBJ_KEYWORDS(obj) = str_dup(argument);
 				msg_to_char(ch, "You change its keywords to '%s'.\r\n", GET_OBJ_KEYWORDS(obj));
 			}
+			index_obj_keywords(obj);
 		}
 	}
 	else if (is_abbrev(field_arg, "longdescription")) {
@@ -6078,7 +6142,7 @@ ACMD(do_oset) {
 			msg_to_char(ch, "Set the timer to what?\r\n");
 		}
 		else {
-			GET_OBJ_TIMER(obj) = atoi(argument);
+			SET_OBJ_TIMER(obj, atoi(argument));
 			msg_to_char(ch, "You change its timer to %d.\r\n", GET_OBJ_TIMER(obj));
 		}
 	}
@@ -6781,6 +6845,8 @@ ACMD(do_show) {
 		{ "factions", LVL_START_IMM, show_factions },
 		{ "dailycycle", LVL_START_IMM, show_dailycycle },
 		{ "data", LVL_CIMPL, show_data },
+		{ "input", LVL_START_IMM, show_input },
+		{ "slabs", LVL_GOD, show_slabs },
 
 		// last
 		{ "\n", 0, NULL }
@@ -2505,8 +2505,8 @@ ACMD(do_mapsize) {
 		msg_to_char(ch, "Your map size is now automatic.\r\n");
 	
 	}
-	else if ((size = atoi(argument)) < 3 || size > (config_get_int("max_map_size") * 2 + 1)) {
-		msg_to_char(ch, "You must choose a size between 3 and %d.\r\n", config_get_int("max_map_size") * 2 + 1);
+	else if ((size = atoi(argument)) < 3 || size > (CONFIG_INT(CONF_MAX_MAP_SIZE) * 2 + 1)) {
+		msg_to_char(ch, "You must choose a size between 3 and %d.\r\n", CONFIG_INT(CONF_MAX_MAP_SIZE) * 2 + 1);
 	}
 	else {
 		GET_MAPSIZE(ch) = size/2;
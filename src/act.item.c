@@ -120,7 +120,7 @@ INTERACTION_FUNC(combine_obj_interact) {
 	scale_item_to_level(new_obj, GET_OBJ_CURRENT_SCALE_LEVEL(inter_item));
 	
 	if (GET_OBJ_TIMER(new_obj) != UNLIMITED && GET_OBJ_TIMER(inter_item) != UNLIMITED) {
-		GET_OBJ_TIMER(new_obj) = MIN(GET_OBJ_TIMER(new_obj), GET_OBJ_TIMER(inter_item));
+		SET_OBJ_TIMER(new_obj, MIN(GET_OBJ_TIMER(new_obj), GET_OBJ_TIMER(inter_item)));
 	}
 	
 	extract_resources(ch, res, can_use_room(ch, IN_ROOM(ch), MEMBERS_ONLY), NULL);
@@ -870,7 +870,7 @@ INTERACTION_FUNC(separate_obj_interact) {
 		scale_item_to_level(new_obj, GET_OBJ_CURRENT_SCALE_LEVEL(inter_item));
 	
 		if (GET_OBJ_TIMER(new_obj) != UNLIMITED && GET_OBJ_TIMER(inter_item) != UNLIMITED) {
-			GET_OBJ_TIMER(new_obj) = MIN(GET_OBJ_TIMER(new_obj), GET_OBJ_TIMER(inter_item));
+			SET_OBJ_TIMER(new_obj, MIN(GET_OBJ_TIMER(new_obj), GET_OBJ_TIMER(inter_item)));
 		}
 		
 		// ownership
@@ -1585,7 +1585,7 @@ void fill_from_room(char_data *ch, obj_data *obj) {
 
 	/* First same type liq. */
 	GET_OBJ_VAL(obj, VAL_DRINK_CONTAINER_TYPE) = liquid;
-	GET_OBJ_TIMER(obj) = timer;
+	SET_OBJ_TIMER(obj, timer);
 
 	GET_OBJ_VAL(obj, VAL_DRINK_CONTAINER_CONTENTS) = GET_DRINK_CONTAINER_CAPACITY(obj);
 }
@@ -3764,7 +3764,7 @@ ACMD(do_drink) {
 		GET_OBJ_VAL(obj, VAL_DRINK_CONTAINER_CONTENTS) -= amount;
 		if (GET_DRINK_CONTAINER_CONTENTS(obj) <= 0) {	/* The last bit */
 			GET_OBJ_VAL(obj, VAL_DRINK_CONTAINER_TYPE) = 0;
-			GET_OBJ_TIMER(obj) = UNLIMITED;
+			SET_OBJ_TIMER(obj, UNLIMITED);
 		}
 		
 		// ensure binding
@@ -4043,13 +4043,13 @@ ACMD(do_eat) {
 		if (GET_OBJ_AFF_FLAGS(food)) {
 			af = create_flag_aff(ATYPE_WELL_FED, eat_hours MUD_HOURS, GET_OBJ_AFF_FLAGS(food), ch);
 			affect_to_char(ch, af);
-			free(af);
+			FREE_SLAB(SLAB_AFFECT, af);
 		}
 
 		LL_FOREACH(GET_OBJ_APPLIES(food), apply) {
 			af = create_mod_aff(ATYPE_WELL_FED, eat_hours MUD_HOURS, apply->location, apply->modifier, ch);
 			affect_to_char(ch, af);
-			free(af);
+			FREE_SLAB(SLAB_AFFECT, af);
 		}
 		
 		msg_to_char(ch, "You feel well-fed.\r\n");
@@ -4747,7 +4747,7 @@ ACMD(do_pour) {
 	GET_OBJ_VAL(to_obj, VAL_DRINK_CONTAINER_CONTENTS) += amount;
 	
 	// copy the timer on the liquid, even if UNLIMITED
-	GET_OBJ_TIMER(to_obj) = GET_OBJ_TIMER(from_obj);
+	SET_OBJ_TIMER(to_obj, GET_OBJ_TIMER(from_obj));
 
 	// check if there was too little to pour, and adjust
 	if (GET_DRINK_CONTAINER_CONTENTS(from_obj) <= 0) {
@@ -4756,7 +4756,7 @@ ACMD(do_pour) {
 		amount += GET_DRINK_CONTAINER_CONTENTS(from_obj);
 		GET_OBJ_VAL(from_obj, VAL_DRINK_CONTAINER_CONTENTS) = 0;
 		GET_OBJ_VAL(from_obj, VAL_DRINK_CONTAINER_TYPE) = 0;
-		GET_OBJ_TIMER(from_obj) = UNLIMITED;
+		SET_OBJ_TIMER(from_obj, UNLIMITED);
 	}
 	
 	// check max
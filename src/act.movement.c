@@ -85,7 +85,7 @@ void add_tracks(char_data *ch, room_data *room, byte dir) {
 			gain_ability_exp(ch, ABIL_UNSEEN_PASSING, 5);
 		}
 		else {
-			CREATE(track, struct track_data, 1);
+			CREATE_SLAB(track, struct track_data, SLAB_TRACK);
 		
 			track->timestamp = time(0);
 			track->dir = dir;
@@ -101,6 +101,7 @@ void add_tracks(char_data *ch, room_data *room, byte dir) {
 			
 			track->next = ROOM_TRACKS(room);
 			ROOM_TRACKS(room) = track;
+			schedule_room_updates(room);
 		}
 	}
 }
@@ -1814,7 +1815,7 @@ ACMD(do_portal) {
 	// portal this side
 	portal = read_object(o_PORTAL, TRUE);
 	GET_OBJ_VAL(portal, VAL_PORTAL_TARGET_VNUM) = GET_ROOM_VNUM(target);
-	GET_OBJ_TIMER(portal) = 5;
+	SET_OBJ_TIMER(portal, 5);
 	obj_to_room(portal, IN_ROOM(ch));
 	
 	if (all_access) {
@@ -1831,7 +1832,7 @@ ACMD(do_portal) {
 	// portal other side
 	end = read_object(o_PORTAL, TRUE);
 	GET_OBJ_VAL(end, VAL_PORTAL_TARGET_VNUM) = GET_ROOM_VNUM(IN_ROOM(ch));
-	GET_OBJ_TIMER(end) = 5;
+	SET_OBJ_TIMER(end, 5);
 	obj_to_room(end, target);
 	if (GET_ROOM_VNUM(IN_ROOM(end))) {
 		act("$p spins open!", TRUE, ROOM_PEOPLE(IN_ROOM(end)), end, 0, TO_ROOM | TO_CHAR);
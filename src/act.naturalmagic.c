@@ -532,7 +532,7 @@ ACMD(do_confer) {
 			
 			// use affect_to_char instead of affect_join because we will allow multiple copies of this with different durations
 			affect_to_char(vict, aff);
-			free(aff);
+			FREE_SLAB(SLAB_AFFECT, aff);
 		}
 		
 		// separately ...
@@ -542,7 +542,7 @@ ACMD(do_confer) {
 			
 			// use affect_to_char instead of affect_join because we will allow multiple copies of this with different durations
 			affect_to_char(ch, aff);
-			free(aff);
+			FREE_SLAB(SLAB_AFFECT, aff);
 		}
 	}
 }
@@ -2002,7 +2002,7 @@ ACMD(do_milk) {
 		amount = GET_DRINK_CONTAINER_CAPACITY(cont) - GET_DRINK_CONTAINER_CONTENTS(cont);
 		GET_OBJ_VAL(cont, VAL_DRINK_CONTAINER_CONTENTS) += amount;
 		GET_OBJ_VAL(cont, VAL_DRINK_CONTAINER_TYPE) = LIQ_MILK;
-		GET_OBJ_TIMER(cont) = 72;	// mud hours
+		SET_OBJ_TIMER(cont, 72);	// mud hours
 	}
 }
 
@@ -296,6 +296,7 @@ void undisguise(char_data *ch) {
 		*lbuf = UPPER(*lbuf);
 		
 		REMOVE_BIT(PLR_FLAGS(ch), PLR_DISGUISED);
+		update_player_name_index(ch);
 		
 		msg_to_char(ch, "You take off your disguise.\r\n");
 		act(lbuf, TRUE, ch, NULL, NULL, TO_ROOM);
@@ -761,7 +762,7 @@ ACMD(do_darkness) {
 		msg_to_char(ch, "You draw upon the shadows to blanket the area in an inky darkness!\r\n");
 		act("Shadows seem to spread from $n, blanketing the area in an inky darkness!", FALSE, ch, 0, 0, TO_ROOM);
 
-		CREATE(af, struct affected_type, 1);
+		CREATE_SLAB(af, struct affected_type, SLAB_AFFECT);
 		af->type = ATYPE_DARKNESS;
 		af->cast_by = CAST_BY_ID(ch);
 		af->duration = 1;
@@ -770,7 +771,7 @@ ACMD(do_darkness) {
 		af->bitvector = ROOM_AFF_DARK;
 
 		affect_to_room(IN_ROOM(ch), af);
-		free(af);	// affect_to_room duplicates affects
+		FREE_SLAB(SLAB_AFFECT, af);	// affect_to_room duplicates affects
 		gain_ability_exp(ch, ABIL_DARKNESS, 20);
 		
 		charge_ability_cost(ch, MOVE, cost, COOLDOWN_DARKNESS, 15, WAIT_ABILITY);
@@ -829,6 +830,7 @@ ACMD(do_disguise) {
 			free(GET_DISGUISED_NAME(ch));
 		}
 		GET_DISGUISED_NAME(ch) = str_dup(PERS(vict, vict, FALSE));
+		update_player_name_index(ch);
 
 		// copy the sex
 		GET_DISGUISED_SEX(ch) = GET_SEX(vict);
@@ -781,7 +781,7 @@ void finish_gen_craft(char_data *ch) {
 		GET_OBJ_VAL(obj, VAL_DRINK_CONTAINER_TYPE) = GET_CRAFT_OBJECT(type);
 	
 		// set it to go bad... very bad
-		GET_OBJ_TIMER(obj) = SOUP_TIMER;
+		SET_OBJ_TIMER(obj, SOUP_TIMER);
 		if (CAN_WEAR(obj, ITEM_WEAR_TAKE)) {
 			obj_to_char(obj, ch);
 		}
@@ -1728,6 +1728,7 @@ ACMD(do_reforge) {
 				free(GET_OBJ_KEYWORDS(obj));
 			}
 			GET_OBJ_KEYWORDS(obj) = str_dup(skip_filler(argument));
+			index_obj_keywords(obj);
 			
 			// rename short desc
 			if (!proto || GET_OBJ_SHORT_DESC(obj) != GET_OBJ_SHORT_DESC(proto)) {
@@ -1783,7 +1784,7 @@ ACMD(do_reforge) {
 			// re-apply
 			new->stolen_timer = old_stolen_time;
 			GET_STOLEN_FROM(new) = old_stolen_from;
-			GET_OBJ_TIMER(new) = old_timer;
+			SET_OBJ_TIMER(new, old_timer);
 			if (level > 0) {
 				scale_item_to_level(new, level);
 			}
@@ -1860,7 +1861,7 @@ ACMD(do_reforge) {
 			// re-apply values
 			new->stolen_timer = old_stolen_time;
 			GET_STOLEN_FROM(new) = old_stolen_from;
-			GET_OBJ_TIMER(new) = old_timer;
+			SET_OBJ_TIMER(new, old_timer);
 			if (level > 0) {
 				scale_item_to_level(new, level);
 			}
@@ -611,7 +611,7 @@ ACMD(do_alacrity) {
 	
 	af = create_mod_aff(ATYPE_ALACRITY, UNLIMITED, APPLY_BLOOD_UPKEEP, 3, ch);
 	affect_to_char(ch, af);
-	free(af);
+	FREE_SLAB(SLAB_AFFECT, af);
 
 	charge_ability_cost(ch, BLOOD, cost, NOTHING, 0, WAIT_ABILITY);
 	gain_ability_exp(ch, ABIL_ALACRITY, 20);
@@ -803,7 +803,7 @@ ACMD(do_boost) {
 			
 			af = create_mod_aff(ATYPE_BOOST, 3 MUD_HOURS, APPLY_BLOOD_UPKEEP, 1, ch);
 			affect_to_char(ch, af);
-			free(af);
+			FREE_SLAB(SLAB_AFFECT, af);
 
 			charge_ability_cost(ch, BLOOD, cost, NOTHING, 0, WAIT_ABILITY);
 
@@ -826,7 +826,7 @@ ACMD(do_boost) {
 			
 			af = create_mod_aff(ATYPE_BOOST, 3 MUD_HOURS, APPLY_BLOOD_UPKEEP, 1, ch);
 			affect_to_char(ch, af);
-			free(af);
+			FREE_SLAB(SLAB_AFFECT, af);
 
 			charge_ability_cost(ch, BLOOD, cost, NOTHING, 0, WAIT_ABILITY);
 
@@ -849,7 +849,7 @@ ACMD(do_boost) {
 			
 			af = create_mod_aff(ATYPE_BOOST, 3 MUD_HOURS, APPLY_BLOOD_UPKEEP, 1, ch);
 			affect_to_char(ch, af);
-			free(af);
+			FREE_SLAB(SLAB_AFFECT, af);
 
 			charge_ability_cost(ch, BLOOD, cost, NOTHING, 0, WAIT_ABILITY);
 
@@ -904,7 +904,7 @@ ACMD(do_claws) {
 			
 	af = create_mod_aff(ATYPE_CLAWS, UNLIMITED, APPLY_BLOOD_UPKEEP, 2, ch);
 	affect_to_char(ch, af);
-	free(af);
+	FREE_SLAB(SLAB_AFFECT, af);
 
 	charge_ability_cost(ch, BLOOD, cost, NOTHING, 0, WAIT_ABILITY);
 	gain_ability_exp(ch, ABIL_CLAWS, 20);
@@ -1027,7 +1027,7 @@ ACMD(do_deathshroud) {
 			
 		af = create_mod_aff(ATYPE_DEATHSHROUD, UNLIMITED, APPLY_BLOOD_UPKEEP, 1, ch);
 		affect_to_char(ch, af);
-		free(af);
+		FREE_SLAB(SLAB_AFFECT, af);
 
 		GET_POS(ch) = POS_SLEEPING;
 		charge_ability_cost(ch, BLOOD, cost, NOTHING, 0, WAIT_ABILITY);
@@ -1097,7 +1097,7 @@ ACMD(do_majesty) {
 			
 		af = create_mod_aff(ATYPE_MAJESTY, UNLIMITED, APPLY_BLOOD_UPKEEP, 3, ch);
 		affect_to_char(ch, af);
-		free(af);
+		FREE_SLAB(SLAB_AFFECT, af);
 	}
 	
 	command_lag(ch, WAIT_ABILITY);
@@ -1143,7 +1143,7 @@ ACMD(do_mummify) {
 			
 		af = create_mod_aff(ATYPE_MUMMIFY, UNLIMITED, APPLY_BLOOD_UPKEEP, 1, ch);
 		affect_to_char(ch, af);
-		free(af);
+		FREE_SLAB(SLAB_AFFECT, af);
 		
 		gain_ability_exp(ch, ABIL_MUMMIFY, 50);
 	}
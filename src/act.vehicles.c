@@ -670,6 +670,7 @@ void do_customize_vehicle(char_data *ch, char *argument) {
 			if (proto && VEH_KEYWORDS(veh) != VEH_KEYWORDS(proto)) {
 				free(VEH_KEYWORDS(veh));
 				VEH_KEYWORDS(veh) = VEH_KEYWORDS(proto);
+				index_vehicle_keywords(veh);
 			}
 			if (proto && VEH_LONG_DESC(veh) != VEH_LONG_DESC(proto) && strstr(VEH_LONG_DESC(veh), VEH_LONG_DESC(proto))) {
 				free(VEH_LONG_DESC(veh));
@@ -699,6 +700,7 @@ void do_customize_vehicle(char_data *ch, char *argument) {
 				free(VEH_KEYWORDS(veh));
 			}
 			VEH_KEYWORDS(veh) = str_dup(buf);
+			index_vehicle_keywords(veh);
 			
 			// optionally, change the longdesc too
 			if (proto && (VEH_LONG_DESC(veh) == VEH_LONG_DESC(proto) || strstr(VEH_LONG_DESC(veh), VEH_LONG_DESC(proto)))) {
@@ -1702,8 +1702,8 @@ OLC_MODULE(archedit_attribute) {
 	else if ((att = get_attribute_by_name(att_arg)) == -1) {
 		msg_to_char(ch, "Unknown attribute '%s'.\r\n", att_arg);
 	}
-	else if ((num = atoi(num_arg)) < (-1 * config_get_int("max_player_attribute")) || num > config_get_int("max_player_attribute")) {
-		msg_to_char(ch, "You must choose a number between -%d and %d.\r\n", config_get_int("max_player_attribute"), config_get_int("max_player_attribute"));
+	else if ((num = atoi(num_arg)) < (-1 * CONFIG_INT(CONF_MAX_PLAYER_ATTRIBUTE)) || num > CONFIG_INT(CONF_MAX_PLAYER_ATTRIBUTE)) {
+		msg_to_char(ch, "You must choose a number between -%d and %d.\r\n", CONFIG_INT(CONF_MAX_PLAYER_ATTRIBUTE), CONFIG_INT(CONF_MAX_PLAYER_ATTRIBUTE));
 	}
 	else {
 		GET_ARCH_ATTRIBUTE(arch, att) = num;
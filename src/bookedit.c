@@ -101,7 +101,7 @@ obj_data *create_book_obj(book_data *book) {
 	
 	GET_OBJ_TYPE(obj) = ITEM_BOOK;
 	GET_OBJ_WEAR(obj) = ITEM_WEAR_TAKE;
-	GET_OBJ_TIMER(obj) = UNLIMITED;
+	SET_OBJ_TIMER(obj, UNLIMITED);
 	GET_OBJ_VAL(obj, VAL_BOOK_ID) = book->vnum;
 	
 	return obj;
@@ -39,11 +39,13 @@ void setup_tunnel_entrance(char_data *ch, room_data *room, int dir);
 // externs
 void adjust_building_tech(empire_data *emp, room_data *room, bool add);
 extern bool can_claim(char_data *ch);
+void clear_map_icon_cache(room_data *room, struct map_data *map);
 extern struct resource_data *copy_resource_list(struct resource_data *input);
 void delete_room_npcs(room_data *room, struct empire_territory_data *ter);
 void free_complex_data(struct complex_room_data *data);
 extern room_data *create_room();
 void scale_item_to_level(obj_data *obj, int level);
+void schedule_room_chores(room_data *room);
 void stop_room_action(room_data *room, int action, int chore);
 
 // external vars
@@ -153,6 +155,8 @@ void complete_building(room_data *room) {
 	// remove incomplete
 	REMOVE_BIT(ROOM_AFF_FLAGS(room), ROOM_AFF_INCOMPLETE);
 	REMOVE_BIT(ROOM_BASE_FLAGS(room), ROOM_AFF_INCOMPLETE);
+	clear_map_icon_cache(room, NULL);	// neighbors attach to completed buildings
+	schedule_room_chores(room);	// now needs the building's own chores
 	
 	complete_wtrigger(room);
 	
@@ -269,6 +273,7 @@ void construct_tunnel(char_data *ch, int dir, room_data *entrance, room_data *ex
 	GET_BUILDING_RESOURCES(entrance) = copy_resource_list(resources);
 	SET_BIT(ROOM_BASE_FLAGS(entrance), ROOM_AFF_INCOMPLETE);
 	SET_BIT(ROOM_AFF_FLAGS(entrance), ROOM_AFF_INCOMPLETE);
+	schedule_room_chores(entrance);
 	create_exit(entrance, IN_ROOM(ch), rev_dir[dir], FALSE);
 
 	// exit
@@ -276,6 +281,7 @@ void construct_tunnel(char_data *ch, int dir, room_data *entrance, room_data *ex
 	GET_BUILDING_RESOURCES(exit) = copy_resource_list(resources);
 	SET_BIT(ROOM_BASE_FLAGS(exit), ROOM_AFF_INCOMPLETE);
 	SET_BIT(ROOM_AFF_FLAGS(exit), ROOM_AFF_INCOMPLETE);
+	schedule_room_chores(exit);
 	to_room = real_shift(exit, shift_dir[dir][0], shift_dir[dir][1]);
 	create_exit(exit, to_room, dir, FALSE);
 
@@ -283,7 +289,7 @@ void construct_tunnel(char_data *ch, int dir, room_data *entrance, room_data *ex
 	for (iter = 0; iter < length; ++iter) {
 		new_room = create_room();
 		attach_building_to_room(building_proto(RTYPE_TUNNEL), new_room, TRUE);
-		COMPLEX_DATA(new_room)->home_room = (iter <= length/2) ? entrance : exit;
+		set_room_home(new_room, (iter <= length/2) ? entrance : exit);
 		GET_BUILDING_RESOURCES(new_room) = copy_resource_list(resources);
 		SET_BIT(ROOM_BASE_FLAGS(new_room), ROOM_AFF_INCOMPLETE);
 		SET_BIT(ROOM_AFF_FLAGS(new_room), ROOM_AFF_INCOMPLETE);
@@ -371,7 +377,7 @@ void disassociate_building(room_data *room) {
 	perform_change_sect(room, NULL, BASE_SECT(room));
 	
 	if (COMPLEX_DATA(room)) {
-		COMPLEX_DATA(room)->home_room = NULL;
+		set_room_home(room, NULL);
 	}
 	
 	// some extra data safely clears now
@@ -404,7 +410,7 @@ void disassociate_building(room_data *room) {
 				obj_to_room(ROOM_CONTENTS(iter), room);
 			}
 
-			COMPLEX_DATA(iter)->home_room = NULL;
+			set_room_home(iter, NULL);
 			delete_room(iter, FALSE);	// must check_all_exits
 			deleted = TRUE;
 		}
@@ -1050,6 +1056,8 @@ void start_dismantle_building(room_data *loc) {
 
 	SET_BIT(ROOM_AFF_FLAGS(loc), ROOM_AFF_DISMANTLING);
 	SET_BIT(ROOM_BASE_FLAGS(loc), ROOM_AFF_DISMANTLING);
+	clear_map_icon_cache(loc, NULL);	// neighbors no longer attach to it
+	schedule_room_chores(loc);
 	delete_room_npcs(loc, NULL);
 	
 	if (loc && ROOM_OWNER(loc) && GET_BUILDING(loc) && complete) {
@@ -1344,6 +1352,7 @@ ACMD(do_build) {
 	SET_BIT(ROOM_AFF_FLAGS(IN_ROOM(ch)), ROOM_AFF_INCOMPLETE);
 	GET_BUILDING_RESOURCES(IN_ROOM(ch)) = copy_resource_list(GET_CRAFT_RESOURCES(type));
 	special_building_setup(ch, IN_ROOM(ch));
+	schedule_room_chores(IN_ROOM(ch));
 	
 	// can_claim checks total available land, but the outside is check done within this block
 	if (!ROOM_OWNER(IN_ROOM(ch)) && can_claim(ch) && !ROOM_AFF_FLAGGED(IN_ROOM(ch), ROOM_AFF_UNCLAIMABLE)) {
@@ -1620,7 +1629,6 @@ ACMD(do_designate) {
 	extern struct empire_territory_data *create_territory_entry(empire_data *emp, room_data *room);
 	void delete_territory_npc(struct empire_territory_data *ter, struct empire_npc_data *npc);
 	extern bld_data *get_building_by_name(char *name, bool room_only);
-	void sort_world_table();
 	
 	struct empire_territory_data *ter;
 	struct room_direction_data *ex;
@@ -1743,7 +1751,7 @@ ACMD(do_designate) {
 			create_exit(IN_ROOM(ch), new, dir, TRUE);
 			attach_building_to_room(type, new, TRUE);
 
-			COMPLEX_DATA(new)->home_room = home;
+			set_room_home(new, home);
 			COMPLEX_DATA(home)->inside_rooms++;
 			
 			if (veh) {
@@ -1785,9 +1793,6 @@ ACMD(do_designate) {
 					act(buf, FALSE, ch, 0, vict, TO_VICT);
 				}
 			}
-			
-			// sort now just in case
-			sort_world_table();
 		}
 		
 		complete_wtrigger(new);
@@ -2193,6 +2198,7 @@ ACMD(do_upgrade) {
 			SET_BIT(ROOM_BASE_FLAGS(IN_ROOM(ch)), ROOM_AFF_INCOMPLETE);
 			SET_BIT(ROOM_AFF_FLAGS(IN_ROOM(ch)), ROOM_AFF_INCOMPLETE);
 			GET_BUILDING_RESOURCES(IN_ROOM(ch)) = copy_resource_list(GET_CRAFT_RESOURCES(type));
+			schedule_room_chores(IN_ROOM(ch));
 
 			msg_to_char(ch, "You begin to upgrade the building.\r\n");
 			act("$n starts upgrading the building.", FALSE, ch, 0, 0, TO_ROOM);
@@ -81,7 +81,13 @@ char *prompt_str(char_data *ch);
 char *replace_prompt_codes(char_data *ch, char *str);
 int get_from_q(struct txt_q *queue, char *dest, int *aliased);
 int get_max_players(void);
+static void grow_q_lines(struct txt_q *queue);
+static void grow_q_text(struct txt_q *queue, size_t need);
+static void load_input_limits(void);
 static void msdp_update();
+static void refill_input_buckets(descriptor_data *d);
+static size_t reserve_q_text(struct txt_q *queue, size_t need, bool at_head);
+static void reset_q_bounds(struct txt_q *queue);
 int new_descriptor(socket_t s);
 int open_logfile(const char *filename, FILE *stderr_fp);
 int perform_alias(descriptor_data *d, char *orig);
@@ -100,7 +106,8 @@ void heartbeat(int heart_pulse);
 void init_descriptor(descriptor_data *newd, int desc);
 void init_game(ush_int port);
 void nonblock(socket_t s);
-void perform_act(const char *orig, char_data *ch, const void *obj, const void *vict_obj, const char_data *to, bitvector_t act_flags);
+static void compile_act_template(struct act_template *tpl, const char *orig, char_data *ch, const void *obj, const void *vict_obj, bitvector_t act_flags);
+void perform_act(struct act_template *tpl, char_data *ch, const void *obj, const void *vict_obj, const char_data *to, bitvector_t act_flags);
 void reboot_recover(void);
 void setup_log(const char *filename, int fd);
 void signal_setup(void);
@@ -129,10 +136,21 @@ FILE *logfile = NULL;					/* Where to send the log messages	*/
 bool gain_cond_messsage = FALSE;		/* gain cond send messages			*/
 int dg_act_check;	/* toggle for act_trigger */
 unsigned long pulse = 0;	/* number of pulses since game start */
+unsigned long pulse_overruns = 0;	/* passes that took longer than one pulse */
+unsigned long pulses_behind = 0;	/* extra pulses those passes cost */
 static bool reboot_recovery = FALSE;
 int mother_desc;
 ush_int port;
 
+// input rate limits: read from the configs once per pass of game_loop()
+static struct {
+	int commands_per_second;	// 0 = no limit
+	int command_burst;
+	int bytes_per_second;	// 0 = no limit
+	int byte_burst;
+	int max_queue;	// 0 = no limit
+} input_limits;
+
 // vars to prevent running multiple cycles during a missed-pulse catch-up cycle
 bool catch_up_combat = FALSE;	// frequent_combat()
 bool catch_up_actions = FALSE;	// update_actions()
@@ -278,8 +296,35 @@ void msdp_update_room(char_data *ch) {
 }
 
 
+/**
+* Summarizes the cheap-to-check inputs to health_gain(), mana_gain(), and
+* move_gain(), so msdp_update() only recomputes regen when one changes.
+*
+* @param char_data *ch The player.
+* @return unsigned int A key that changes when the regen inputs do.
+*/
+static unsigned int msdp_regen_key(char_data *ch) {
+	unsigned int key;
+	
+	key = GET_ROOM_VNUM(IN_ROOM(ch));
+	key = (key << 4) ^ GET_POS(ch);
+	key = (key << 1) ^ (FIGHTING(ch) ? 1 : 0);
+	key = (key << 1) ^ (GET_FEEDING_FROM(ch) ? 1 : 0);
+	key = (key << 1) ^ (IS_INJURED(ch, INJ_STAKED | INJ_TIED) ? 1 : 0);
+	key = (key << 1) ^ ((IS_HUNGRY(ch) || IS_THIRSTY(ch) || IS_BLOOD_STARVED(ch)) ? 1 : 0);
+	
+	return key;
+}
+
+
 /**
 * From KaVir's protocol snippet (see protocol.c)
+*
+* This runs every second. Plain fields (health, attributes, etc) are copied
+* every time because MSDPSet*() already skips unchanged values. Anything that
+* is expensive to compute is grouped under an MSDP_DIRTY_x flag, which is
+* raised by the code that changes it (see MSDP_DIRTY()), and only recomputed
+* when flagged or on the periodic full refresh.
 */
 static void msdp_update(void) {
 	extern int get_block_rating(char_data *ch, bool can_gain_skill);
@@ -307,58 +352,92 @@ static void msdp_update(void) {
 	bool is_ally;
 	struct affected_type *aff;
 	descriptor_data *d;
+	empire_data *emp;
 	int hit_points, PlayerCount = 0;
+	unsigned int regen_key;
 	size_t buf_size;
 
 	for (d = descriptor_list; d; d = d->next) {
 		if ((ch = d->character) && !IS_NPC(ch) && STATE(d) == CON_PLAYING) {
 			++PlayerCount;
 			
-			// TODO: Most of this could be moved to set only when it is changed
-
-			MSDPSetString(d, eMSDP_ACCOUNT_NAME, GET_NAME(ch));
-			MSDPSetString(d, eMSDP_CHARACTER_NAME, PERS(ch, ch, FALSE));
+			// full refresh: catches inputs that raise no flag (sunlight, config changes)
+			if (--d->msdp_refresh <= 0) {
+				d->msdp_dirty = MSDP_DIRTY_ALL;
+				d->msdp_refresh = MSDP_FULL_REFRESH;
+			}
+			
+			// inputs that are cheaper to compare than to hook
+			if ((regen_key = msdp_regen_key(ch)) != d->msdp_regen_key) {
+				d->msdp_regen_key = regen_key;
+				SET_BIT(d->msdp_dirty, MSDP_DIRTY_REGEN);
+			}
+			emp = GET_LOYALTY(ch);
+			if (emp != d->msdp_empire || (emp && (GET_RANK(ch) != d->msdp_rank || EMPIRE_MSDP_VERSION(emp) != d->msdp_empire_version))) {
+				d->msdp_empire = emp;
+				d->msdp_rank = emp ? GET_RANK(ch) : 0;
+				d->msdp_empire_version = emp ? EMPIRE_MSDP_VERSION(emp) : 0;
+				SET_BIT(d->msdp_dirty, MSDP_DIRTY_EMPIRE);
+			}
+			
+			if (IS_SET(d->msdp_dirty, MSDP_DIRTY_CHARACTER)) {
+				MSDPSetString(d, eMSDP_ACCOUNT_NAME, GET_NAME(ch));
+				MSDPSetString(d, eMSDP_CHARACTER_NAME, PERS(ch, ch, FALSE));
+				
+				MSDPSetNumber(d, eMSDP_LEVEL, get_approximate_level(ch));
+				MSDPSetNumber(d, eMSDP_SKILL_LEVEL, GET_SKILL_LEVEL(ch));
+				MSDPSetNumber(d, eMSDP_GEAR_LEVEL, GET_GEAR_LEVEL(ch));
+				MSDPSetNumber(d, eMSDP_CRAFTING_LEVEL, get_crafting_level(ch));
+				
+				snprintf(buf, sizeof(buf), "%s", SHOW_CLASS_NAME(ch));
+				MSDPSetString(d, eMSDP_CLASS, buf);
+			}
 
 			MSDPSetNumber(d, eMSDP_HEALTH, GET_HEALTH(ch));
 			MSDPSetNumber(d, eMSDP_HEALTH_MAX, GET_MAX_HEALTH(ch));
-			MSDPSetNumber(d, eMSDP_HEALTH_REGEN, health_gain(ch, TRUE));
 			MSDPSetNumber(d, eMSDP_MANA, GET_MANA(ch));
 			MSDPSetNumber(d, eMSDP_MANA_MAX, GET_MAX_MANA(ch));
-			MSDPSetNumber(d, eMSDP_MANA_REGEN, mana_gain(ch, TRUE));
 			MSDPSetNumber(d, eMSDP_MOVEMENT, GET_MOVE(ch));
 			MSDPSetNumber(d, eMSDP_MOVEMENT_MAX, GET_MAX_MOVE(ch));
-			MSDPSetNumber(d, eMSDP_MOVEMENT_REGEN, move_gain(ch, TRUE));
 			MSDPSetNumber(d, eMSDP_BLOOD, GET_BLOOD(ch));
 			MSDPSetNumber(d, eMSDP_BLOOD_MAX, GET_MAX_BLOOD(ch));
 			MSDPSetNumber(d, eMSDP_BLOOD_UPKEEP, MAX(0, GET_BLOOD_UPKEEP(ch)));
 			
-			// affects
-			*buf = '\0';
-			buf_size = 0;
-			for (aff = ch->affected; aff; aff = aff->next) {
-				buf_size += snprintf(buf + buf_size, sizeof(buf) - buf_size, "%c%s%c%d", (char)MSDP_VAR, affect_types[aff->type], (char)MSDP_VAL, (aff->duration == UNLIMITED ? -1 : (aff->duration * SECS_PER_REAL_UPDATE)));
+			if (IS_SET(d->msdp_dirty, MSDP_DIRTY_REGEN)) {
+				MSDPSetNumber(d, eMSDP_HEALTH_REGEN, health_gain(ch, TRUE));
+				MSDPSetNumber(d, eMSDP_MANA_REGEN, mana_gain(ch, TRUE));
+				MSDPSetNumber(d, eMSDP_MOVEMENT_REGEN, move_gain(ch, TRUE));
 			}
-			MSDPSetTable(d, eMSDP_AFFECTS, buf);
 			
-			// dots
-			*buf = '\0';
-			buf_size = 0;
-			for (dot = ch->over_time_effects; dot; dot = dot->next) {
-				// each dot has a sub-table
-				buf_size += snprintf(buf + buf_size, sizeof(buf) - buf_size, "%c%s%c%c", (char)MSDP_VAR, affect_types[dot->type], (char)MSDP_VAL, (char)MSDP_TABLE_OPEN);
-				
-				
-				buf_size += snprintf(buf + buf_size, sizeof(buf) - buf_size, "%cDURATION%c%d", (char)MSDP_VAR, (char)MSDP_VAL, (dot->duration == UNLIMITED ? -1 : (dot->duration * SECS_PER_REAL_UPDATE)));
-				buf_size += snprintf(buf + buf_size, sizeof(buf) - buf_size, "%cTYPE%c%s", (char)MSDP_VAR, (char)MSDP_VAL, damage_types[dot->damage_type]);
-				buf_size += snprintf(buf + buf_size, sizeof(buf) - buf_size, "%cDAMAGE%c%d", (char)MSDP_VAR, (char)MSDP_VAL, dot->damage * dot->stack);
-				buf_size += snprintf(buf + buf_size, sizeof(buf) - buf_size, "%cSTACKS%c%d", (char)MSDP_VAR, (char)MSDP_VAL, dot->stack);
+			if (IS_SET(d->msdp_dirty, MSDP_DIRTY_AFFECTS)) {
+				// affects
+				*buf = '\0';
+				buf_size = 0;
+				for (aff = ch->affected; aff; aff = aff->next) {
+					buf_size += snprintf(buf + buf_size, sizeof(buf) - buf_size, "%c%s%c%d", (char)MSDP_VAR, affect_types[aff->type], (char)MSDP_VAL, (aff->duration == UNLIMITED ? -1 : (aff->duration * SECS_PER_REAL_UPDATE)));
+				}
+				MSDPSetTable(d, eMSDP_AFFECTS, buf);
 				
-				// end table
-				buf_size += snprintf(buf + buf_size, sizeof(buf) - buf_size, "%c", (char)MSDP_TABLE_CLOSE);
+				// dots
+				*buf = '\0';
+				buf_size = 0;
+				for (dot = ch->over_time_effects; dot; dot = dot->next) {
+					// each dot has a sub-table
+					buf_size += snprintf(buf + buf_size, sizeof(buf) - buf_size, "%c%s%c%c", (char)MSDP_VAR, affect_types[dot->type], (char)MSDP_VAL, (char)MSDP_TABLE_OPEN);
+					
+					
+					buf_size += snprintf(buf + buf_size, sizeof(buf) - buf_size, "%cDURATION%c%d", (char)MSDP_VAR, (char)MSDP_VAL, (dot->duration == UNLIMITED ? -1 : (dot->duration * SECS_PER_REAL_UPDATE)));
+					buf_size += snprintf(buf + buf_size, sizeof(buf) - buf_size, "%cTYPE%c%s", (char)MSDP_VAR, (char)MSDP_VAL, damage_types[dot->damage_type]);
+					buf_size += snprintf(buf + buf_size, sizeof(buf) - buf_size, "%cDAMAGE%c%d", (char)MSDP_VAR, (char)MSDP_VAL, dot->damage * dot->stack);
+					buf_size += snprintf(buf + buf_size, sizeof(buf) - buf_size, "%cSTACKS%c%d", (char)MSDP_VAR, (char)MSDP_VAL, dot->stack);
+					
+					// end table
+					buf_size += snprintf(buf + buf_size, sizeof(buf) - buf_size, "%c", (char)MSDP_TABLE_CLOSE);
+				}
+				MSDPSetTable(d, eMSDP_DOTS, buf);
 			}
-			MSDPSetTable(d, eMSDP_DOTS, buf);
 			
-			// cooldowns
+			// cooldowns: these count down every second
 			*buf = '\0';
 			buf_size = 0;
 			for (cool = ch->cooldowns; cool; cool = cool->next) {
@@ -368,32 +447,25 @@ static void msdp_update(void) {
 			}
 			MSDPSetTable(d, eMSDP_COOLDOWNS, buf);
 			
-			MSDPSetNumber(d, eMSDP_LEVEL, get_approximate_level(ch));
-			MSDPSetNumber(d, eMSDP_SKILL_LEVEL, IS_NPC(ch) ? 0 : GET_SKILL_LEVEL(ch));
-			MSDPSetNumber(d, eMSDP_GEAR_LEVEL, IS_NPC(ch) ? 0 : GET_GEAR_LEVEL(ch));
-			MSDPSetNumber(d, eMSDP_CRAFTING_LEVEL, get_crafting_level(ch));
-
-			snprintf(buf, sizeof(buf), "%s", SHOW_CLASS_NAME(ch));
-			MSDPSetString(d, eMSDP_CLASS, buf);
-			
-			// skills
-			*buf = '\0';
-			buf_size = 0;
-			HASH_ITER(hh, GET_SKILL_HASH(ch), skill, next_skill) {
-				buf_size += snprintf(buf + buf_size, sizeof(buf) - buf_size, "%c%s%c%c", (char)MSDP_VAR, SKILL_NAME(skill->ptr), (char)MSDP_VAL, (char)MSDP_TABLE_OPEN);
-				
-				buf_size += snprintf(buf + buf_size, sizeof(buf) - buf_size, "%cLEVEL%c%d", (char)MSDP_VAR, (char)MSDP_VAL, skill->level);
-				buf_size += snprintf(buf + buf_size, sizeof(buf) - buf_size, "%cEXP%c%.2f", (char)MSDP_VAR, (char)MSDP_VAL, skill->exp);
-				buf_size += snprintf(buf + buf_size, sizeof(buf) - buf_size, "%cRESETS%c%d", (char)MSDP_VAR, (char)MSDP_VAL, skill->resets);
-				buf_size += snprintf(buf + buf_size, sizeof(buf) - buf_size, "%cNOSKILL%c%d", (char)MSDP_VAR, (char)MSDP_VAL, skill->noskill ? 1 : 0);
-				
-				// end table
-				buf_size += snprintf(buf + buf_size, sizeof(buf) - buf_size, "%c", (char)MSDP_TABLE_CLOSE);
+			if (IS_SET(d->msdp_dirty, MSDP_DIRTY_SKILLS)) {
+				*buf = '\0';
+				buf_size = 0;
+				HASH_ITER(hh, GET_SKILL_HASH(ch), skill, next_skill) {
+					buf_size += snprintf(buf + buf_size, sizeof(buf) - buf_size, "%c%s%c%c", (char)MSDP_VAR, SKILL_NAME(skill->ptr), (char)MSDP_VAL, (char)MSDP_TABLE_OPEN);
+					
+					buf_size += snprintf(buf + buf_size, sizeof(buf) - buf_size, "%cLEVEL%c%d", (char)MSDP_VAR, (char)MSDP_VAL, skill->level);
+					buf_size += snprintf(buf + buf_size, sizeof(buf) - buf_size, "%cEXP%c%.2f", (char)MSDP_VAR, (char)MSDP_VAL, skill->exp);
+					buf_size += snprintf(buf + buf_size, sizeof(buf) - buf_size, "%cRESETS%c%d", (char)MSDP_VAR, (char)MSDP_VAL, skill->resets);
+					buf_size += snprintf(buf + buf_size, sizeof(buf) - buf_size, "%cNOSKILL%c%d", (char)MSDP_VAR, (char)MSDP_VAL, skill->noskill ? 1 : 0);
+					
+					// end table
+					buf_size += snprintf(buf + buf_size, sizeof(buf) - buf_size, "%c", (char)MSDP_TABLE_CLOSE);
+				}
+				MSDPSetTable(d, eMSDP_SKILLS, buf);
 			}
-			MSDPSetTable(d, eMSDP_SKILLS, buf);
 
 			MSDPSetNumber(d, eMSDP_MONEY, total_coins(ch));
-			MSDPSetNumber(d, eMSDP_BONUS_EXP, IS_NPC(ch) ? 0 : GET_DAILY_BONUS_EXPERIENCE(ch));
+			MSDPSetNumber(d, eMSDP_BONUS_EXP, GET_DAILY_BONUS_EXPERIENCE(ch));
 			MSDPSetNumber(d, eMSDP_INVENTORY, IS_CARRYING_N(ch));
 			MSDPSetNumber(d, eMSDP_INVENTORY_MAX, CAN_CARRY_N(ch));
 			
@@ -410,30 +482,34 @@ static void msdp_update(void) {
 			MSDPSetNumber(d, eMSDP_INT_PERM, GET_REAL_ATT(ch, INTELLIGENCE));
 			MSDPSetNumber(d, eMSDP_WIT_PERM, GET_REAL_ATT(ch, WITS));
 			
-			MSDPSetNumber(d, eMSDP_BLOCK, get_block_rating(ch, FALSE));
-			MSDPSetNumber(d, eMSDP_DODGE, get_dodge_modifier(ch, NULL, FALSE) - (hit_per_dex * GET_DEXTERITY(ch)));	// same change made to it in score
-			MSDPSetNumber(d, eMSDP_TO_HIT, get_to_hit(ch, NULL, FALSE, FALSE) - (hit_per_dex * GET_DEXTERITY(ch)));	// same change as in score
-			snprintf(buf, sizeof(buf), "%.2f", get_combat_speed(ch, WEAR_WIELD));
-			MSDPSetString(d, eMSDP_SPEED, buf);
+			if (IS_SET(d->msdp_dirty, MSDP_DIRTY_COMBAT)) {
+				MSDPSetNumber(d, eMSDP_BLOCK, get_block_rating(ch, FALSE));
+				MSDPSetNumber(d, eMSDP_DODGE, get_dodge_modifier(ch, NULL, FALSE) - (hit_per_dex * GET_DEXTERITY(ch)));	// same change made to it in score
+				MSDPSetNumber(d, eMSDP_TO_HIT, get_to_hit(ch, NULL, FALSE, FALSE) - (hit_per_dex * GET_DEXTERITY(ch)));	// same change as in score
+				snprintf(buf, sizeof(buf), "%.2f", get_combat_speed(ch, WEAR_WIELD));
+				MSDPSetString(d, eMSDP_SPEED, buf);
+				MSDPSetNumber(d, eMSDP_BONUS_HEALING, total_bonus_healing(ch));
+			}
 			MSDPSetNumber(d, eMSDP_RESIST_PHYSICAL, GET_RESIST_PHYSICAL(ch));
 			MSDPSetNumber(d, eMSDP_RESIST_MAGICAL, GET_RESIST_MAGICAL(ch));
 			MSDPSetNumber(d, eMSDP_BONUS_PHYSICAL, GET_BONUS_PHYSICAL(ch));
 			MSDPSetNumber(d, eMSDP_BONUS_MAGICAL, GET_BONUS_MAGICAL(ch));
-			MSDPSetNumber(d, eMSDP_BONUS_HEALING, total_bonus_healing(ch));
 			
 			// empire
-			if (GET_LOYALTY(ch) && !IS_NPC(ch)) {
-				MSDPSetString(d, eMSDP_EMPIRE_NAME, EMPIRE_NAME(GET_LOYALTY(ch)));
-				MSDPSetString(d, eMSDP_EMPIRE_ADJECTIVE, EMPIRE_ADJECTIVE(GET_LOYALTY(ch)));
-				MSDPSetString(d, eMSDP_EMPIRE_RANK, strip_color(EMPIRE_RANK(GET_LOYALTY(ch), GET_RANK(ch)-1)));
-				MSDPSetNumber(d, eMSDP_EMPIRE_TERRITORY, EMPIRE_CITY_TERRITORY(GET_LOYALTY(ch)) + EMPIRE_OUTSIDE_TERRITORY(GET_LOYALTY(ch)));
-				MSDPSetNumber(d, eMSDP_EMPIRE_TERRITORY_MAX, land_can_claim(GET_LOYALTY(ch), FALSE));
-				MSDPSetNumber(d, eMSDP_EMPIRE_TERRITORY_OUTSIDE, EMPIRE_OUTSIDE_TERRITORY(GET_LOYALTY(ch)));
-				MSDPSetNumber(d, eMSDP_EMPIRE_TERRITORY_OUTSIDE_MAX, land_can_claim(GET_LOYALTY(ch), TRUE));
-				MSDPSetNumber(d, eMSDP_EMPIRE_WEALTH, GET_TOTAL_WEALTH(GET_LOYALTY(ch)));
-				MSDPSetNumber(d, eMSDP_EMPIRE_SCORE, get_total_score(GET_LOYALTY(ch)));
+			if (emp) {
+				if (IS_SET(d->msdp_dirty, MSDP_DIRTY_EMPIRE)) {
+					MSDPSetString(d, eMSDP_EMPIRE_NAME, EMPIRE_NAME(emp));
+					MSDPSetString(d, eMSDP_EMPIRE_ADJECTIVE, EMPIRE_ADJECTIVE(emp));
+					MSDPSetString(d, eMSDP_EMPIRE_RANK, strip_color(EMPIRE_RANK(emp, GET_RANK(ch)-1)));
+					MSDPSetNumber(d, eMSDP_EMPIRE_TERRITORY_MAX, land_can_claim(emp, FALSE));
+					MSDPSetNumber(d, eMSDP_EMPIRE_TERRITORY_OUTSIDE_MAX, land_can_claim(emp, TRUE));
+					MSDPSetNumber(d, eMSDP_EMPIRE_SCORE, get_total_score(emp));
+				}
+				MSDPSetNumber(d, eMSDP_EMPIRE_TERRITORY, EMPIRE_CITY_TERRITORY(emp) + EMPIRE_OUTSIDE_TERRITORY(emp));
+				MSDPSetNumber(d, eMSDP_EMPIRE_TERRITORY_OUTSIDE, EMPIRE_OUTSIDE_TERRITORY(emp));
+				MSDPSetNumber(d, eMSDP_EMPIRE_WEALTH, GET_TOTAL_WEALTH(emp));
 			}
-			else {
+			else if (IS_SET(d->msdp_dirty, MSDP_DIRTY_EMPIRE)) {
 				MSDPSetString(d, eMSDP_EMPIRE_NAME, "");
 				MSDPSetString(d, eMSDP_EMPIRE_ADJECTIVE, "");
 				MSDPSetString(d, eMSDP_EMPIRE_RANK, "");
@@ -477,6 +553,7 @@ static void msdp_update(void) {
 			MSDPSetString(d, eMSDP_WORLD_SEASON, seasons[pick_season(IN_ROOM(ch))]);
 			
 			// done -- send it
+			d->msdp_dirty = NOBITS;
 			MSDPUpdate(d);
 		}
 
@@ -1097,8 +1174,13 @@ void heartbeat(int heart_pulse) {
 void act(const char *str, int hide_invisible, char_data *ch, const void *obj, const void *vict_obj, bitvector_t act_flags) {
 	extern bool is_ignoring(char_data *ch, char_data *victim);
 
+	struct act_template tpl;
+	bool compiled = FALSE;
 	char_data *to = NULL;
 	bool to_sleeping = FALSE, no_dark = FALSE, is_spammy = FALSE;
+	
+	// str is parsed once, the first time someone is going to see it
+	#define COMPILE_ACT_TEMPLATE  if (!compiled) { compile_act_template(&tpl, str, ch, obj, vict_obj, act_flags); compiled = TRUE; }
 
 	if (!str || !*str) {
 		return;
@@ -1121,12 +1203,14 @@ void act(const char *str, int hide_invisible, char_data *ch, const void *obj, co
 
 	/* To the character */
 	if (IS_SET(act_flags, TO_CHAR) && ch && SENDOK(ch)) {
-		perform_act(str, ch, obj, vict_obj, ch, act_flags);
+		COMPILE_ACT_TEMPLATE
+		perform_act(&tpl, ch, obj, vict_obj, ch, act_flags);
 	}
 
 	/* To the victim */
 	if (IS_SET(act_flags, TO_VICT) && (to = (char_data*) vict_obj) != NULL && SENDOK(to) && (!IS_SET(act_flags, TO_NOT_IGNORING) || !is_ignoring(to, ch))) {
-		perform_act(str, ch, obj, vict_obj, to, act_flags);
+		COMPILE_ACT_TEMPLATE
+		perform_act(&tpl, ch, obj, vict_obj, to, act_flags);
 	}
 
 	if (IS_SET(act_flags, TO_NOTVICT | TO_ROOM)) {
@@ -1154,11 +1238,152 @@ void act(const char *str, int hide_invisible, char_data *ch, const void *obj, co
 				if (ch && !WIZHIDE_OK(to, ch)) {
 					continue;
 				}
-				perform_act(str, ch, obj, vict_obj, to, act_flags);
+				COMPILE_ACT_TEMPLATE
+				perform_act(&tpl, ch, obj, vict_obj, to, act_flags);
 			}
 		}
 	}
 	Global_ignore_dark = FALSE;
+	#undef COMPILE_ACT_TEMPLATE
+}
+
+
+/**
+* Parses an act() message once for all of its recipients. Every $-code that
+* reads the same to everyone (pronouns, $t/$T, etc) is filled in here; the
+* ones that depend on who's looking ($n, $p, etc) are left for perform_act().
+*
+* @param struct act_template *tpl The template to fill in.
+* @param const char *orig The act() message.
+* @param char_data *ch The actor.
+* @param const void *obj The obj/text/vehicle param from act().
+* @param const void *vict_obj The vict/obj/text/vehicle param from act().
+* @param bitvector_t act_flags The TO_ flags from act().
+*/
+static void compile_act_template(struct act_template *tpl, const char *orig, char_data *ch, const void *obj, const void *vict_obj, bitvector_t act_flags) {
+	bool real_ch = FALSE, real_vict = FALSE;
+	const char *i = NULL;
+	size_t len = 0;
+	
+	const char *ACTNULL = "<NULL>";
+	#define CHECK_NULL(pointer, expression)  if ((pointer) == NULL) i = ACTNULL; else i = (expression);
+	
+	tpl->num_codes = 0;
+	tpl->dg_victim = NULL;
+	tpl->dg_target = NULL;
+	tpl->dg_arg = NULL;
+	
+	// save room for the \r\n
+	for (; *orig && len < sizeof(tpl->text) - 3; ++orig) {
+		if (*orig != '$') {
+			tpl->text[len++] = *orig;
+			continue;
+		}
+		
+		i = "";
+		switch (*(++orig)) {
+			case 'n':
+			case 'p':
+			case 'v': {	// $v: vehicle -- you need to pass ACT_VEHICLE_OBJ to use this
+				// viewer-dependent: filled in by perform_act
+				break;
+			}
+			case 'o': {
+				real_ch = TRUE;
+				break;
+			}
+			case 'N': {
+				tpl->dg_victim = (char_data*) vict_obj;
+				break;
+			}
+			case 'V': {	// $V: vehicle
+				break;
+			}
+			case 'O': {
+				tpl->dg_victim = (char_data*) vict_obj;
+				real_vict = TRUE;
+				break;
+			}
+			case 'P': {
+				tpl->dg_target = (obj_data*) vict_obj;
+				break;
+			}
+			case 'm':
+				i = real_ch ? REAL_HMHR(ch) : HMHR(ch);
+				break;
+			case 'M':
+				CHECK_NULL(vict_obj, (real_vict ? REAL_HMHR((char_data*) vict_obj) : HMHR((char_data*) vict_obj)));
+				tpl->dg_victim = (char_data*) vict_obj;
+				break;
+			case 's':
+				i = real_ch ? REAL_HSHR(ch) : HSHR(ch);
+				break;
+			case 'S':
+				CHECK_NULL(vict_obj, (real_vict ? REAL_HSHR((char_data*) vict_obj) : HSHR((char_data*) vict_obj)));
+				tpl->dg_victim = (char_data*) vict_obj;
+				break;
+			case 'e':
+				i = real_ch ? REAL_HSSH(ch) : HSSH(ch);
+				break;
+			case 'E':
+				CHECK_NULL(vict_obj, (real_vict ? REAL_HSSH((char_data*) vict_obj) : HSSH((char_data*) vict_obj)));
+				tpl->dg_victim = (char_data*) vict_obj;
+				break;
+			case 'a':
+				CHECK_NULL(obj, SANA((obj_data*)obj));
+				break;
+			case 'A':
+				CHECK_NULL(vict_obj, SANA((const obj_data*) vict_obj));
+				tpl->dg_target = (obj_data*) vict_obj;
+				break;
+			case 'T':
+				CHECK_NULL(vict_obj, (const char *) vict_obj);
+				tpl->dg_arg = (char *) vict_obj;
+				break;
+			case 't':
+				CHECK_NULL(obj, (char *) obj);
+				break;
+			case 'F':
+				CHECK_NULL(vict_obj, fname((const char *) vict_obj));
+				break;
+			case '$':
+				i = "$";
+				break;
+			default: {
+				if (!IS_SET(act_flags, TO_IGNORE_BAD_CODE)) {
+					log("SYSERR: Illegal $-code to act(): %c", *orig);
+					log("SYSERR: %s", orig);
+					i = "";
+				}
+				else {
+					i = "$?";
+				}
+				if (!*orig) {
+					--orig;	// $ at the very end: don't run off it
+				}
+				break;
+			}
+		}
+		
+		if (*orig && strchr("nNoOpPvV", *orig)) {
+			if (tpl->num_codes < MAX_ACT_VIEWER_CODES) {
+				tpl->codes[tpl->num_codes].code = *orig;
+				tpl->codes[tpl->num_codes].pos = len;
+				++tpl->num_codes;
+			}
+			else {
+				log("SYSERR: Too many $-codes to act(): %s", orig);
+			}
+		}
+		else {
+			while (*i && len < sizeof(tpl->text) - 3) {
+				tpl->text[len++] = *(i++);
+			}
+		}
+	}
+	
+	tpl->text[len] = '\0';
+	#undef CHECK_NULL
 }
 
 
@@ -1288,15 +1513,13 @@ void send_to_all(const char *messg, ...) {
 
 
 /* higher-level communication: the act() function */
-void perform_act(const char *orig, char_data *ch, const void *obj, const void *vict_obj, const char_data *to, bitvector_t act_flags) {
+void perform_act(struct act_template *tpl, char_data *ch, const void *obj, const void *vict_obj, const char_data *to, bitvector_t act_flags) {
 	extern char *get_vehicle_short_desc(vehicle_data *veh, char_data *to);
 	extern bool is_fight_ally(char_data *ch, char_data *frenemy);
 	
 	const char *i = NULL;
-	char *buf, lbuf[MAX_STRING_LENGTH], *dg_arg = NULL;
-	bool real_ch = FALSE, real_vict = FALSE;
-	char_data *dg_victim = NULL;
-	obj_data *dg_target = NULL;
+	char lbuf[MAX_STRING_LENGTH];
+	size_t len, pos, size;
 	bool show, any;
 	int iter;
 
@@ -1373,106 +1596,56 @@ void perform_act(const char *orig, char_data *ch, const void *obj, const void *v
 		}
 	}
 	
-	// prepare the message
-	buf = lbuf;
-	for (;;) {
-		if (*orig == '$') {
-			switch (*(++orig)) {
-				case 'n':
-					i = PERS(ch, (char_data*)to, FALSE);
-					break;
-				case 'N':
-					CHECK_NULL(vict_obj, PERS((char_data*)vict_obj,(char_data*)to, FALSE));
-					dg_victim = (char_data*) vict_obj;
-					break;
-				case 'o':
-					i = PERS(ch, (char_data*)to, TRUE);
-					real_ch = TRUE;
-					break;
-				case 'O':
-					CHECK_NULL(vict_obj, PERS((char_data*)vict_obj, (char_data*)to, TRUE));
-					dg_victim = (char_data*) vict_obj;
-					real_vict = TRUE;
-					break;
-				case 'm':
-					i = real_ch ? REAL_HMHR(ch) : HMHR(ch);
-					break;
-				case 'M':
-					CHECK_NULL(vict_obj, (real_vict ? REAL_HMHR((char_data*) vict_obj) : HMHR((char_data*) vict_obj)));
-					dg_victim = (char_data*) vict_obj;
-					break;
-				case 's':
-					i = real_ch ? REAL_HSHR(ch) : HSHR(ch);
-					break;
-				case 'S':
-					CHECK_NULL(vict_obj, (real_vict ? REAL_HSHR((char_data*) vict_obj) : HSHR((char_data*) vict_obj)));
-					dg_victim = (char_data*) vict_obj;
-					break;
-				case 'e':
-					i = real_ch ? REAL_HSSH(ch) : HSSH(ch);
-					break;
-				case 'E':
-					CHECK_NULL(vict_obj, (real_vict ? REAL_HSSH((char_data*) vict_obj) : HSSH((char_data*) vict_obj)));
-					dg_victim = (char_data*) vict_obj;
-					break;
-				case 'p':
-					CHECK_NULL(obj, OBJS((obj_data*)obj, (char_data*)to));
-					break;
-				case 'P':
-					CHECK_NULL(vict_obj, OBJS((obj_data*) vict_obj, (char_data*)to));
-					dg_target = (obj_data*) vict_obj;
-					break;
-				case 'a':
-					CHECK_NULL(obj, SANA((obj_data*)obj));
-					break;
-				case 'A':
-					CHECK_NULL(vict_obj, SANA((const obj_data*) vict_obj));
-					dg_target = (obj_data*) vict_obj;
-					break;
-				case 'T':
-					CHECK_NULL(vict_obj, (const char *) vict_obj);
-					dg_arg = (char *) vict_obj;
-					break;
-				case 't':
-					CHECK_NULL(obj, (char *) obj);
-					break;
-				case 'F':
-					CHECK_NULL(vict_obj, fname((const char *) vict_obj));
-					break;
-				case 'v': {	// $v: vehicle -- you need to pass ACT_VEHICLE_OBJ to use this
-					CHECK_NULL(obj, get_vehicle_short_desc((vehicle_data*)obj, (char_data*)to));
-					break;
-				}
-				case 'V': {	// $V: vehicle
-					CHECK_NULL(vict_obj, get_vehicle_short_desc((vehicle_data*)vict_obj, (char_data*)to));
-					break;
-				}
-				case '$':
-					i = "$";
-					break;
-				default: {
-					if (!IS_SET(act_flags, TO_IGNORE_BAD_CODE)) {
-						log("SYSERR: Illegal $-code to act(): %c", *orig);
-						log("SYSERR: %s", orig);
-						i = "";
-					}
-					else {
-						i = "$?";
-					}
-					break;
-				}
-			}
-			while ((*buf = *(i++)))
-				buf++;
-			orig++;
-			}
-		else if (!(*(buf++) = *(orig++)))
+	// fill in the viewer-dependent codes
+	len = pos = 0;
+	for (iter = 0; iter <= tpl->num_codes; ++iter) {
+		// text up to the next code (or the end)
+		size = (iter < tpl->num_codes ? tpl->codes[iter].pos : strlen(tpl->text)) - pos;
+		size = MIN(size, sizeof(lbuf) - 3 - len);
+		memcpy(lbuf + len, tpl->text + pos, size);
+		len += size;
+		pos += size;
+		
+		if (iter == tpl->num_codes) {
 			break;
+		}
+		
+		switch (tpl->codes[iter].code) {
+			case 'n':
+				i = PERS(ch, (char_data*)to, FALSE);
+				break;
+			case 'N':
+				CHECK_NULL(vict_obj, PERS((char_data*)vict_obj,(char_data*)to, FALSE));
+				break;
+			case 'o':
+				i = PERS(ch, (char_data*)to, TRUE);
+				break;
+			case 'O':
+				CHECK_NULL(vict_obj, PERS((char_data*)vict_obj, (char_data*)to, TRUE));
+				break;
+			case 'p':
+				CHECK_NULL(obj, OBJS((obj_data*)obj, (char_data*)to));
+				break;
+			case 'P':
+				CHECK_NULL(vict_obj, OBJS((obj_data*) vict_obj, (char_data*)to));
+				break;
+			case 'v':
+				CHECK_NULL(obj, get_vehicle_short_desc((vehicle_data*)obj, (char_data*)to));
+				break;
+			case 'V':
+				CHECK_NULL(vict_obj, get_vehicle_short_desc((vehicle_data*)vict_obj, (char_data*)to));
+				break;
+			default:
+				i = "";
+				break;
+		}
+		while (*i && len < sizeof(lbuf) - 3) {
+			lbuf[len++] = *(i++);
+		}
 	}
-
-	*(--buf) = '\r';
-	*(++buf) = '\n';
-	*(++buf) = '\0';
+	
+	strcpy(lbuf + len, "\r\n");
+	#undef CHECK_NULL
 	
 	// find the first non-color-code and cap it
 	for (iter = 0; iter < strlen(lbuf); ++iter) {
@@ -1496,7 +1669,7 @@ void perform_act(const char *orig, char_data *ch, const void *obj, const void *v
 	}
 
 	if ((IS_NPC(to) && dg_act_check) && (to != ch)) {
-		act_mtrigger(to, lbuf, ch, dg_victim, IS_SET(act_flags, ACT_VEHICLE_OBJ) ? NULL : (obj_data*)obj, dg_target, dg_arg);
+		act_mtrigger(to, lbuf, ch, tpl->dg_victim, IS_SET(act_flags, ACT_VEHICLE_OBJ) ? NULL : (obj_data*)obj, tpl->dg_target, tpl->dg_arg);
 	}
 }
 
@@ -1591,6 +1764,8 @@ void send_to_room(const char *messg, room_data *room) {
 
 
 void close_socket(descriptor_data *d) {
+	void free_map_oob_frame(struct map_oob_frame *frame);
+	
 	descriptor_data *temp;
 
 	REMOVE_FROM_LIST(d, descriptor_list, next);
@@ -1669,6 +1844,9 @@ void close_socket(descriptor_data *d) {
 	if (d->file_storage) {
 		free(d->file_storage);
 	}
+	if (d->map_oob) {
+		free_map_oob_frame(d->map_oob);
+	}
 	
 	ProtocolDestroy(d->pProtocol);
 
@@ -1740,13 +1918,11 @@ void close_socket(descriptor_data *d) {
 
 /* Empty the queues before closing connection */
 void flush_queues(descriptor_data *d) {
-	int dummy;
-
 	if (d->large_outbuf) {
 		d->large_outbuf->next = bufpool;
 		bufpool = d->large_outbuf;
 	}
-	while (get_from_q(&d->input, buf2, &dummy));
+	free_q(&d->input);
 }
 
 
@@ -1776,20 +1952,28 @@ struct in_addr *get_bind_addr() {
 }
 
 
+/**
+* Takes the first line off an input queue.
+*
+* @param struct txt_q *queue The queue to read.
+* @param char *dest A buffer of at least MAX_INPUT_LENGTH to copy the line to.
+* @param int *aliased Set to whether or not the line came from an alias.
+* @return int 1 if a line was read, 0 if the queue was empty.
+*/
 int get_from_q(struct txt_q *queue, char *dest, int *aliased) {
-	struct txt_block *tmp;
+	struct txt_q_line *line;
 
 	/* queue empty? */
-	if (!queue->head)
+	if (queue->count <= 0)
 		return (0);
 
-	tmp = queue->head;
-	strcpy(dest, queue->head->text);
-	*aliased = queue->head->aliased;
-	queue->head = queue->head->next;
-
-	free(tmp->text);
-	free(tmp);
+	line = &TXT_Q_LINE(queue, 0);
+	strcpy(dest, queue->text + line->pos);
+	*aliased = line->aliased;
+	
+	queue->head = (queue->head + 1) % queue->size;
+	--queue->count;
+	reset_q_bounds(queue);
 
 	return (1);
 }
@@ -1889,6 +2073,11 @@ void init_descriptor(descriptor_data *newd, int desc) {
 	newd->has_prompt = 0;
 	
 	newd->save_empire = NOTHING;
+	
+	// start with full input buckets
+	newd->cmd_tokens = CONFIG_INT(CONF_INPUT_COMMAND_BURST);
+	newd->byte_tokens = CONFIG_INT(CONF_INPUT_BYTE_BURST);
+	newd->input_refill_pulse = pulse;
 
 	CREATE(newd->history, char *, HISTORY_SIZE);
 	newd->pProtocol = ProtocolCreate();
@@ -2006,6 +2195,19 @@ bool is_slow_ip(char *ip) {
 }
 
 
+/**
+* Reads the input rate-limit configs into input_limits, once per pass of the
+* game loop, so the per-descriptor checks don't have to look them up.
+*/
+static void load_input_limits(void) {
+	input_limits.commands_per_second = CONFIG_INT(CONF_INPUT_COMMANDS_PER_SECOND);
+	input_limits.command_burst = MAX(1, CONFIG_INT(CONF_INPUT_COMMAND_BURST));
+	input_limits.bytes_per_second = CONFIG_INT(CONF_INPUT_BYTES_PER_SECOND);
+	input_limits.byte_burst = MAX(1, CONFIG_INT(CONF_INPUT_BYTE_BURST));
+	input_limits.max_queue = CONFIG_INT(CONF_MAX_INPUT_QUEUE);
+}
+
+
 /**
 * Allows a player to manipulate their input queue. The input text is what the
 * user typed AFTER the '-' trigger character.
@@ -2019,17 +2221,17 @@ bool is_slow_ip(char *ip) {
 * @param char *input The text typed, after the -.
 */
 void manipulate_input_queue(descriptor_data *desc, char *input) {
-	struct txt_block *iter, *next_iter, *temp;
 	bool clear_all, found;
+	int iter, kept;
 
 	skip_spaces(&input);
 
 	// show queue?
 	if (!*input) {
-		if (desc->input.head) {
+		if (desc->input.count > 0) {
 			msg_to_desc(desc, "Input queue:\r\n");
-			for (iter = desc->input.head; iter; iter = iter->next) {
-				msg_to_desc(desc, "%s\r\n", iter->text);
+			for (iter = 0; iter < desc->input.count; ++iter) {
+				msg_to_desc(desc, "%s\r\n", TXT_Q_TEXT(&desc->input, iter));
 			}
 		}
 		else {
@@ -2041,34 +2243,21 @@ void manipulate_input_queue(descriptor_data *desc, char *input) {
 	// clearing everything?
 	clear_all = (*input == '-');
 	
-	// remove matches from queue
+	// remove matches from queue by sliding the kept lines down (their text stays put)
 	found = FALSE;
-	for (iter = desc->input.head; iter; iter = next_iter) {
-		next_iter = iter->next;
-		
-		if (clear_all || is_abbrev(input, iter->text)) {
-			REMOVE_FROM_LIST(iter, desc->input.head, next);
-			
+	for (iter = kept = 0; iter < desc->input.count; ++iter) {
+		if (clear_all || is_abbrev(input, TXT_Q_TEXT(&desc->input, iter))) {
 			if (!clear_all) {
-				msg_to_desc(desc, "Removed: %s\r\n", iter->text);
+				msg_to_desc(desc, "Removed: %s\r\n", TXT_Q_TEXT(&desc->input, iter));
 			}
-			
-			free(iter->text);
-			free(iter);
 			found = TRUE;
 		}
-	}
-	
-	// find new tail
-	if ((iter = desc->input.head)) {
-		while (iter->next) {
-			iter = iter->next;
+		else {
+			TXT_Q_LINE(&desc->input, kept++) = TXT_Q_LINE(&desc->input, iter);
 		}
-		desc->input.tail = iter;
-	}
-	else {
-		desc->input.tail = NULL;
 	}
+	desc->input.count = kept;
+	reset_q_bounds(&desc->input);
 	
 	if (clear_all) {
 		msg_to_desc(desc, "Input queue cleared.\r\n");
@@ -2370,6 +2559,9 @@ int process_input(descriptor_data *t) {
 			return (-1);
 		}
 		else if (bytes_read >= 0) {
+			t->byte_tokens -= bytes_read;
+			t->input_bytes += bytes_read;
+			
 			read_buf[bytes_read] = '\0';
 			ProtocolInput(t, read_buf, bytes_read, read_point, space_left+1);
 			bytes_read = strlen(read_point);
@@ -2509,7 +2701,13 @@ int process_input(descriptor_data *t) {
 		}
 
 		if (!do_not_add) {
-			write_to_q(input, &t->input, 0, add_to_head);
+			if (input_limits.max_queue > 0 && t->input.count >= input_limits.max_queue && !t->str) {
+				++t->input_dropped;
+				SEND_TO_Q("Too much input queued; line ignored.\r\n", t);
+			}
+			else {
+				write_to_q(input, &t->input, 0, add_to_head);
+			}
 			add_to_head = FALSE;
 		}
 
@@ -2649,6 +2847,23 @@ static int process_output(descriptor_data *t) {
 }
 
 
+/**
+* Tops up a descriptor's command and byte token buckets for however many
+* pulses have passed since they were last refilled, up to the burst sizes.
+*
+* @param descriptor_data *d The descriptor to refill.
+*/
+static void refill_input_buckets(descriptor_data *d) {
+	unsigned long elapsed = pulse - d->input_refill_pulse;
+	
+	if (elapsed > 0) {
+		d->input_refill_pulse = pulse;
+		d->cmd_tokens = MIN(input_limits.command_burst, d->cmd_tokens + (double) elapsed * input_limits.commands_per_second / PASSES_PER_SEC);
+		d->byte_tokens = MIN(input_limits.byte_burst, d->byte_tokens + (double) elapsed * input_limits.bytes_per_second / PASSES_PER_SEC);
+	}
+}
+
+
 /* Sets the kernel's send buffer size for the descriptor */
 int set_sendbuf(socket_t s) {
 #if defined(SO_SNDBUF)
@@ -2768,6 +2983,180 @@ void write_to_output(const char *txt, descriptor_data *t) {
 }
 
 
+/**
+* Frees the buffers behind an input queue, leaving it empty.
+*
+* @param struct txt_q *queue The queue to free.
+*/
+void free_q(struct txt_q *queue) {
+	if (queue->text) {
+		free(queue->text);
+	}
+	if (queue->lines) {
+		free(queue->lines);
+	}
+	memset((char *) queue, 0, sizeof(struct txt_q));
+}
+
+
+/**
+* Doubles the line ring of an input queue, unwrapping it so the first line
+* is at index 0.
+*
+* @param struct txt_q *queue The queue to grow.
+*/
+static void grow_q_lines(struct txt_q *queue) {
+	struct txt_q_line *lines;
+	int iter, size;
+	
+	size = MAX(TXT_Q_MIN_LINES, queue->size * 2);
+	CREATE(lines, struct txt_q_line, size);
+	for (iter = 0; iter < queue->count; ++iter) {
+		lines[iter] = TXT_Q_LINE(queue, iter);
+	}
+	
+	if (queue->lines) {
+		free(queue->lines);
+	}
+	queue->lines = lines;
+	queue->size = size;
+	queue->head = 0;
+}
+
+
+/**
+* Grows the text ring of an input queue until it has room for 'need' more
+* bytes, packing the existing lines at the start of the new buffer.
+*
+* @param struct txt_q *queue The queue to grow.
+* @param size_t need How many free bytes are needed after the last line.
+*/
+static void grow_q_text(struct txt_q *queue, size_t need) {
+	struct txt_q_line *line;
+	size_t size, used = 0;
+	char *text;
+	int iter;
+	
+	for (iter = 0; iter < queue->count; ++iter) {
+		used += TXT_Q_LINE(queue, iter).len + 1;
+	}
+	
+	size = MAX(TXT_Q_MIN_TEXT, queue->text_size * 2);
+	while (size < used + need) {
+		size *= 2;
+	}
+	
+	CREATE(text, char, size);
+	for (iter = 0, used = 0; iter < queue->count; ++iter) {
+		line = &TXT_Q_LINE(queue, iter);
+		memcpy(text + used, queue->text + line->pos, line->len + 1);
+		line->pos = used;
+		used += line->len + 1;
+	}
+	
+	if (queue->text) {
+		free(queue->text);
+	}
+	queue->text = text;
+	queue->text_size = size;
+	queue->text_head = 0;
+	queue->text_tail = used;
+}
+
+
+/**
+* Moves every line of one input queue to the front of another, in order,
+* leaving the source empty (but with its buffers intact for reuse).
+*
+* @param struct txt_q *dest The queue to add to.
+* @param struct txt_q *src The lines to add, which will be removed from here.
+*/
+void prepend_q(struct txt_q *dest, struct txt_q *src) {
+	int iter;
+	
+	for (iter = src->count - 1; iter >= 0; --iter) {
+		write_to_q(TXT_Q_TEXT(src, iter), dest, TXT_Q_LINE(src, iter).aliased, TRUE);
+	}
+	
+	src->count = 0;
+	reset_q_bounds(src);
+}
+
+
+/**
+* Finds room in an input queue's text ring for a new line, either after the
+* last line or before the first one, and claims it. The used text always
+* runs from text_head to text_tail, wrapping around the end of the buffer
+* when text_tail <= text_head; lines never wrap, so a line that won't fit at
+* one end of the buffer goes to the other.
+*
+* @param struct txt_q *queue The queue.
+* @param size_t need Bytes needed, including the \0.
+* @param bool at_head If TRUE, the space goes before the first line.
+* @return size_t The position of the claimed space in queue->text.
+*/
+static size_t reserve_q_text(struct txt_q *queue, size_t need, bool at_head) {
+	bool wrapped;
+	size_t pos;
+	
+	if (queue->count <= 0) {
+		queue->text_head = queue->text_tail = 0;
+	}
+	wrapped = (queue->count > 0 && queue->text_tail <= queue->text_head);
+	
+	if (wrapped && queue->text_head - queue->text_tail >= need) {
+		pos = at_head ? (queue->text_head - need) : queue->text_tail;
+	}
+	else if (!wrapped && !at_head && queue->text_size - queue->text_tail >= need) {
+		pos = queue->text_tail;	// after the last line
+	}
+	else if (!wrapped && !at_head && queue->text_head >= need) {
+		pos = 0;	// wrap to the start
+	}
+	else if (!wrapped && at_head && queue->text_head >= need) {
+		pos = queue->text_head - need;	// before the first line
+	}
+	else if (!wrapped && at_head && queue->text_size - queue->text_tail >= need) {
+		pos = queue->text_size - need;	// wrap to the end
+	}
+	else {
+		// full: this repacks everything at the start, leaving room at the end
+		grow_q_text(queue, need);
+		pos = at_head ? (queue->text_size - need) : queue->text_tail;
+	}
+	
+	if (at_head) {
+		queue->text_head = pos;
+	}
+	else {
+		queue->text_tail = pos + need;
+	}
+	
+	return pos;
+}
+
+
+/**
+* Re-derives the used text range of an input queue from its first and last
+* lines, after lines are removed.
+*
+* @param struct txt_q *queue The queue.
+*/
+static void reset_q_bounds(struct txt_q *queue) {
+	struct txt_q_line *last;
+	
+	if (queue->count <= 0) {
+		queue->count = 0;
+		queue->text_head = queue->text_tail = 0;
+	}
+	else {
+		last = &TXT_Q_LINE(queue, queue->count - 1);
+		queue->text_head = TXT_Q_LINE(queue, 0).pos;
+		queue->text_tail = last->pos + last->len + 1;
+	}
+}
+
+
 /**
 * Adds an item to an input queue.
 *
@@ -2777,26 +3166,31 @@ void write_to_output(const char *txt, descriptor_data *t) {
 * @param bool add_to_head If TRUE, puts the new item at the start instead of end of the queue.
 */
 void write_to_q(const char *txt, struct txt_q *queue, int aliased, bool add_to_head) {
-	struct txt_block *newt;
-
-	CREATE(newt, struct txt_block, 1);
-	newt->text = str_dup(txt);
-	newt->aliased = aliased;
-
-	/* queue empty? */
-	if (!queue->head) {
-		newt->next = NULL;
-		queue->head = queue->tail = newt;
+	struct txt_q_line *line;
+	size_t len = strlen(txt);
+	size_t pos;
+	
+	if (queue->count >= queue->size) {
+		grow_q_lines(queue);
 	}
-	else if (add_to_head) {
-		newt->next = queue->head;
-		queue->head = newt;
+	
+	// reserve text before touching the line ring: this may repack the other lines
+	pos = reserve_q_text(queue, len + 1, add_to_head);
+	
+	if (add_to_head) {
+		queue->head = (queue->head + queue->size - 1) % queue->size;
+		line = &TXT_Q_LINE(queue, 0);
 	}
 	else {
-		queue->tail->next = newt;
-		queue->tail = newt;
-		newt->next = NULL;
+		line = &TXT_Q_LINE(queue, queue->count);
 	}
+	
+	line->pos = pos;
+	line->len = len;
+	line->aliased = aliased;
+	++queue->count;
+	
+	strcpy(queue->text + line->pos, txt);
 }
 
 
@@ -3459,6 +3853,10 @@ void game_loop(socket_t mother_desc) {
 			missed_pulses += process_time.tv_usec / OPT_USEC;
 			process_time.tv_sec = 0;
 			process_time.tv_usec = process_time.tv_usec % OPT_USEC;
+			
+			// the last pass ran long (shown on 'uptime', e.g. for load tests)
+			++pulse_overruns;
+			pulses_behind += missed_pulses;
 		}
 
 		/* Calculate the time we should wake up */
@@ -3496,11 +3894,20 @@ void game_loop(socket_t mother_desc) {
 		}
 
 		/* Process descriptors with input pending */
+		load_input_limits();
 		for (d = descriptor_list; d; d = next_d) {
 			next_d = d->next;
-			if (FD_ISSET(d->descriptor, &input_set))
-				if (process_input(d) < 0)
+			refill_input_buckets(d);
+			
+			if (FD_ISSET(d->descriptor, &input_set)) {
+				if (input_limits.bytes_per_second > 0 && d->byte_tokens <= 0) {
+					// over its byte rate: leave the data in the socket until the bucket refills
+					++d->input_deferred;
+				}
+				else if (process_input(d) < 0) {
 					close_socket(d);
+				}
+			}
 		}
 
 		/* Process commands we just read from process_input */
@@ -3519,9 +3926,20 @@ void game_loop(socket_t mother_desc) {
 				if (GET_WAIT_STATE(d->character))
 					continue;
 			}
+			
+			// over its command rate: the rest stays queued (text editors are exempt, for pasting)
+			if (d->input.count > 0 && input_limits.commands_per_second > 0 && d->cmd_tokens < 1 && !d->str) {
+				++d->input_deferred;
+				continue;
+			}
 
 			if (!get_from_q(&d->input, comm, &aliased))
 				continue;
+			
+			++d->input_commands;
+			if (!d->str) {
+				d->cmd_tokens -= 1;
+			}
 
 			if (d->character) {
 				/* Reset the idle timer & pull char back from void if necessary */
@@ -54,7 +54,26 @@ void act(const char *str, int hide_invisible, char_data *ch, const void *obj, co
 #define TO_COMBAT_HIT  BIT(15)	// is a hit (fightmessages) -- REQUIRES vict_obj is a char
 #define TO_COMBAT_MISS  BIT(16)	// is a miss (fightmessages) -- REQUIRES vict_obj is a char
 
+// act() parses its message once per call into one of these: $-codes that read the same to everyone are filled in, and the rest are filled in per viewer
+#define MAX_ACT_VIEWER_CODES  32
+
+struct act_template {
+	char text[MAX_STRING_LENGTH];	// the message, with every viewer-independent $-code already filled in
+	int num_codes;	// viewer-dependent $-codes left to fill in
+	struct {
+		char code;	// n, N, o, O, p, P, v, V
+		size_t pos;	// where it goes in text
+	} codes[MAX_ACT_VIEWER_CODES];
+	
+	// for act triggers
+	char_data *dg_victim;
+	obj_data *dg_target;
+	char *dg_arg;
+};
+
 /* I/O functions */
+void free_q(struct txt_q *queue);
+void prepend_q(struct txt_q *dest, struct txt_q *src);
 int write_to_descriptor(socket_t desc, const char *txt);
 void write_to_q(const char *txt, struct txt_q *queue, int aliased, bool add_to_head);
 void write_to_output(const char *txt, descriptor_data *d);
@@ -64,6 +83,13 @@ void start_string_editor(descriptor_data *d, char *prompt, char **writeto, size_
 
 #define SEND_TO_Q(messg, desc)  write_to_output((messg), desc)
 
+// TXT_Q_x: the nth line in a txt_q (0 is the head)
+#define TXT_Q_LINE(queue, n)  ((queue)->lines[((queue)->head + (n)) % (queue)->size])
+#define TXT_Q_TEXT(queue, n)  ((queue)->text + TXT_Q_LINE((queue), (n)).pos)
+
+#define TXT_Q_MIN_LINES  16	// initial size of a txt_q's line ring
+#define TXT_Q_MIN_TEXT  (2 * MAX_INPUT_LENGTH)	// initial size of a txt_q's text ring
+
 #define USING_SMALL(d)	((d)->output == (d)->small_outbuf)
 #define USING_LARGE(d)  ((d)->output == (d)->large_outbuf)
 
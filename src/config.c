@@ -55,6 +55,7 @@ extern const char *techs[];
 // locals
 bool add_int_to_int_array(int to_add, int **array, int *size);
 bool find_int_in_array(int to_find, int *array, int size);
+void link_config_slots();
 bool remove_int_from_int_array(int to_remove, int **array, int *size);
 void save_config_system();
 
@@ -357,6 +358,7 @@ struct config_type {
 	
 	union config_data_union data;	// whatever type of data is stored here (based on type)
 	int data_size;	// for array data
+	int slot;	// CONF_x if it's also kept in config_slots[], or NOTHING
 	
 	// for types with their own handlers
 	CONFIG_HANDLER(*show_func);
@@ -369,6 +371,21 @@ struct config_type {
 struct config_type *config_table = NULL;	// hash table of configs
 
 
+// CONF_x: pre-resolved configs for hot code (CONFIG_INT(), etc.)
+union config_slot_data config_slots[NUM_CONFIG_SLOTS];
+
+// CONF_x: which config each slot holds
+struct config_slot_info {
+	char *key;	// config key
+	int type;	// CONFTYPE_x it must have
+};
+
+#define CONFIG_SLOT_INFO(slot, key, type)  { key, CONFTYPE_##type },
+const struct config_slot_info config_slot_info[NUM_CONFIG_SLOTS] = {
+	CONFIG_SLOT_LIST(CONFIG_SLOT_INFO)
+};
+
+
  //////////////////////////////////////////////////////////////////////////////
 //// CONFIG SYSTEM: HANDLERS /////////////////////////////////////////////////
 
@@ -387,6 +404,67 @@ struct config_type *get_config_by_key(char *key) {
 }
 
 
+/**
+* Copies a config's current value into its CONF_x slot, if it has one. This
+* must be called any time a config's data changes.
+*
+* @param struct config_type *cnf The config that changed.
+*/
+void update_config_slot(struct config_type *cnf) {
+	union config_slot_data *slot;
+	
+	if (!cnf || cnf->slot == NOTHING) {
+		return;
+	}
+	
+	slot = &config_slots[cnf->slot];
+	
+	// CONFTYPE_x: only the scalar types can have slots
+	switch (cnf->type) {
+		case CONFTYPE_BITVECTOR: {
+			slot->bitvector_val = cnf->data.bitvector_val;
+			break;
+		}
+		case CONFTYPE_BOOL: {
+			slot->bool_val = cnf->data.bool_val;
+			break;
+		}
+		case CONFTYPE_DOUBLE: {
+			slot->double_val = cnf->data.double_val;
+			break;
+		}
+		case CONFTYPE_INT: {
+			slot->int_val = cnf->data.int_val;
+			break;
+		}
+	}
+}
+
+
+/**
+* Resolves each CONF_x slot to its config and copies in the current value.
+* Run once at startup, after the configs are loaded.
+*/
+void link_config_slots(void) {
+	struct config_type *cnf;
+	int iter;
+	
+	for (iter = 0; iter < NUM_CONFIG_SLOTS; ++iter) {
+		if (!(cnf = get_config_by_key(config_slot_info[iter].key))) {
+			log("SYSERR: link_config_slots: no config for slot %d key '%s'", iter, config_slot_info[iter].key);
+			continue;
+		}
+		if (cnf->type != config_slot_info[iter].type) {
+			log("SYSERR: link_config_slots: config '%s' is type %s, not %s", cnf->key, config_types[cnf->type], config_types[config_slot_info[iter].type]);
+			continue;
+		}
+		
+		cnf->slot = iter;
+		update_config_slot(cnf);
+	}
+}
+
+
 /**
 * Load a global config as a bitvector.
 *
@@ -1477,6 +1555,7 @@ void init_config(int set, char *key, int type, char *description) {
 	if (!cnf) {
 		CREATE(cnf, struct config_type, 1);
 		cnf->key = str_dup(key);
+		cnf->slot = NOTHING;
 		HASH_ADD_STR(config_table, key, cnf);
 	}
 	
@@ -1755,6 +1834,11 @@ void init_config_system(void) {
 	init_config(CONFIG_SYSTEM, "use_autowiz", CONFTYPE_BOOL, "if on, automatically generates the wizlist");
 	init_config(CONFIG_SYSTEM, "siteok_everyone", CONFTYPE_BOOL, "flags players siteok on creation, essentially inverting ban logic");
 	init_config(CONFIG_SYSTEM, "log_losing_descriptor_without_char", CONFTYPE_BOOL, "somewhat spammy disconnect logs");
+	init_config(CONFIG_SYSTEM, "input_commands_per_second", CONFTYPE_INT, "sustained commands per second per connection (0 = no limit)");
+	init_config(CONFIG_SYSTEM, "input_command_burst", CONFTYPE_INT, "commands a connection can save up to run back-to-back");
+	init_config(CONFIG_SYSTEM, "input_bytes_per_second", CONFTYPE_INT, "sustained bytes of input per second per connection (0 = no limit)");
+	init_config(CONFIG_SYSTEM, "input_byte_burst", CONFTYPE_INT, "bytes of input a connection can save up to send at once");
+	init_config(CONFIG_SYSTEM, "max_input_queue", CONFTYPE_INT, "queued lines of input before more are ignored (0 = no limit)");
 
 	// trade
 	init_config(CONFIG_TRADE, "imports_per_day", CONFTYPE_INT, "how many max items an empire will import per day");
@@ -1810,6 +1894,7 @@ void init_config_system(void) {
 
 	// last
 	load_config_system_from_file();
+	link_config_slots();
 }
 
 
@@ -1923,6 +2008,7 @@ ACMD(do_config) {
 		// any argument: edit
 		if (cnf->edit_func != NULL) {
 			(cnf->edit_func)(ch, cnf, argument);
+			update_config_slot(cnf);
 		}
 		else {
 			msg_to_char(ch, "Editing is not implemented for that config.\r\n");
@@ -494,6 +494,7 @@ const char *preference_bits[] = {
 	"AUTODISMOUNT",
 	"!EMPIRE",
 	"CLEARMETERS",
+	"OOB-MAP",
 	"\n"
 };
 
@@ -558,6 +559,7 @@ const struct toggle_data_type toggle_data[] = {
 	
 	{ "no-empire", TOG_ONOFF, PRF_NOEMPIRE, 0, NULL },
 	{ "clearmeters", TOG_ONOFF, PRF_CLEARMETERS, 0, NULL },
+	{ "oob-map", TOG_ONOFF, PRF_OOB_MAP, 0, NULL },
 	
 	// imm section
 	{ "wiznet", TOG_OFFON, PRF_NOWIZ, LVL_START_IMM, NULL },
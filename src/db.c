@@ -49,7 +49,7 @@ extern const sector_vnum climate_default_sector[NUM_CLIMATES];
 
 // external functions
 void Crash_save_one_obj_to_file(FILE *fl, obj_data *obj, int location);
-void discrete_load(FILE *fl, int mode, char *filename);
+int discrete_load(FILE *fl, int mode, char *filename);
 void free_complex_data(struct complex_room_data *data);
 extern crop_data *get_potential_crop_for_location(room_data *location);
 void index_boot(int mode);
@@ -139,6 +139,10 @@ char_data *combat_list = NULL;	// head of l-list of fighting chars
 char_data *next_combat_list = NULL;	// used for iteration of combat_list when more than 1 person can be removed from combat in 1 loop iteration
 struct generic_name_data *generic_names = NULL;	// LL of generic name sets
 
+// keyword index (handler.c)
+struct keyword_index *keyword_index[NUM_KWI];	// hashes of keyword prefixes to live chars/objs/vehicles, by KWI_x
+unsigned long long top_list_seq = 0;	// counts things joining character_list/object_list/vehicle_list, to order keyword_index buckets
+
 // morphs
 morph_data *morph_table = NULL;	// master morph hash table
 morph_data *sorted_morphs = NULL;	// alphabetic version // sorted_hh
@@ -151,6 +155,8 @@ obj_data *object_table = NULL;	// hash table of objs
 account_data *account_table = NULL;	// hash table of accounts
 player_index_data *player_table_by_idnum = NULL;	// hash table by idnum
 player_index_data *player_table_by_name = NULL;	// hash table by name
+char_data *player_character_list = NULL;	// DL of in-game players (prev_plr/next_plr)
+struct player_name_index *player_name_index = NULL;	// hash of in-game players' name words
 int top_idnum = 0;	// highest idnum in use
 int top_account_id = 0;  // highest account number in use, determined during startup
 struct group_data *group_list = NULL;	// global LL of groups
@@ -214,7 +220,7 @@ vehicle_data *vehicle_list = NULL;	// global linked list of vehicles (veh->next)
 // world / rooms
 room_data *world_table = NULL;	// hash table of the whole world
 room_data *interior_room_list = NULL;	// linked list of interior rooms: room->next_interior
-bool world_is_sorted = FALSE;	// to prevent unnecessary re-sorts
+struct world_block_data *world_block_table = NULL;	// hash of world blocks, sorted by block number
 bool need_world_index = TRUE;	// used to trigger world index saving (always save at least once)
 struct island_info *island_table = NULL; // hash table for all the islands
 struct map_data world_map[MAP_WIDTH][MAP_HEIGHT];	// master world map
@@ -282,8 +288,11 @@ void boot_db(void) {
 	void sort_commands();
 	void startup_room_reset();
 	void verify_sectors();
+	
+	struct timeval start_time, end_time;
 
 	log("Boot db -- BEGIN.");
+	gettimeofday(&start_time, NULL);
 	
 	log("Loading game config system.");
 	init_config_system();
@@ -381,7 +390,8 @@ void boot_db(void) {
 	reread_empire_tech(NULL);
 	
 	// END
-	log("Boot db -- DONE.");
+	gettimeofday(&end_time, NULL);
+	log("Boot db -- DONE (%.2f seconds).", (end_time.tv_sec - start_time.tv_sec) + (end_time.tv_usec - start_time.tv_usec) / 1000000.0);
 	boot_time = time(0);
 }
 
@@ -415,6 +425,7 @@ void boot_world(void) {
 	void read_ability_requirements();
 	void renum_world();
 	void setup_start_locations();
+	int update_world_count(bool verify);
 	extern int sort_abilities_by_data(ability_data *a, ability_data *b);
 	extern int sort_archetypes_by_data(archetype_data *a, archetype_data *b);
 	extern int sort_augments_by_data(augment_data *a, augment_data *b);
@@ -465,6 +476,7 @@ void boot_world(void) {
 	index_boot(DB_BOOT_WLD);	// override with live rooms
 	build_world_map();	// ensure full world map
 	build_land_map();	// determine which parts are land
+	update_world_count(FALSE);	// sector/crop/building counts are kept up to date from here
 	
 	// requires rooms
 	log("Loading empires.");
@@ -798,11 +810,13 @@ void delete_orphaned_rooms(void) {
 
 
 /**
-* This ensures that every room has a valid sector.
+* This ensures that every room has a valid sector, and that every crop tile
+* (even ones that aren't loaded as rooms) has a crop.
 */
 void verify_sectors(void) {	
 	sector_data *use_sect, *sect, *next_sect;
 	room_data *room, *next_room;
+	struct map_data *map;
 	
 	// ensure we have a backup sect
 	use_sect = sector_proto(climate_default_sector[CLIMATE_TEMPERATE]);
@@ -838,6 +852,13 @@ void verify_sectors(void) {
 			}
 		}
 	}
+	
+	// map tiles that aren't in the world_table (e.g. a freshly-generated base_map has no crops)
+	LL_FOREACH(land_map, map) {
+		if (!map->crop_type && SECT_FLAGGED(map->sector_type, SECTF_HAS_CROP_DATA | SECTF_CROP) && (room = real_room(map->vnum))) {
+			set_crop_type(room, get_potential_crop_for_location(room));
+		}
+	}
 }
 
 
@@ -856,7 +877,7 @@ void process_temporary_room_data(void) {
 		if ((room = real_room(trd->vnum))) {
 			// home room
 			if (trd->home_room != NOWHERE && COMPLEX_DATA(room) && (home = real_room(trd->home_room))) {
-				COMPLEX_DATA(room)->home_room = home;
+				set_room_home(room, home);
 			}
 			// owner
 			if (trd->owner != NOTHING) {
@@ -1273,35 +1294,83 @@ void index_boot_help(void) {
  //////////////////////////////////////////////////////////////////////////////
 //// ISLAND SETUP ////////////////////////////////////////////////////////////
 
-// this helps find places to number
-struct island_num_data_t {
-	struct map_data *loc;
-	struct island_num_data_t *next;	// LL
-};
-
-struct island_num_data_t *island_stack = NULL;	// global stack
+/**
+* Finds the root of a tile's set, for island numbering. This uses path halving
+* so repeated lookups stay nearly flat.
+*
+* @param int *parent The union-find parent array (by land_map position).
+* @param int pos The tile's land_map position.
+* @return int The root position of its set.
+*/
+static int find_island_set(int *parent, int pos) {
+	while (parent[pos] != pos) {
+		parent[pos] = parent[parent[pos]];
+		pos = parent[pos];
+	}
+	return pos;
+}
 
 
-// pops an item from the stack and returns it, or NULL if empty
-struct island_num_data_t *pop_island(void) {
-	struct island_num_data_t *temp = NULL;
+/**
+* Joins the sets of two tiles, for island numbering. The earlier tile in the
+* land_map always becomes the root, so each set's root is its first tile.
+*
+* @param int *parent The union-find parent array (by land_map position).
+* @param int a One tile's land_map position.
+* @param int b The other tile's land_map position.
+*/
+static void join_island_sets(int *parent, int a, int b) {
+	a = find_island_set(parent, a);
+	b = find_island_set(parent, b);
 	
-	if (island_stack) {
-		temp = island_stack;
-		island_stack = temp->next;
+	if (a < b) {
+		parent[b] = a;
+	}
+	else if (b < a) {
+		parent[a] = b;
 	}
-	
-	return temp;
 }
 
 
-// push a location onto the stack
-void push_island(struct map_data *loc) {
-	struct island_num_data_t *island;
-	CREATE(island, struct island_num_data_t, 1);
-	island->loc = loc;
-	island->next = island_stack;
-	island_stack = island;
+/**
+* Gets the map vnums of the (up to 8) tiles adjacent to one map location,
+* respecting WRAP_X and WRAP_Y.
+*
+* @param room_vnum vnum The map location.
+* @param room_vnum *list An array of at least 8 to store the neighbors in.
+* @return int How many neighbors were stored.
+*/
+static int get_island_neighbors(room_vnum vnum, room_vnum *list) {
+	int x = MAP_X_COORD(vnum), y = MAP_Y_COORD(vnum);
+	int x_shift, y_shift, new_x, new_y, count = 0;
+	
+	for (x_shift = -1; x_shift <= 1; ++x_shift) {
+		new_x = x + x_shift;
+		if (new_x < 0 || new_x >= MAP_WIDTH) {
+			if (!WRAP_X) {
+				continue;
+			}
+			new_x = (new_x + MAP_WIDTH) % MAP_WIDTH;
+		}
+		
+		for (y_shift = -1; y_shift <= 1; ++y_shift) {
+			if (x_shift == 0 && y_shift == 0) {
+				continue;	// same tile
+			}
+			
+			new_y = y + y_shift;
+			if (new_y < 0 || new_y >= MAP_HEIGHT) {
+				if (!WRAP_Y) {
+					continue;
+				}
+				new_y = (new_y + MAP_HEIGHT) % MAP_HEIGHT;
+			}
+			
+			list[count++] = new_y * MAP_WIDTH + new_x;
+		}
+	}
+	
+	return count;
 }
 
 
@@ -1375,52 +1444,19 @@ void check_newbie_islands(void) {
 }
 
 
-/**
-* Numbers an island and pushes its neighbors onto the stack if they need island
-* ids.
-*
-* @param struct map_data *map A map location.
-* @param int island The island id.
-*/
-void number_island(struct map_data *map, int island) {
-	int x, y, new_x, new_y;
-	struct map_data *tile;
-	room_data *room;
-	
-	map->island = island;
-	
-	// if there's a real room
-	if ((room = real_real_room(map->vnum))) {
-		SET_ISLAND_ID(room, island);
-	}
-	
-	// check neighboring tiles
-	for (x = -1; x <= 1; ++x) {
-		for (y = -1; y <= 1; ++y) {
-			// same tile
-			if (x == 0 && y == 0) {
-				continue;
-			}
-			
-			if (get_coord_shift(MAP_X_COORD(map->vnum), MAP_Y_COORD(map->vnum), x, y, &new_x, &new_y)) {
-				tile = &(world_map[new_x][new_y]);
-				
-				if (!SECT_FLAGGED(tile->sector_type, SECTF_NON_ISLAND) && tile->island <= 0) {
-					// add to stack
-					push_island(tile);
-				}
-			}
-		}
-	}
-}
-
-
 /**
 * This function is normally run at startup to make sure all islands are
 * correctly numbered. It prefers to expand existing islands. You can also
 * call it with reset=TRUE to totally reset all island data, but you may not
 * like what this does to empire inventories on existing games.
 *
+* Unnumbered land is labeled as connected components (union-find over the
+* land_map, 8-way adjacency), so there is no per-tile allocation:
+*  1. join each unnumbered land tile with its unnumbered land neighbors
+*  2. each unnumbered area takes the id of the first numbered tile (in
+*     land_map order) that touches it, like expanding existing islands
+*  3. number the remaining areas in land_map order and measure all islands
+*
 * @param bool reset If TRUE, clears all existing island IDs and renumbers.
 */
 void number_and_count_islands(bool reset) {
@@ -1434,60 +1470,102 @@ void number_and_count_islands(bool reset) {
 		UT_hash_handle hh;
 	};
 	
-	struct island_read_data *data, *next_data, *list = NULL;
+	struct island_read_data *data = NULL, *next_data, *list = NULL;
 	bool re_empire = (top_island_num != -1);
-	struct island_num_data_t *item;
+	int *pos_by_vnum, *parent, *claim_pos, *claim_id;
+	room_vnum neighbors[8];
 	struct island_info *isle;
-	struct map_data *map;
+	struct map_data *map, *tile;
 	room_data *room;
-	int iter, use_id;
+	int iter, use_id, land_count, pos, root, n_pos, num_neighbors;
+	
+	// find top island id (and reset if requested), and number the land_map
+	CREATE(pos_by_vnum, int, MAP_SIZE);
+	for (iter = 0; iter < MAP_SIZE; ++iter) {
+		pos_by_vnum[iter] = NOTHING;
+	}
 	
-	// find top island id (and reset if requested)
 	top_island_num = -1;
+	land_count = 0;
 	for (map = land_map; map; map = map->next) {
+		pos_by_vnum[map->vnum] = land_count++;
+		
 		if (reset || SECT_FLAGGED(map->sector_type, SECTF_NON_ISLAND)) {
-			map->island = NO_ISLAND;
+			if (map->island != NO_ISLAND) {
+				map->island = NO_ISLAND;
+				world_map_needs_save = TRUE;
+			}
 		}
 		else {
 			top_island_num = MAX(top_island_num, map->island);
 		}
 	}
 	
-	// now update the whole world -- if it's not a reset, this is done in two stages:
+	CREATE(parent, int, MAX(1, land_count));
+	CREATE(claim_pos, int, MAX(1, land_count));
+	CREATE(claim_id, int, MAX(1, land_count));
+	for (pos = 0; pos < land_count; ++pos) {
+		parent[pos] = pos;
+		claim_pos[pos] = NOTHING;
+		claim_id[pos] = NO_ISLAND;
+	}
+	
+	// 1. join unnumbered land into connected areas
+	for (map = land_map, pos = 0; map; map = map->next, ++pos) {
+		if (map->island != NO_ISLAND || SECT_FLAGGED(map->sector_type, SECTF_NON_ISLAND)) {
+			continue;
+		}
+		
+		num_neighbors = get_island_neighbors(map->vnum, neighbors);
+		for (iter = 0; iter < num_neighbors; ++iter) {
+			if ((n_pos = pos_by_vnum[neighbors[iter]]) == NOTHING || n_pos > pos) {
+				continue;	// not land, or will be joined from the other side
+			}
+			tile = &(world_map[MAP_X_COORD(neighbors[iter])][MAP_Y_COORD(neighbors[iter])]);
+			if (tile->island == NO_ISLAND && !SECT_FLAGGED(tile->sector_type, SECTF_NON_ISLAND)) {
+				join_island_sets(parent, pos, n_pos);
+			}
+		}
+	}
 	
-	// 1. expand EXISTING islands
+	// 2. existing islands claim the unnumbered areas they touch (first in land_map order wins)
 	if (!reset) {
-		for (map = land_map; map; map = map->next) {
-			if (map->island == NO_ISLAND) {
+		for (map = land_map, pos = 0; map; map = map->next, ++pos) {
+			if (map->island != NO_ISLAND || SECT_FLAGGED(map->sector_type, SECTF_NON_ISLAND)) {
 				continue;
 			}
 			
-			use_id = map->island;
-			push_island(map);
-			
-			while ((item = pop_island())) {
-				number_island(item->loc, use_id);
-				free(item);
+			root = find_island_set(parent, pos);
+			num_neighbors = get_island_neighbors(map->vnum, neighbors);
+			for (iter = 0; iter < num_neighbors; ++iter) {
+				if ((n_pos = pos_by_vnum[neighbors[iter]]) == NOTHING) {
+					continue;
+				}
+				tile = &(world_map[MAP_X_COORD(neighbors[iter])][MAP_Y_COORD(neighbors[iter])]);
+				if (tile->island != NO_ISLAND && (claim_pos[root] == NOTHING || n_pos < claim_pos[root])) {
+					claim_pos[root] = n_pos;
+					claim_id[root] = tile->island;
+				}
 			}
 		}
 	}
 	
-	// 2. look for places that have no island id but need one -- and also measure islands while we're here
-	for (map = land_map; map; map = map->next) {
+	// 3. number everything else and measure islands while we're here
+	for (map = land_map, pos = 0; map; map = map->next, ++pos) {
 		if (map->island == NO_ISLAND && !SECT_FLAGGED(map->sector_type, SECTF_NON_ISLAND)) {
-			use_id = ++top_island_num;
-			push_island(map);
-			
-			while ((item = pop_island())) {
-				number_island(item->loc, use_id);
-				free(item);
+			root = find_island_set(parent, pos);
+			if (claim_id[root] == NO_ISLAND) {
+				claim_id[root] = ++top_island_num;
 			}
+			map->island = claim_id[root];
+			world_map_needs_save = TRUE;
 		}
-		else {
-			use_id = map->island;
-		}
+		use_id = map->island;
 		
-		HASH_FIND_INT(list, &use_id, data);
+		// usually see many of the same island in a row, so this reduces lookups
+		if (!data || data->id != use_id) {
+			HASH_FIND_INT(list, &use_id, data);
+		}
 		if (!data) {	// or create one
 			CREATE(data, struct island_read_data, 1);
 			data->id = use_id;
@@ -1522,6 +1600,11 @@ void number_and_count_islands(bool reset) {
 		}
 	}
 	
+	free(pos_by_vnum);
+	free(parent);
+	free(claim_pos);
+	free(claim_id);
+	
 	// process and free the island helpers
 	HASH_ITER(hh, list, data, next_data) {
 		if ((isle = get_island(data->id, TRUE))) {
@@ -1625,11 +1708,12 @@ char_data *read_mobile(mob_vnum nr, bool with_triggers) {
 		proto = mobile_table;
 	}
 
-	CREATE(mob, char_data, 1);
+	CREATE_SLAB(mob, char_data, SLAB_CHAR);
 	clear_char(mob);
 	*mob = *proto;
 	mob->next = character_list;
 	character_list = mob;
+	mob->list_seq = ++top_list_seq;
 	
 	// safe minimums
 	if (GET_MAX_HEALTH(mob) < 1) {
@@ -1697,12 +1781,13 @@ void clear_object(obj_data *obj) {
 obj_data *create_obj(void) {
 	obj_data *obj;
 
-	CREATE(obj, obj_data, 1);
+	CREATE_SLAB(obj, obj_data, SLAB_OBJ);
 	clear_object(obj);
-	add_to_object_list(obj);
 	
 	// ensure it doesn't decay unless asked
-	GET_OBJ_TIMER(obj) = UNLIMITED;
+	SET_OBJ_TIMER(obj, UNLIMITED);
+	
+	add_to_object_list(obj);
 	
 	obj->script_id = 0;	// will detect when needed
 	
@@ -1727,18 +1812,20 @@ obj_data *read_object(obj_vnum nr, bool with_triggers) {
 		proto = object_table;
 	}
 
-	CREATE(obj, obj_data, 1);
+	CREATE_SLAB(obj, obj_data, SLAB_OBJ);
 	clear_object(obj);
 
 	*obj = *proto;
+	
+	// this must be set before add_to_object_list() starts the timer
+	if (obj->obj_flags.timer == 0)
+		obj->obj_flags.timer = UNLIMITED;
+	
 	add_to_object_list(obj);
 	
 	// applies are ALWAYS a copy
 	GET_OBJ_APPLIES(obj) = copy_obj_apply_list(GET_OBJ_APPLIES(proto));
 	
-	if (obj->obj_flags.timer == 0)
-		obj->obj_flags.timer = UNLIMITED;
-	
 	obj->script_id = 0;	// will detect when needed
 	
 	if (with_triggers) {
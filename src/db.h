@@ -252,6 +252,7 @@ void remove_player_from_account(char_data *ch);
 // adventures
 extern adv_data *adventure_table;
 extern struct instance_data *instance_list;
+extern struct instance_data *instance_table;
 void free_adventure(adv_data *adv);
 extern adv_data *adventure_proto(adv_vnum vnum);
 
@@ -356,6 +357,8 @@ extern char_data *next_combat_list;
 extern char_data *mobile_table;
 extern player_index_data *player_table_by_idnum;
 extern player_index_data *player_table_by_name;
+extern char_data *player_character_list;
+extern struct player_name_index *player_name_index;
 extern player_index_data *find_player_index_by_idnum(int idnum);
 extern player_index_data *find_player_index_by_name(char *name);
 void init_player(char_data *ch);
@@ -375,6 +378,10 @@ extern char_data *find_or_load_player(char *name, bool *is_file);
 void store_loaded_char(char_data *ch);
 char_data *load_player(char *name, bool normal);
 
+// keyword index
+extern struct keyword_index *keyword_index[NUM_KWI];
+extern unsigned long long top_list_seq;
+
 // morphs
 extern morph_data *morph_table;
 extern morph_data *sorted_morphs;
@@ -449,10 +456,15 @@ extern struct room_direction_data *create_exit(room_data *from, room_data *to, i
 void delete_room(room_data *room, bool check_exits);
 extern room_data *world_table;
 extern room_data *interior_room_list;
+extern struct world_block_data *world_block_table;
 extern struct map_data world_map[MAP_WIDTH][MAP_HEIGHT];
 extern struct map_data *land_map;
 room_data *real_real_room(room_vnum vnum);
 room_data *real_room(room_vnum vnum);
+void run_room_updates(int group, bool all_rooms, void (*func)(room_data *room));
+void schedule_all_room_updates();
+void schedule_room_updates(room_data *room);
+void set_room_home(room_data *room, room_data *home);
 
 // misc
 extern struct obj_apply *copy_obj_apply_list(struct obj_apply *list);
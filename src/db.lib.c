@@ -54,29 +54,31 @@
 // external variables
 extern struct db_boot_info_type db_boot_info[NUM_DB_BOOT_TYPES];
 extern struct player_special_data dummy_mob;
-extern bool world_is_sorted;
 
 // external funcs
+extern char get_banner_mapout_token(char *banner);
 extern struct complex_room_data *init_complex_data();
 void Crash_save_one_obj_to_file(FILE *fl, obj_data *obj, int location);
 void free_archetype_gear(struct archetype_gear *list);
 extern room_data *load_map_room(room_vnum vnum);
 extern obj_data *Obj_load_from_file(FILE *fl, obj_vnum vnum, int *location, char_data *notify);
 void sort_exits(struct room_direction_data **list);
-void sort_world_table();
 
 // locals
+void add_npc_to_worker_cells(empire_data *emp, struct empire_npc_data *npc);
 int check_object(obj_data *obj);
-int count_hash_records(FILE *fl);
 empire_vnum find_free_empire_vnum(void);
+int get_worker_cell(room_data *home);
 void parse_custom_message(FILE *fl, struct custom_message **list, char *error);
 void parse_extra_desc(FILE *fl, struct extra_descr_data **list, char *error_part);
 void parse_generic_name_file(FILE *fl, char *err_str);
 void parse_icon(char *line, FILE *fl, struct icon_data **list, char *error_part);
 void parse_interaction(char *line, struct interaction_item **list, char *error_part);
 void parse_resource(FILE *fl, struct resource_data **list, char *error_str);
+void remove_npc_from_worker_cells(struct empire_npc_data *npc);
 int sort_empires(empire_data *a, empire_data *b);
 int sort_room_templates(room_template *a, room_template *b);
+int sort_world_blocks(struct world_block_data *a, struct world_block_data *b);
 void write_custom_messages_to_file(FILE *fl, char letter, struct custom_message *list);
 void write_extra_descs_to_file(FILE *fl, struct extra_descr_data *list);
 void write_icons_to_file(FILE *fl, char file_tag, struct icon_data *list);
@@ -1230,6 +1232,7 @@ empire_data *create_empire(char_data *ch) {
 	EMPIRE_ADJECTIVE(emp) = str_dup(name);
 	sprintf(colorcode, "&%c", colorlist[number(0, num_colors-1)]);	// pick random color
 	EMPIRE_BANNER(emp) = str_dup(colorcode);
+	EMPIRE_MAPOUT_TOKEN(emp) = get_banner_mapout_token(EMPIRE_BANNER(emp));
 	
 	EMPIRE_CREATE_TIME(emp) = time(0);
 
@@ -1441,6 +1444,8 @@ void delete_territory_npc(struct empire_territory_data *ter, struct empire_npc_d
 		npc->mob = NULL;
 	}
 	
+	remove_npc_from_worker_cells(npc);
+	
 	// reduce pop
 	if (emp) {
 		EMPIRE_POPULATION(emp) -= 1;
@@ -1483,12 +1488,13 @@ void ewt_free_tracker(struct empire_workforce_tracker **tracker) {
 * @param empire_data *emp The empire to free
 */
 void free_empire(empire_data *emp) {
-	extern struct empire_territory_data *global_next_territory_entry;
+	void remove_territory_chores(empire_data *emp, struct empire_territory_data *ter);
 	
 	struct empire_island *isle, *next_isle;
 	struct empire_storage_data *store;
 	struct empire_unique_storage *eus;
 	struct empire_territory_data *ter;
+	struct empire_npc_cell *cell, *next_cell;
 	struct empire_city_data *city;
 	struct empire_political_data *pol;
 	struct empire_trade_data *trade;
@@ -1558,19 +1564,24 @@ void free_empire(empire_data *emp) {
 	
 	// free territory
 	while ((ter = emp->territory_list)) {
-		if (ter == global_next_territory_entry) {
-			global_next_territory_entry = ter->next;
-		}
-		
 		// free npcs
 		while (ter->npcs) {
 			delete_territory_npc(ter, ter->npcs);
 		}
 		
+		remove_territory_chores(emp, ter);
+		
 		emp->territory_list = ter->next;
+		HASH_DEL(EMPIRE_TERRITORY_HASH(emp), ter);
 		free(ter);
 	}
 	
+	// free workforce index (empty now)
+	HASH_ITER(hh, EMPIRE_NPC_CELLS(emp), cell, next_cell) {
+		HASH_DEL(EMPIRE_NPC_CELLS(emp), cell);
+		free(cell);
+	}
+	
 	// free diplomacy
 	while ((pol = emp->diplomacy)) {
 		emp->diplomacy = pol->next;
@@ -1804,6 +1815,7 @@ void parse_empire(FILE *fl, empire_vnum vnum) {
 	emp->adjective = fread_string(fl, buf2);
 	emp->banner = fread_string(fl, buf2);
 	EMPIRE_BANNER_HAS_UNDERLINE(emp) = (strstr(EMPIRE_BANNER(emp), "&u") ? TRUE : FALSE);
+	EMPIRE_MAPOUT_TOKEN(emp) = get_banner_mapout_token(EMPIRE_BANNER(emp));
 	
 	if (!get_line(fl, line)) {
 		log("SYSERR: Expecting ranks type of empire #%d but file ended!", vnum);
@@ -2276,12 +2288,78 @@ struct empire_npc_data *create_empire_npc(empire_data *emp, mob_vnum mobv, int s
 	npc->next = ter->npcs;
 	ter->npcs = npc;
 	
+	add_npc_to_worker_cells(emp, npc);
+	
 	EMPIRE_NEEDS_SAVE(emp) = TRUE;
 	
 	return npc;
 }
 
 
+/**
+* Determines which workforce index cell a home belongs in: its map area, or
+* WORKER_CELL_MOBILE if it can move (or has no map location).
+*
+* @param room_data *home Where an npc lives.
+* @return int The cell.
+*/
+int get_worker_cell(room_data *home) {
+	room_data *map;
+	
+	if (!home || GET_ROOM_VEHICLE(HOME_ROOM(home)) || !(map = get_map_location_for(home))) {
+		return WORKER_CELL_MOBILE;
+	}
+	
+	return (FLAT_X_COORD(map) / WORKER_CELL_SIZE) + (FLAT_Y_COORD(map) / WORKER_CELL_SIZE) * WORKER_CELLS_WIDE;
+}
+
+
+/**
+* Adds a citizen to its empire's workforce index, which find_free_npc_for_chore
+* uses to look for laborers near a chore. Other npcs are never used as laborers
+* and are not indexed. If the npc was already indexed, it is moved to the
+* correct cell (e.g. if its home was moved).
+*
+* @param empire_data *emp The empire the npc belongs to.
+* @param struct empire_npc_data *npc The npc.
+*/
+void add_npc_to_worker_cells(empire_data *emp, struct empire_npc_data *npc) {
+	struct empire_npc_cell *cell;
+	int cell_id;
+	
+	if (!emp || !npc || (npc->vnum != CITIZEN_MALE && npc->vnum != CITIZEN_FEMALE)) {
+		return;
+	}
+	
+	remove_npc_from_worker_cells(npc);
+	
+	cell_id = get_worker_cell(npc->home);
+	HASH_FIND_INT(EMPIRE_NPC_CELLS(emp), &cell_id, cell);
+	if (!cell) {
+		CREATE(cell, struct empire_npc_cell, 1);
+		cell->cell = cell_id;
+		HASH_ADD_INT(EMPIRE_NPC_CELLS(emp), cell, cell);
+	}
+	
+	DL_PREPEND2(cell->npcs, npc, prev_in_cell, next_in_cell);
+	npc->cell = cell;
+}
+
+
+/**
+* Removes an npc from the workforce index, if it's in it. Empty cells are kept
+* until the empire is freed.
+*
+* @param struct empire_npc_data *npc The npc.
+*/
+void remove_npc_from_worker_cells(struct empire_npc_data *npc) {
+	if (npc && npc->cell) {
+		DL_DELETE2(npc->cell->npcs, npc, prev_in_cell, next_in_cell);
+		npc->cell = NULL;
+	}
+}
+
+
 /**
 * frees up the data for a room that may have npcs.
 *
@@ -2403,7 +2481,7 @@ void update_empire_npc_data(void) {
 	struct empire_territory_data *ter, *next_ter;
 	empire_data *emp, *next_emp;
 	
-	int time_to_empire_emptiness = config_get_int("time_to_empire_emptiness") * SECS_PER_REAL_WEEK;
+	int time_to_empire_emptiness = CONFIG_INT(CONF_TIME_TO_EMPIRE_EMPTINESS) * SECS_PER_REAL_WEEK;
 	
 	// each empire
 	HASH_ITER(hh, empire_table, emp, next_emp) {
@@ -3373,7 +3451,7 @@ void parse_mobile(FILE *mob_f, int nr) {
 	char_data *mob, *find;
 	
 	// create!
-	CREATE(mob, char_data, 1);
+	CREATE_SLAB(mob, char_data, SLAB_CHAR);
 	clear_char(mob);
 	mob->vnum = nr;
 
@@ -3640,7 +3718,7 @@ void free_obj(obj_data *obj) {
 		remove_from_lookup_table(obj->script_id);
 	}
 
-	free(obj);
+	FREE_SLAB(SLAB_OBJ, obj);
 }
 
 
@@ -3660,7 +3738,7 @@ void parse_object(FILE *obj_f, int nr) {
 	obj_data *obj, *find;
 	
 	// create
-	CREATE(obj, obj_data, 1);
+	CREATE_SLAB(obj, obj_data, SLAB_OBJ);
 	clear_object(obj);
 	obj->vnum = nr;
 
@@ -4066,12 +4144,43 @@ void write_resources_to_file(FILE *fl, char letter, struct resource_data *list)
 //// ROOM LIB ////////////////////////////////////////////////////////////////
 
 
+// safe-iteration pointers for run_room_updates(), in case the next room is deleted
+static room_data *block_room_iter_next = NULL;
+static room_data *update_room_iter_next = NULL;
+
+
+/**
+* Finds (or creates) the world block entry for a block number. The table is
+* kept sorted by block number so that it can be iterated in file order.
+*
+* @param int block The GET_WORLD_BLOCK() number.
+* @param bool create If TRUE, creates the entry if it doesn't exist.
+* @return struct world_block_data* The block, or NULL if it doesn't exist and create is FALSE.
+*/
+static struct world_block_data *find_world_block(int block, bool create) {
+	struct world_block_data *wbd;
+	
+	HASH_FIND_INT(world_block_table, &block, wbd);
+	if (!wbd && create) {
+		CREATE(wbd, struct world_block_data, 1);
+		wbd->block = block;
+		HASH_ADD_INT(world_block_table, block, wbd);
+		HASH_SORT(world_block_table, sort_world_blocks);
+	}
+	
+	return wbd;
+}
+
+
 /**
 * Adds a room to any applicable world hash tables.
 *
 * @param room_data *room The room to add.
 */
-void add_room_to_world_tables(room_data *room) {	
+void add_room_to_world_tables(room_data *room) {
+	struct world_block_data *wbd;
+	room_data *iter;
+	
 	HASH_ADD_INT(world_table, vnum, room);
 	
 	// interior linked list
@@ -4079,8 +4188,31 @@ void add_room_to_world_tables(room_data *room) {
 		room->next_interior = interior_room_list;
 		interior_room_list = room;
 	}
+	else {
+		world_map[MAP_X_COORD(GET_ROOM_VNUM(room))][MAP_Y_COORD(GET_ROOM_VNUM(room))].room = room;
+	}
+	
+	// block list, kept in vnum order: rooms are usually added in order, so search from the end
+	wbd = find_world_block(GET_WORLD_BLOCK(GET_ROOM_VNUM(room)), TRUE);
+	room->block = wbd;
+	iter = wbd->rooms ? wbd->rooms->prev_in_block : NULL;	// tail
+	while (iter && GET_ROOM_VNUM(iter) > GET_ROOM_VNUM(room)) {
+		iter = (iter == wbd->rooms) ? NULL : iter->prev_in_block;
+	}
 	
-	world_is_sorted = FALSE;
+	if (!iter) {
+		DL_PREPEND2(wbd->rooms, room, prev_in_block, next_in_block);
+	}
+	else if (!iter->next_in_block) {
+		DL_APPEND2(wbd->rooms, room, prev_in_block, next_in_block);
+	}
+	else {
+		// insert after iter
+		room->prev_in_block = iter;
+		room->next_in_block = iter->next_in_block;
+		iter->next_in_block->prev_in_block = room;
+		iter->next_in_block = room;
+	}
 }
 
 
@@ -4097,6 +4229,128 @@ void remove_room_from_world_tables(room_data *room) {
 	if (room->vnum >= MAP_SIZE) {
 		REMOVE_FROM_LIST(room, interior_room_list, next_interior);
 	}
+	else {
+		world_map[MAP_X_COORD(room->vnum)][MAP_Y_COORD(room->vnum)].room = NULL;
+	}
+	
+	if (room->in_update_list) {
+		if (update_room_iter_next == room) {
+			update_room_iter_next = room->next_update;
+		}
+		DL_DELETE2(room->block->update_rooms, room, prev_update, next_update);
+		room->in_update_list = FALSE;
+	}
+	if (room->block) {
+		if (block_room_iter_next == room) {
+			block_room_iter_next = room->next_in_block;
+		}
+		DL_DELETE2(room->block->rooms, room, prev_in_block, next_in_block);
+		room->block = NULL;
+	}
+}
+
+
+/**
+* Determines if a room has anything for the periodic room updates to do:
+* reset triggers, affects, tracks, fires, trenches, crops, taverns, and
+* stables. This must be a superset of the checks in update_world() and
+* point_update_room().
+*
+* @param room_data *room The room to check.
+* @return bool TRUE if the room belongs in its block's update list.
+*/
+bool room_needs_periodic_updates(room_data *room) {
+	if (SCRIPT(room) || ROOM_AFFECTS(room) || ROOM_TRACKS(room)) {
+		return TRUE;
+	}
+	if (COMPLEX_DATA(room) && COMPLEX_DATA(room)->burning) {
+		return TRUE;	// home room of a burning building
+	}
+	if (ROOM_SECT_FLAGGED(room, SECTF_IS_TRENCH)) {
+		return TRUE;
+	}
+	if (ROOM_SECT_FLAGGED(room, SECTF_HAS_CROP_DATA) && get_room_extra_data(room, ROOM_EXTRA_SEED_TIME)) {
+		return TRUE;
+	}
+	if (HAS_FUNCTION(room, FNC_TAVERN | FNC_STABLE)) {
+		return TRUE;
+	}
+	
+	return FALSE;
+}
+
+
+/**
+* Adds a room to its world block's update list, if it needs periodic updates.
+* Call this any time a room gains something from room_needs_periodic_updates().
+* Rooms that no longer need updates are dropped lazily by run_room_updates().
+*
+* @param room_data *room The room to check.
+*/
+void schedule_room_updates(room_data *room) {
+	if (!room || room->in_update_list || !room->block) {
+		return;
+	}
+	if (room_needs_periodic_updates(room)) {
+		DL_APPEND2(room->block->update_rooms, room, prev_update, next_update);
+		room->in_update_list = TRUE;
+	}
+}
+
+
+/**
+* Checks every room in the world for the update lists. This runs once at
+* startup and again whenever OLC changes something that might affect a lot of
+* rooms at once.
+*/
+void schedule_all_room_updates(void) {
+	room_data *room, *next_room;
+	
+	HASH_ITER(hh, world_table, room, next_room) {
+		schedule_room_updates(room);
+	}
+}
+
+
+/**
+* Runs an update function on rooms by world block. This is safe even if the
+* update function deletes rooms.
+*
+* @param int group Only blocks where (block % NUM_WORLD_BLOCK_UPDATES) == group, or NOTHING for all blocks.
+* @param bool all_rooms If TRUE, runs on every room in those blocks; if FALSE, only on rooms that need periodic updates.
+* @param void (*func)(room_data *room) The update to run on each room.
+*/
+void run_room_updates(int group, bool all_rooms, void (*func)(room_data *room)) {
+	struct world_block_data *wbd, *next_wbd;
+	room_data *room;
+	
+	HASH_ITER(hh, world_block_table, wbd, next_wbd) {
+		if (group != NOTHING && (wbd->block % NUM_WORLD_BLOCK_UPDATES) != group) {
+			continue;
+		}
+		
+		if (all_rooms) {
+			for (room = wbd->rooms; room; room = block_room_iter_next) {
+				block_room_iter_next = room->next_in_block;
+				(func)(room);
+			}
+			block_room_iter_next = NULL;
+		}
+		else {
+			for (room = wbd->update_rooms; room; room = update_room_iter_next) {
+				update_room_iter_next = room->next_update;
+				
+				if (!room_needs_periodic_updates(room)) {
+					DL_DELETE2(wbd->update_rooms, room, prev_update, next_update);
+					room->in_update_list = FALSE;
+					continue;
+				}
+				
+				(func)(room);
+			}
+			update_room_iter_next = NULL;
+		}
+	}
 }
 
 
@@ -4121,7 +4375,7 @@ void parse_room(FILE *fl, room_vnum vnum) {
 
 	sprintf(error_buf, "room #%d", vnum);
 	
-	CREATE(room, room_data, 1);
+	CREATE_SLAB(room, room_data, SLAB_ROOM);
 	
 	// basic setup: things that don't default to 0/NULL
 	room->vnum = vnum;
@@ -5288,8 +5542,9 @@ void write_trigger_to_file(FILE *fl, trig_data *trig) {
 * @param FILE *fl The file to read.
 * @param int mode Any DB_BOOT_ const.
 * @param char *filename The name of the file, for error reporting.
+* @return int The number of records loaded.
 */
-void discrete_load(FILE *fl, int mode, char *filename) {
+int discrete_load(FILE *fl, int mode, char *filename) {
 	void parse_ability(FILE *fl, any_vnum vnum);
 	void parse_account(FILE *fl, int nr);
 	void parse_archetype(FILE *fl, any_vnum vnum);
@@ -5303,6 +5558,7 @@ void discrete_load(FILE *fl, int mode, char *filename) {
 	void parse_vehicle(FILE *fl, any_vnum vnum);
 	
 	any_vnum nr = -1, last;
+	int count = 0;
 	char line[256];
 
 	/* modes positions correspond to DB_BOOT_x in db.h */
@@ -5319,7 +5575,7 @@ void discrete_load(FILE *fl, int mode, char *filename) {
 		}
 
 		if (*line == '$')
-			return;
+			return count;
 
 		if (*line == '#') {
 			last = nr;
@@ -5327,6 +5583,8 @@ void discrete_load(FILE *fl, int mode, char *filename) {
 				log("SYSERR: Format error after %s #%d", modes[mode], last);
 				exit(1);
 			}
+			++count;
+			
 			// DB_BOOT_x
 			switch (mode) {
 				case DB_BOOT_ABIL: {
@@ -5437,17 +5695,56 @@ void discrete_load(FILE *fl, int mode, char *filename) {
 }
 
 
+/**
+* Asks the OS to start reading a whole file into cache in the background, so
+* that all the files for one index_boot() are read in parallel while the
+* first ones are still being parsed.
+*
+* @param char *filename The file that will be loaded soon.
+*/
+static void prefetch_boot_file(char *filename) {
+#ifdef POSIX_FADV_WILLNEED
+	int fd;
+	
+	if ((fd = open(filename, O_RDONLY)) != -1) {
+		posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+		close(fd);
+	}
+#endif
+}
+
+
+/**
+* Logs how long an index_boot() took.
+*
+* @param int num_files How many files it loaded.
+* @param struct timeval *start_time When it started.
+*/
+static void log_index_boot_time(int num_files, struct timeval *start_time) {
+	struct timeval end_time;
+	
+	gettimeofday(&end_time, NULL);
+	log("   ...%d file%s loaded in %.3f seconds.", num_files, PLURAL(num_files), (end_time.tv_sec - start_time->tv_sec) + (end_time.tv_usec - start_time->tv_usec) / 1000000.0);
+}
+
+
 /**
 * index_boot: Loads an index file for a given type, and loads each entry from
-* the index using discrete_load.
+* the index using discrete_load. All the files are prefetched first, then
+* parsed in index order so the load order is always the same.
 *
 * @param int mode Any DB_BOOT_ const.
 */
 void index_boot(int mode) {
 	char buf1[MAX_STRING_LENGTH], buf2[MAX_STRING_LENGTH];
 	const char *index_filename, *prefix = NULL;
+	struct timeval start_time;
+	char **files = NULL;
+	int iter, num_files = 0, max_files = 0;
 	FILE *index, *db_file;
 	int rec_count = 0, size[2];
+	
+	gettimeofday(&start_time, NULL);
 
 	if (mode >= 0 && mode < NUM_DB_BOOT_TYPES && db_boot_info[mode].prefix) {
 		prefix = db_boot_info[mode].prefix;
@@ -5465,28 +5762,78 @@ void index_boot(int mode) {
 		log("SYSERR: opening index file '%s': %s", buf2, strerror(errno));
 		exit(1);
 	}
-
-	/* first, count the number of records in the file so we can malloc */
+	
+	// read the index and start the OS reading every file on it
 	fscanf(index, "%s\n", buf1);
 	while (*buf1 != '$') {
 		sprintf(buf2, "%s%s", prefix, buf1);
-		if (!(db_file = fopen(buf2, "r"))) {
-			log("SYSERR: File '%s' listed in '%s%s': %s", buf2, prefix, index_filename, strerror(errno));
-			fscanf(index, "%s\n", buf1);
-			continue;
+		if (num_files >= max_files) {
+			max_files = MAX(16, max_files * 2);
+			RECREATE(files, char*, max_files);
 		}
-		else {
-			rec_count += count_hash_records(db_file);
+		files[num_files++] = str_dup(buf2);
+		prefetch_boot_file(buf2);
+		
+		fscanf(index, "%s\n", buf1);
+	}
+	fclose(index);
+	
+	// parse them in order
+	for (iter = 0; iter < num_files; ++iter) {
+		if (!(db_file = fopen(files[iter], "r"))) {
+			log("SYSERR: File '%s' listed in '%s%s': %s", files[iter], prefix, index_filename, strerror(errno));
+			exit(1);
+		}
+		setvbuf(db_file, NULL, _IOFBF, 64 * 1024);	// fewer, larger reads
+		
+		// DB_BOOT_x
+		switch (mode) {
+			case DB_BOOT_ABIL:
+			case DB_BOOT_ACCT:
+			case DB_BOOT_ADV:
+			case DB_BOOT_ARCH:
+			case DB_BOOT_AUG:
+			case DB_BOOT_BLD:
+			case DB_BOOT_CLASS:
+			case DB_BOOT_CRAFT:
+			case DB_BOOT_CROP:
+			case DB_BOOT_FCT:
+			case DB_BOOT_GLB:
+			case DB_BOOT_OBJ:
+			case DB_BOOT_MOB:
+			case DB_BOOT_MORPH:
+			case DB_BOOT_EMP:
+			case DB_BOOT_BOOKS:
+			case DB_BOOT_QST:
+			case DB_BOOT_RMT:
+			case DB_BOOT_SECTOR:
+			case DB_BOOT_SKILL:
+			case DB_BOOT_SOC:
+			case DB_BOOT_TRG:
+			case DB_BOOT_VEH:
+			case DB_BOOT_WLD: {
+				rec_count += discrete_load(db_file, mode, files[iter]);
+				break;
+			}
+			case DB_BOOT_NAMES: {
+				parse_generic_name_file(db_file, files[iter]);
+				++rec_count;
+				break;
+			}
 		}
 
 		fclose(db_file);
-		fscanf(index, "%s\n", buf1);
+		free(files[iter]);
+	}
+	if (files) {
+		free(files);
 	}
 
 	if (!rec_count) {
 		// DB_BOOT_x: some types don't matter TODO could move this into a config
 		if (mode == DB_BOOT_EMP || mode == DB_BOOT_BOOKS || mode == DB_BOOT_CRAFT || mode == DB_BOOT_BLD || mode == DB_BOOT_ADV || mode == DB_BOOT_RMT || mode == DB_BOOT_WLD || mode == DB_BOOT_GLB || mode == DB_BOOT_ACCT || mode == DB_BOOT_AUG || mode == DB_BOOT_ARCH || mode == DB_BOOT_ABIL || mode == DB_BOOT_CLASS || mode == DB_BOOT_SKILL || mode == DB_BOOT_VEH || mode == DB_BOOT_MORPH || mode == DB_BOOT_QST || mode == DB_BOOT_SOC || mode == DB_BOOT_FCT) {
-			// types that don't require any entries and exit early if none
+			// types that don't require any entries
+			log_index_boot_time(num_files, &start_time);
 			return;
 		}
 		else if (mode == DB_BOOT_NAMES) {
@@ -5624,53 +5971,8 @@ void index_boot(int mode) {
 			break;
 		}
 	}
-	rewind(index);
-	fscanf(index, "%s\n", buf1);
-	while (*buf1 != '$') {
-		sprintf(buf2, "%s%s", prefix, buf1);
-		if (!(db_file = fopen(buf2, "r"))) {
-			log("SYSERR: %s: %s", buf2, strerror(errno));
-			exit(1);
-		}
-		// DB_BOOT_x
-		switch (mode) {
-			case DB_BOOT_ABIL:
-			case DB_BOOT_ACCT:
-			case DB_BOOT_ADV:
-			case DB_BOOT_ARCH:
-			case DB_BOOT_AUG:
-			case DB_BOOT_BLD:
-			case DB_BOOT_CLASS:
-			case DB_BOOT_CRAFT:
-			case DB_BOOT_CROP:
-			case DB_BOOT_FCT:
-			case DB_BOOT_GLB:
-			case DB_BOOT_OBJ:
-			case DB_BOOT_MOB:
-			case DB_BOOT_MORPH:
-			case DB_BOOT_EMP:
-			case DB_BOOT_BOOKS:
-			case DB_BOOT_QST:
-			case DB_BOOT_RMT:
-			case DB_BOOT_SECTOR:
-			case DB_BOOT_SKILL:
-			case DB_BOOT_SOC:
-			case DB_BOOT_TRG:
-			case DB_BOOT_VEH:
-			case DB_BOOT_WLD: {
-				discrete_load(db_file, mode, buf2);
-				break;
-			}
-			case DB_BOOT_NAMES: {
-				parse_generic_name_file(db_file, buf2);
-				break;
-			}
-		}
-
-		fclose(db_file);
-		fscanf(index, "%s\n", buf1);
-	}
-	fclose(index);
+	
+	log_index_boot_time(num_files, &start_time);
 }
 
 
@@ -6560,24 +6862,6 @@ void clean_empire_logs(void) {
 }
 
 
-/**
-* function to count how many hash-mark delimited records exist in a file
-*
-* @param FILE *fl A file.
-* @return int The number of lines in the file that start with #
-*/
-int count_hash_records(FILE *fl) {
-	char buf[128];
-	int count = 0;
-
-	while (fgets(buf, 128, fl))
-		if (*buf == '#')
-			count++;
-
-	return (count);
-}
-
-
 /**
 * This function is called mainly when someone is trying to claim land. It
 * will create an empire if the player isn't in one.
@@ -7145,25 +7429,14 @@ int sort_triggers(trig_data *a, trig_data *b) {
 
 
 /**
-* Simple sorter for the world_table hash
+* Simple sorter for world_block_table.
 *
-* @param void *a One element
-* @param void *b Another element
+* @param struct world_block_data *a One element
+* @param struct world_block_data *b Another element
 * @return int Sort instruction of -1, 0, or 1
 */
-int sort_world_table_func(void *a, void *b) {
-	return ((room_data*)a)->vnum - ((room_data*)b)->vnum;
-}
-
-
-/**
-* Sorts the world table -- only necessary for things like saving.
-*/
-void sort_world_table(void) {
-	if (!world_is_sorted) {
-		HASH_SORT(world_table, sort_world_table_func);
-	}
-	world_is_sorted = TRUE;
+int sort_world_blocks(struct world_block_data *a, struct world_block_data *b) {
+	return a->block - b->block;
 }
 
 
@@ -7282,11 +7555,46 @@ struct complex_room_data *init_complex_data() {
 }
 
 
+/**
+* Sets (or clears) the home room of an interior room, and keeps the home's
+* interior_rooms list in sync. Always use this instead of setting home_room
+* directly.
+*
+* @param room_data *room The interior room (must have COMPLEX_DATA).
+* @param room_data *home Its new home room, or NULL to clear it.
+*/
+void set_room_home(room_data *room, room_data *home) {
+	room_data *old;
+	
+	if (!COMPLEX_DATA(room)) {
+		return;
+	}
+	
+	// remove from the old home's list (prev_in_home is only set while in a list)
+	if (room->prev_in_home && (old = COMPLEX_DATA(room)->home_room) && COMPLEX_DATA(old)) {
+		DL_DELETE2(COMPLEX_DATA(old)->interior_rooms, room, prev_in_home, next_in_home);
+	}
+	room->prev_in_home = room->next_in_home = NULL;
+	
+	COMPLEX_DATA(room)->home_room = home;
+	
+	if (home && home != room && COMPLEX_DATA(home)) {
+		DL_APPEND2(COMPLEX_DATA(home)->interior_rooms, room, prev_in_home, next_in_home);
+	}
+}
+
+
 /**
 * @param struct complex_room_data *data The building data to delete.
 */
 void free_complex_data(struct complex_room_data *data) {
 	struct room_direction_data *ex;
+	room_data *iter, *next_iter;
+	
+	// detach any interiors still pointing here (their home_room is cleared separately)
+	DL_FOREACH_SAFE2(data->interior_rooms, iter, next_iter, next_in_home) {
+		iter->prev_in_home = iter->next_in_home = NULL;
+	}
 	
 	while ((ex = data->exits)) {
 		data->exits = ex->next;
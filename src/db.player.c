@@ -905,6 +905,12 @@ void free_char(char_data *ch) {
 			HASH_DEL(GET_ABILITY_HASH(ch), abil);
 			free(abil);
 		}
+		if (GET_SKILL_CACHE(ch).abilities) {
+			free(GET_SKILL_CACHE(ch).abilities);
+		}
+		if (GET_SKILL_CACHE(ch).levels) {
+			free(GET_SKILL_CACHE(ch).levels);
+		}
 		HASH_ITER(hh, GET_MOUNT_LIST(ch), mount, next_mount) {
 			HASH_DEL(GET_MOUNT_LIST(ch), mount);
 			free(mount);
@@ -959,7 +965,7 @@ void free_char(char_data *ch) {
 		remove_from_lookup_table(ch->script_id);
 	}
 
-	free(ch);
+	FREE_SLAB(SLAB_CHAR, ch);
 }
 
 
@@ -1064,7 +1070,7 @@ char_data *read_player_from_file(FILE *fl, char *name, bool normal, char_data *c
 	
 	// allocate player if we didn't receive one
 	if (!ch) {
-		CREATE(ch, char_data, 1);
+		CREATE_SLAB(ch, char_data, SLAB_CHAR);
 		clear_char(ch);
 		init_player_specials(ch);
 		clear_player(ch);
@@ -1145,6 +1151,7 @@ char_data *read_player_from_file(FILE *fl, char *name, bool normal, char_data *c
 							abildata->levels_gained = i_in[2];
 						}
 					}
+					GET_SKILL_CACHE(ch).valid = FALSE;
 				}
 				else if (PFILE_TAG(line, "Access Level:", length)) {
 					GET_ACCESS_LEVEL(ch) = atoi(line + length + 1);
@@ -1193,7 +1200,7 @@ char_data *read_player_from_file(FILE *fl, char *name, bool normal, char_data *c
 				}
 				else if (PFILE_TAG(line, "Affect:", length)) {
 					sscanf(line + length + 1, "%d %d %d %d %d %s", &i_in[0], &i_in[1], &i_in[2], &i_in[3], &i_in[4], str_in);
-					CREATE(af, struct affected_type, 1);
+					CREATE_SLAB(af, struct affected_type, SLAB_AFFECT);
 					af->type = i_in[0];
 					af->cast_by = i_in[1];
 					af->duration = i_in[2];
@@ -1780,6 +1787,7 @@ char_data *read_player_from_file(FILE *fl, char *name, bool normal, char_data *c
 						skdata->exp = dbl_in;
 						skdata->resets = i_in[2];
 						skdata->noskill = i_in[3];
+						GET_SKILL_CACHE(ch).valid = FALSE;
 					}
 				}
 				else if (PFILE_TAG(line, "Skill Level:", length)) {
@@ -1789,6 +1797,7 @@ char_data *read_player_from_file(FILE *fl, char *name, bool normal, char_data *c
 					GET_CURRENT_SKILL_SET(ch) = atoi(line + length + 1);
 					GET_CURRENT_SKILL_SET(ch) = MAX(0, GET_CURRENT_SKILL_SET(ch));
 					GET_CURRENT_SKILL_SET(ch) = MIN(NUM_SKILL_SETS-1, GET_CURRENT_SKILL_SET(ch));
+					GET_SKILL_CACHE(ch).valid = FALSE;
 				}
 				else if (PFILE_TAG(line, "Slash-channel:", length)) {
 					CREATE(slash, struct slash_channel, 1);
@@ -1903,7 +1912,7 @@ char_data *read_player_from_file(FILE *fl, char *name, bool normal, char_data *c
 	// apply affects
 	LL_FOREACH_SAFE(af_list, af, next_af) {
 		affect_to_char(ch, af);
-		free(af);
+		FREE_SLAB(SLAB_AFFECT, af);
 	}
 	
 	// safety
@@ -2142,7 +2151,7 @@ void write_player_primary_data_to_file(FILE *fl, char_data *ch) {
 	af_list = NULL;
 	while ((af = ch->affected)) {
 		if (af->type > ATYPE_RESERVED && af->type < NUM_ATYPES) {
-			CREATE(new_af, struct affected_type, 1);
+			CREATE_SLAB(new_af, struct affected_type, SLAB_AFFECT);
 			*new_af = *af;
 			new_af->next = af_list;
 			af_list = new_af;
@@ -2454,7 +2463,7 @@ void write_player_primary_data_to_file(FILE *fl, char_data *ch) {
 	for (af = af_list; af; af = next_af) {
 		next_af = af->next;
 		affect_to_char(ch, af);
-		free(af);
+		FREE_SLAB(SLAB_AFFECT, af);
 	}
 	
 	// re-apply: equipment
@@ -2989,6 +2998,7 @@ void check_skills_and_abilities(char_data *ch) {
 			plsk->level = SKILL_MAX_LEVEL(plsk->ptr);
 		}
 	}
+	GET_SKILL_CACHE(ch).valid = FALSE;
 	update_class(ch);
 	check_ability_levels(ch, NOTHING);
 }
@@ -3307,6 +3317,8 @@ void enter_player_game(descriptor_data *d, int dolog, bool fresh) {
 	// add to lists
 	ch->next = character_list;
 	character_list = ch;
+	ch->list_seq = ++top_list_seq;
+	add_player_to_name_index(ch);
 	ch->script_id = GET_IDNUM(ch);
 	add_to_lookup_table(ch->script_id, (void *)ch);
 	
@@ -3446,6 +3458,7 @@ void enter_player_game(descriptor_data *d, int dolog, bool fresh) {
 		GET_LAST_TELL(ch) = NOBODY;
 	}
 	
+	MSDP_DIRTY(ch, MSDP_DIRTY_ALL);
 	msdp_update_room(ch);
 	
 	// now is a good time to save and be sure we have a good save file
@@ -52,6 +52,7 @@ extern int evos_per_hour;
 
 // external funcs
 void add_room_to_world_tables(room_data *room);
+void clear_map_icon_cache(room_data *room, struct map_data *map);
 extern struct resource_data *combine_resources(struct resource_data *combine_a, struct resource_data *combine_b);
 void complete_building(room_data *room);
 void delete_territory_entry(empire_data *emp, struct empire_territory_data *ter);
@@ -60,9 +61,11 @@ void free_complex_data(struct complex_room_data *bld);
 extern FILE *open_world_file(int block);
 void remove_room_from_world_tables(room_data *room);
 void save_and_close_world_file(FILE *fl, int block);
+void schedule_room_chores(room_data *room);
 void setup_start_locations();
 void sort_exits(struct room_direction_data **list);
-void sort_world_table();
+void stats_adjust_crop_count(crop_data *cp, int amount);
+void stats_adjust_sector_count(sector_data *sect, int amount);
 void write_room_to_file(FILE *fl, room_data *room);
 
 // locals
@@ -315,7 +318,7 @@ room_data *create_room(void) {
 	}
 	
 	// make room!
-	CREATE(room, room_data, 1);
+	CREATE_SLAB(room, room_data, SLAB_ROOM);
 	init_room(room, vnum);
 	add_room_to_world_tables(room);
 	
@@ -347,7 +350,7 @@ void delete_room(room_data *room, bool check_exits) {
 
 	struct room_direction_data *ex, *next_ex, *temp;
 	struct room_extra_data *room_ex, *next_room_ex;
-	struct empire_territory_data *ter, *next_ter;
+	struct empire_territory_data *ter;
 	struct empire_city_data *city, *next_city;
 	room_data *rm_iter, *next_rm, *home;
 	vehicle_data *veh, *next_veh;
@@ -441,15 +444,21 @@ void delete_room(room_data *room, bool check_exits) {
 	
 	// free some crap
 	decustomize_room(room);
+	for (iter = 0; iter < NUM_SIMPLE_DIRS; ++iter) {
+		if (room->map_icon[iter]) {
+			free(room->map_icon[iter]);
+		}
+	}
 	while ((dep = ROOM_DEPLETION(room))) {
 		ROOM_DEPLETION(room) = dep->next;
 		free(dep);
 	}
 	while ((track = ROOM_TRACKS(room))) {
 		ROOM_TRACKS(room) = track->next;
-		free(track);
+		FREE_SLAB(SLAB_TRACK, track);
 	}
 	if (COMPLEX_DATA(room)) {
+		set_room_home(room, NULL);	// leaves its home's interior list
 		free_complex_data(COMPLEX_DATA(room));
 		COMPLEX_DATA(room) = NULL;
 	}
@@ -471,7 +480,7 @@ void delete_room(room_data *room, bool check_exits) {
 	}
 	while ((af = ROOM_AFFECTS(room))) {
 		ROOM_AFFECTS(room) = af->next;
-		free(af);
+		FREE_SLAB(SLAB_AFFECT, af);
 	}
 	HASH_ITER(hh, room->extra_data, room_ex, next_room_ex) {
 		HASH_DEL(room->extra_data, room_ex);
@@ -490,7 +499,7 @@ void delete_room(room_data *room, bool check_exits) {
 				if (COMPLEX_DATA(rm_iter)->home_room == room) {
 					// this was contained in the deleted room... it should probably have been deleted, too,
 					// but marking it as no home_room will trigger an auto-delete later
-					COMPLEX_DATA(rm_iter)->home_room = NULL;
+					set_room_home(rm_iter, NULL);
 				}
 			
 				// delete exits
@@ -519,7 +528,7 @@ void delete_room(room_data *room, bool check_exits) {
 				if (COMPLEX_DATA(rm_iter)->home_room == room) {
 					// this was contained in the deleted room... it should probably have been deleted, too,
 					// but marking it as no home_room will trigger an auto-delete later
-					COMPLEX_DATA(rm_iter)->home_room = NULL;
+					set_room_home(rm_iter, NULL);
 				}
 			}
 		}
@@ -545,12 +554,8 @@ void delete_room(room_data *room, bool check_exits) {
 	// update empires
 	HASH_ITER(hh, empire_table, emp, next_emp) {
 		// update empire territory
-		for (ter = EMPIRE_TERRITORY_LIST(emp); ter; ter = next_ter) {
-			next_ter = ter->next;
-			
-			if (ter->room == room) {
-				delete_territory_entry(emp, ter);
-			}
+		if ((ter = find_territory_entry(emp, room))) {
+			delete_territory_entry(emp, ter);
 		}
 		
 		// update all empire cities
@@ -569,10 +574,8 @@ void delete_room(room_data *room, bool check_exits) {
 	}
 	
 	// free the room
-	free(room);
-		
-	// maybe
-	// world_is_sorted = FALSE;
+	FREE_SLAB(SLAB_ROOM, room);
+	
 	need_world_index = TRUE;
 }
 
@@ -746,15 +749,22 @@ void untrench_room(room_data *room) {
 * @param crop_data *cp The crop to set.
 */
 void set_crop_type(room_data *room, crop_data *cp) {
+	struct map_data *map;
+	
 	if (!room) {
 		return;
 	}
 	
 	ROOM_CROP(room) = cp;
 	if (GET_ROOM_VNUM(room) < MAP_SIZE) {
-		world_map[FLAT_X_COORD(room)][FLAT_Y_COORD(room)].crop_type = cp;
+		map = &(world_map[FLAT_X_COORD(room)][FLAT_Y_COORD(room)]);
+		stats_adjust_crop_count(map->crop_type, -1);
+		stats_adjust_crop_count(cp, 1);
+		map->crop_type = cp;
 		world_map_needs_save = TRUE;
 	}
+	clear_map_icon_cache(room, NULL);
+	schedule_room_chores(room);
 }
 
 
@@ -765,10 +775,8 @@ void set_crop_type(room_data *room, crop_data *cp) {
 * Save a fresh index file for the world.
 */
 void save_world_index(void) {
+	struct world_block_data *wbd, *next_wbd;
 	char filename[64], tempfile[64];
-	room_data *iter, *next_iter;
-	room_vnum vnum;
-	int this, last;
 	FILE *fl;
 	
 	// we only need this if the size of the world changed
@@ -776,8 +784,6 @@ void save_world_index(void) {
 		return;
 	}
 	
-	sort_world_table();
-	
 	sprintf(filename, "%s%s", WLD_PREFIX, INDEX_FILE);
 	strcpy(tempfile, filename);
 	strcat(tempfile, TEMP_SUFFIX);
@@ -787,14 +793,10 @@ void save_world_index(void) {
 		return;
 	}
 	
-	last = -1;
-	HASH_ITER(hh, world_table, iter, next_iter) {
-		vnum = GET_ROOM_VNUM(iter);
-		this = GET_WORLD_BLOCK(vnum);
-		
-		if (this != last) {
-			fprintf(fl, "%d%s\n", this, WLD_SUFFIX);
-			last = this;
+	// world_block_table is kept in block order
+	HASH_ITER(hh, world_block_table, wbd, next_wbd) {
+		if (wbd->rooms) {
+			fprintf(fl, "%d%s\n", wbd->block, WLD_SUFFIX);
 		}
 	}
 	
@@ -813,38 +815,26 @@ void save_world_index(void) {
 void save_whole_world(void) {
 	void save_instances();
 	
-	room_data *iter, *next_iter;
-	room_vnum vnum;
-	int block, last;
-	FILE *fl = NULL;
-	
-	last = -1;
-	
-	// must sort first
-	sort_world_table();
+	struct world_block_data *wbd, *next_wbd;
+	room_data *iter;
+	FILE *fl;
 	
-	HASH_ITER(hh, world_table, iter, next_iter) {
-		vnum = GET_ROOM_VNUM(iter);
-		block = GET_WORLD_BLOCK(vnum);
+	// world_block_table is kept in block order, and each block in vnum order
+	HASH_ITER(hh, world_block_table, wbd, next_wbd) {
+		if (!wbd->rooms) {
+			continue;
+		}
+		
+		fl = open_world_file(wbd->block);
 		
-		if (block != last || !fl) {
-			if (fl) {
-				save_and_close_world_file(fl, last);
-				fl = NULL;
+		for (iter = wbd->rooms; iter; iter = iter->next_in_block) {
+			// only save a room at all if it couldn't be unloaded
+			if (!CAN_UNLOAD_MAP_ROOM(iter)) {
+				write_room_to_file(fl, iter);
 			}
-			fl = open_world_file(block);
-			last = block;
 		}
 		
-		// only save a room at all if it couldn't be unloaded
-		if (!CAN_UNLOAD_MAP_ROOM(iter)) {
-			write_room_to_file(fl, iter);
-		}
-	}
-	
-	// cleanup
-	if (fl) {
-		save_and_close_world_file(fl, last);
+		save_and_close_world_file(fl, wbd->block);
 	}
 	
 	// ensure this
@@ -854,6 +844,41 @@ void save_whole_world(void) {
 }
 
 
+/**
+* Unloads some of the map rooms that aren't doing anything, as part of
+* update_world().
+*
+* @param room_data *room A room in the current update group.
+*/
+static void unload_idle_map_room(room_data *room) {
+	if (CAN_UNLOAD_MAP_ROOM(room) && !number(0, 4)) {
+		delete_room(room, FALSE);	// no need to check exits
+	}
+}
+
+
+/**
+* Runs the 30-second updates on one room from the current update group, as
+* part of update_world(). Only rooms in the block update lists get here.
+*
+* @param room_data *room A room in the current update group.
+*/
+static void update_world_room(room_data *room) {
+	// reset non-adventures (adventures reset themselves)
+	if (!IS_ADVENTURE_ROOM(room)) {
+		reset_wtrigger(room);
+	}
+	
+	// type-specific updates
+	if (room_has_function_and_city_ok(room, FNC_TAVERN)) {
+		update_tavern(room);
+	}
+	if (ROOM_SECT_FLAGGED(room, SECTF_HAS_CROP_DATA) && get_room_extra_data(room, ROOM_EXTRA_SEED_TIME)) {
+		grow_crop(room);
+	}
+}
+
+
 /**
 * Handles non-adventure reset triggers and other periodicals, on part of the
 * world every 30 seconds. The world is only actually saved every 30 minutes --
@@ -861,9 +886,6 @@ void save_whole_world(void) {
 */
 void update_world(void) {
 	static int last_save_group = -1;
-
-	room_data *iter, *next_iter;
-	bool deleted = FALSE;
 	
 	// update save group
 	++last_save_group;
@@ -871,40 +893,11 @@ void update_world(void) {
 		last_save_group = 0;
 	}
 	
-	HASH_ITER(hh, world_table, iter, next_iter) {
-		// only do certain blocks
-		if ((GET_WORLD_BLOCK(GET_ROOM_VNUM(iter)) % NUM_WORLD_BLOCK_UPDATES) != last_save_group) {
-			continue;
-		}
-		
-		// skip unload-able map rooms COMPLETELY
-		if (CAN_UNLOAD_MAP_ROOM(iter)) {
-			// unload it while we're here?
-			if (!number(0, 4)) {
-				delete_room(iter, FALSE);
-				// deleted = TRUE;	// no need to check exits?
-			}
-		}
-		else {
-			// reset non-adventures (adventures reset themselves)
-			if (!IS_ADVENTURE_ROOM(iter)) {
-				reset_wtrigger(iter);
-			}
-			
-			// type-specific updates
-			if (room_has_function_and_city_ok(iter, FNC_TAVERN)) {
-				update_tavern(iter);
-			}
-			if (ROOM_SECT_FLAGGED(iter, SECTF_HAS_CROP_DATA) && get_room_extra_data(iter, ROOM_EXTRA_SEED_TIME)) {
-				grow_crop(iter);
-			}
-		}
-	}
+	// unload-able map rooms are skipped COMPLETELY, but may be unloaded here
+	run_room_updates(last_save_group, TRUE, unload_idle_map_room);
 	
-	// not currently bothering with this	
-	if (deleted) {
-		check_all_exits();
-	}
+	// only rooms with resets, taverns, crops, etc
+	run_room_updates(last_save_group, FALSE, update_world_room);
 }
 
 
@@ -1186,6 +1179,7 @@ void naturalize_newbie_islands(void) {
 				set_crop_type(room, get_potential_crop_for_location(room));
 			}
 			else {
+				stats_adjust_crop_count(map->crop_type, -1);
 				map->crop_type = NULL;
 			}
 		}
@@ -1350,6 +1344,7 @@ struct empire_city_data *create_city_entry(empire_data *emp, char *name, room_da
 	city->name = str_dup(name);
 	city->location = location;
 	city->type = type;
+	clear_map_icon_cache(location, NULL);
 
 	city->population = 0;
 	city->military = 0;
@@ -1526,7 +1521,8 @@ void reset_one_room(room_data *room) {
 
 
 /**
-* Resets all rooms that have reset commands waiting.
+* Resets all rooms that have reset commands waiting, and builds the initial
+* periodic-update lists for the world blocks.
 */
 void startup_room_reset(void) {
 	room_data *room, *next_room;
@@ -1535,6 +1531,7 @@ void startup_room_reset(void) {
 		if (room->reset_commands) {
 			reset_one_room(room);
 		}
+		schedule_room_updates(room);
 	}
 }
 
@@ -1596,6 +1593,7 @@ void perform_change_base_sect(room_data *loc, struct map_data *map, sector_data
 		map->base_sector = sect;
 		world_map_needs_save = TRUE;
 	}
+	clear_map_icon_cache(loc, map);
 	
 	// old index
 	if (old_sect) {	// does not exist at first instantiation/set
@@ -1661,6 +1659,7 @@ void perform_change_sect(room_data *loc, struct map_data *map, sector_data *sect
 		map->sector_type = sect;
 		world_map_needs_save = TRUE;
 	}
+	clear_map_icon_cache(loc, map);
 	
 	// old index
 	if (old_sect) {	// does not exist at first instantiation/set
@@ -1671,6 +1670,7 @@ void perform_change_sect(room_data *loc, struct map_data *map, sector_data *sect
 				last_evo_tile = map->next_in_sect;
 			}
 			LL_DELETE2(idx->sect_rooms, map, next_in_sect);
+			stats_adjust_sector_count(old_sect, -1);
 		}
 	}
 	
@@ -1679,6 +1679,12 @@ void perform_change_sect(room_data *loc, struct map_data *map, sector_data *sect
 	++idx->sect_count;
 	if (map) {
 		LL_PREPEND2(idx->sect_rooms, map, next_in_sect);
+		stats_adjust_sector_count(sect, 1);
+	}
+	
+	// new sector may need periodic updates (trenches, crops)
+	if (loc) {
+		schedule_room_updates(loc);
 	}
 	
 	// check for territory updates
@@ -1711,6 +1717,8 @@ void perform_change_sect(room_data *loc, struct map_data *map, sector_data *sect
 				create_territory_entry(ROOM_OWNER(loc), loc);
 			}
 		}
+		
+		schedule_room_chores(loc);
 	}
 }
 
@@ -1809,9 +1817,12 @@ void clear_empire_techs(empire_data *emp) {
 * @return struct empire_territory_data* The new entry
 */
 struct empire_territory_data *create_territory_entry(empire_data *emp, room_data *room) {
+	void schedule_territory_chores(empire_data *emp, struct empire_territory_data *ter);
+	
 	struct empire_territory_data *ter;
 	
 	CREATE(ter, struct empire_territory_data, 1);
+	ter->vnum = GET_ROOM_VNUM(room);
 	ter->room = room;
 	ter->population_timer = config_get_int("building_population_timer");
 	ter->npcs = NULL;
@@ -1819,6 +1830,10 @@ struct empire_territory_data *create_territory_entry(empire_data *emp, room_data
 	
 	// put it at the end
 	LL_APPEND(EMPIRE_TERRITORY_LIST(emp), ter);
+	HASH_ADD_INT(EMPIRE_TERRITORY_HASH(emp), vnum, ter);
+	
+	// and on any chore worklists it qualifies for
+	schedule_territory_chores(emp, ter);
 	
 	return ter;
 }
@@ -1832,17 +1847,20 @@ struct empire_territory_data *create_territory_entry(empire_data *emp, room_data
 */
 void delete_territory_entry(empire_data *emp, struct empire_territory_data *ter) {
 	void delete_room_npcs(room_data *room, struct empire_territory_data *ter);
-	extern struct empire_territory_data *global_next_territory_entry;
+	void delete_territory_npc(struct empire_territory_data *ter, struct empire_npc_data *npc);
+	void remove_territory_chores(empire_data *emp, struct empire_territory_data *ter);
 	
-	// prevent loss
-	if (ter == global_next_territory_entry) {
-		global_next_territory_entry = ter->next;
-	}
-
 	delete_room_npcs(NULL, ter);
-	ter->npcs = NULL;
+	
+	// anything left over (if the room had no owner)
+	while (ter->npcs) {
+		delete_territory_npc(ter, ter->npcs);
+	}
+	
+	remove_territory_chores(emp, ter);
 	
 	LL_DELETE(EMPIRE_TERRITORY_LIST(emp), ter);
+	HASH_DEL(EMPIRE_TERRITORY_HASH(emp), ter);
 	free(ter);
 }
 
@@ -1855,6 +1873,8 @@ void delete_territory_entry(empire_data *emp, struct empire_territory_data *ter)
 * @param bool check_tech If TRUE, also does techs (you should almost never do this)
 */
 void read_empire_territory(empire_data *emp, bool check_tech) {
+	void add_npc_to_worker_cells(empire_data *emp, struct empire_npc_data *npc);
+	void schedule_territory_chores(empire_data *emp, struct empire_territory_data *ter);
 	void read_vault(empire_data *emp);
 	
 	struct empire_territory_data *ter, *next_ter;
@@ -1923,6 +1943,12 @@ void read_empire_territory(empire_data *emp, bool check_tech) {
 				
 				// mark it added/found
 				ter->marked = TRUE;
+				schedule_territory_chores(e, ter);
+				
+				// homes may have moved (or been loaded before their vehicles)
+				for (npc = ter->npcs; npc; npc = npc->next) {
+					add_npc_to_worker_cells(e, npc);
+				}
 				
 				if (IS_COMPLETE(iter)) {
 					if (!GET_ROOM_VEHICLE(iter)) {
@@ -2107,14 +2133,14 @@ static void evolve_one_map_tile(struct map_data *tile) {
 	
 	if (become == NOTHING && (evo = get_evolution_by_type(tile->sector_type, EVO_NEAR_SECTOR))) {
 		room = room ? room : real_room(tile->vnum);
-		if (find_sect_within_distance_from_room(room, evo->value, config_get_int("nearby_sector_distance"))) {
+		if (find_sect_within_distance_from_room(room, evo->value, CONFIG_INT(CONF_NEARBY_SECTOR_DISTANCE))) {
 			become = evo->becomes;
 		}
 	}
 	
 	if (become == NOTHING && (evo = get_evolution_by_type(tile->sector_type, EVO_NOT_NEAR_SECTOR))) {
 		room = room ? room : real_room(tile->vnum);
-		if (!find_sect_within_distance_from_room(room, evo->value, config_get_int("nearby_sector_distance"))) {
+		if (!find_sect_within_distance_from_room(room, evo->value, CONFIG_INT(CONF_NEARBY_SECTOR_DISTANCE))) {
 			become = evo->becomes;
 		}
 	}
@@ -2353,7 +2379,7 @@ room_data *load_map_room(room_vnum vnum) {
 	// find map data
 	map = &(world_map[MAP_X_COORD(vnum)][MAP_Y_COORD(vnum)]);
 	
-	CREATE(room, room_data, 1);
+	CREATE_SLAB(room, room_data, SLAB_ROOM);
 	room->vnum = vnum;
 	add_room_to_world_tables(room);
 	
@@ -2363,6 +2389,7 @@ room_data *load_map_room(room_vnum vnum) {
 	SET_ISLAND_ID(room, map->island);
 	
 	ROOM_CROP(room) = map->crop_type;
+	schedule_room_updates(room);
 	
 	// only if saveable
 	if (!CAN_UNLOAD_MAP_ROOM(room)) {
@@ -2390,6 +2417,7 @@ void decustomize_room(room_data *room) {
 	if (ROOM_CUSTOM_ICON(room)) {
 		free(ROOM_CUSTOM_ICON(room));
 		ROOM_CUSTOM_ICON(room) = NULL;
+		clear_map_icon_cache(room, NULL);
 	}
 }
 
@@ -2730,19 +2758,48 @@ void update_tavern(room_data *room) {
 //// MAP OUTPUT //////////////////////////////////////////////////////////////
 
 /**
-* Writes the data files used to generate graphical maps.
+* Finds the political map color for a banner: the first color in
+* banner_to_mapout_token that appears in it. This is cached on the empire
+* (EMPIRE_MAPOUT_TOKEN) whenever the banner changes.
+*
+* @param char *banner The banner color code.
+* @return char The mapout token, or '?' if no color matched.
 */
-void output_map_to_file(void) {
+char get_banner_mapout_token(char *banner) {
 	extern const char banner_to_mapout_token[][2];
+	int num;
+	
+	if (!banner) {
+		return '?';
+	}
+	
+	for (num = 0; banner_to_mapout_token[num][0] != '\n'; ++num) {
+		if (strchr(banner, banner_to_mapout_token[num][0])) {
+			return banner_to_mapout_token[num][1];
+		}
+	}
+	
+	return '?';
+}
+
+
+/**
+* Writes the data files used to generate graphical maps. Each row is built in
+* a buffer and written at once; tiles come straight from the world_map.
+*/
+void output_map_to_file(void) {
 	extern const char mapout_color_tokens[];
 	
+	char geo_row[MAP_WIDTH + 1], pol_row[MAP_WIDTH + 1];
 	FILE *out, *pol, *cit;
-	int num, color = 0, x, y;
+	int x, y;
 	struct empire_city_data *city;
+	struct map_data *map;
 	room_data *room;
 	empire_data *emp, *next_emp;
 	sector_data *ocean = sector_proto(BASIC_OCEAN);
 	sector_data *sect;
+	bool chameleon;
 	
 	// basic ocean sector is required
 	if (!ocean) {
@@ -2750,8 +2807,6 @@ void output_map_to_file(void) {
 		return;
 	}
 	
-	sort_world_table();
-
 	// NORMAL MAP
 	if (!(out = fopen(GEOGRAPHIC_MAP_FILE TEMP_SUFFIX, "w"))) {
 		log("SYSERR: Unable to open file '%s' for writing", GEOGRAPHIC_MAP_FILE TEMP_SUFFIX);
@@ -2761,56 +2816,47 @@ void output_map_to_file(void) {
 	// POLITICAL MAP
 	if (!(pol = fopen(POLITICAL_MAP_FILE TEMP_SUFFIX, "w"))) {
 		log("SYSERR: Unable to open file '%s' for writing", POLITICAL_MAP_FILE TEMP_SUFFIX);
+		fclose(out);
 		return;
 	}
 	
 	fprintf(out, "%dx%d\n", MAP_WIDTH, MAP_HEIGHT);
 	fprintf(pol, "%dx%d\n", MAP_WIDTH, MAP_HEIGHT);
 	
+	geo_row[MAP_WIDTH] = '\n';
+	pol_row[MAP_WIDTH] = '\n';
+	
 	for (y = 0; y < MAP_HEIGHT; ++y) {
 		for (x = 0; x < MAP_WIDTH; ++x) {
-			// load room only if in memory
-			room = real_real_room(world_map[x][y].vnum);
-			sect = world_map[x][y].sector_type;
-			if (room && ROOM_AFF_FLAGGED(room, ROOM_AFF_CHAMELEON) && IS_COMPLETE(room)) {
-				sect = world_map[x][y].base_sector;
-			}
+			map = &world_map[x][y];
+			room = map->room;	// only if in memory
+			chameleon = (room && ROOM_AFF_FLAGGED(room, ROOM_AFF_CHAMELEON) && IS_COMPLETE(room));
+			sect = chameleon ? map->base_sector : map->sector_type;
 			
 			// normal map output
-			if (SECT_FLAGGED(sect, SECTF_HAS_CROP_DATA) && world_map[x][y].crop_type) {
-				fprintf(out, "%c", mapout_color_tokens[GET_CROP_MAPOUT(world_map[x][y].crop_type)]);
+			if (SECT_FLAGGED(sect, SECTF_HAS_CROP_DATA) && map->crop_type) {
+				geo_row[x] = mapout_color_tokens[GET_CROP_MAPOUT(map->crop_type)];
 			}
 			else {
-				fprintf(out, "%c", mapout_color_tokens[GET_SECT_MAPOUT(sect)]);
+				geo_row[x] = mapout_color_tokens[GET_SECT_MAPOUT(sect)];
 			}
-		
-			// political output
-			if (room && (emp = ROOM_OWNER(room)) && (!ROOM_AFF_FLAGGED(room, ROOM_AFF_CHAMELEON) || !IS_COMPLETE(room))) {
-				// find the first color in banner_to_mapout_token that is in the banner
-				color = -1;
-				for (num = 0; banner_to_mapout_token[0][0] != '\n'; ++num) {
-					if (strchr(EMPIRE_BANNER(emp), banner_to_mapout_token[num][0])) {
-						color = num;
-						break;
-					}
-				}
 			
-				fprintf(pol, "%c", color != -1 ? banner_to_mapout_token[color][1] : '?');
+			// political output
+			if (room && (emp = ROOM_OWNER(room)) && !chameleon) {
+				pol_row[x] = EMPIRE_MAPOUT_TOKEN(emp);
 			}
-			else {
+			else if (SECT_FLAGGED(sect, SECTF_SHOW_ON_POLITICAL_MAPOUT)) {
 				// no owner -- only some sects get printed
-				if (SECT_FLAGGED(sect, SECTF_SHOW_ON_POLITICAL_MAPOUT)) {
-					fprintf(pol, "%c", mapout_color_tokens[GET_SECT_MAPOUT(sect)]);
-				}
-				else {
-					fprintf(pol, "?");
-				}
+				pol_row[x] = mapout_color_tokens[GET_SECT_MAPOUT(sect)];
+			}
+			else {
+				pol_row[x] = '?';
 			}
 		}
 		
 		// end of row
-		fprintf(out, "\n");
-		fprintf(pol, "\n");	
+		fwrite(geo_row, sizeof(char), MAP_WIDTH + 1, out);
+		fwrite(pol_row, sizeof(char), MAP_WIDTH + 1, pol);
 	}
 
 	fclose(out);
@@ -2972,6 +3018,7 @@ void load_world_map_from_file(void) {
 			world_map[x][y].base_sector = NULL;
 			world_map[x][y].natural_sector = NULL;
 			world_map[x][y].crop_type = NULL;
+			world_map[x][y].room = NULL;
 			world_map[x][y].next = NULL;
 		}
 	}
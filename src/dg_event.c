@@ -151,7 +151,7 @@ struct q_element *queue_enq(struct queue *q, void *data, long key) {
 	struct q_element *qe, *i;
 	int bucket;
 
-	CREATE(qe, struct q_element, 1);
+	CREATE_SLAB(qe, struct q_element, SLAB_QUEUE_ELEMENT);
 	qe->data = data;
 	qe->key = key;
 
@@ -207,7 +207,7 @@ void queue_deq(struct queue *q, struct q_element *qe) {
 	else
 		qe->next->prev = qe->prev;
 
-	free(qe);
+	FREE_SLAB(SLAB_QUEUE_ELEMENT, qe);
 }
 
 
@@ -260,7 +260,7 @@ void queue_free(struct queue *q) {
 	for (i = 0; i < NUM_EVENT_QUEUES; i++)
 		for (qe = q->head[i]; qe; qe = next_qe) {
 			next_qe = qe->next;
-			free(qe);
+			FREE_SLAB(SLAB_QUEUE_ELEMENT, qe);
 		}
 
 	free(q);
@@ -61,6 +61,7 @@ struct script_data *create_script_data(void *attach_to, int type) {
 			if (!(scr = SCRIPT(room))) {
 				CREATE(scr, struct script_data, 1);
 				SCRIPT(room) = scr;
+				schedule_room_updates(room);
 			}
 			type = WLD_TRIGGER;	// override other types
 			break;
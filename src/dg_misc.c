@@ -55,7 +55,6 @@ room_data *do_dg_add_room_dir(room_data *from, int dir, bld_data *bld) {
 	void add_room_to_vehicle(room_data *room, vehicle_data *veh);
 	extern struct empire_territory_data *create_territory_entry(empire_data *emp, room_data *room);
 	extern room_data *create_room();
-	void sort_world_table();
 	
 	room_data *home = HOME_ROOM(from), *new;
 	
@@ -66,7 +65,7 @@ room_data *do_dg_add_room_dir(room_data *from, int dir, bld_data *bld) {
 		attach_building_to_room(bld, new, TRUE);
 	}
 
-	COMPLEX_DATA(new)->home_room = home;
+	set_room_home(new, home);
 	COMPLEX_DATA(home)->inside_rooms++;
 	
 	if (GET_ROOM_VEHICLE(from)) {
@@ -81,9 +80,6 @@ room_data *do_dg_add_room_dir(room_data *from, int dir, bld_data *bld) {
 		perform_claim_room(new, ROOM_OWNER(home));
 	}
 	
-	// sort now just in case
-	sort_world_table();
-	
 	return new;
 }
 
@@ -1956,6 +1956,9 @@ ACMD(do_mtransform) {
 
 		/* put the mob in the same room as ch so extract will work */
 		char_to_room(m, IN_ROOM(ch));
+		
+		// the copy would share m's keyword refs, which extract_char(m) frees; re-index below
+		unindex_char_keywords(ch);
 
 		memcpy(&tmpmob, m, sizeof(*m));
 		tmpmob.script_id = ch->script_id;
@@ -1981,7 +1984,11 @@ ACMD(do_mtransform) {
 		IS_CARRYING_N(&tmpmob) = IS_CARRYING_N(ch);
 		FIGHTING(&tmpmob) = FIGHTING(ch);
 		HUNTING(&tmpmob) = HUNTING(ch);
+		tmpmob.list_seq = ch->list_seq;
+		tmpmob.keyword_refs = NULL;
+		tmpmob.keyword_index_src = NULL;
 		memcpy(ch, &tmpmob, sizeof(*ch));
+		index_char_keywords(ch);
 
 		for (pos = 0; pos < NUM_WEARS; pos++) {
 			if (obj[pos])
@@ -527,7 +527,7 @@ OCMD(do_otimer) {
 	else if (!isdigit(*arg)) 
 		obj_log(obj, "otimer: bad argument");
 	else
-		GET_OBJ_TIMER(obj) = atoi(arg);
+		SET_OBJ_TIMER(obj, atoi(arg));
 }
 
 
@@ -563,6 +563,15 @@ OCMD(do_otransform) {
 			unequip_char(obj->worn_by, pos);
 		}
 
+		// take both out of the timer wheel and autostore queue before copying; obj is re-added below
+		cancel_obj_timer(o);
+		remove_from_autostore_queue(o);
+		cancel_obj_timer(obj);
+		remove_from_autostore_queue(obj);
+		
+		// same for the keyword index: the copy would share o's refs, which extract_obj(o) frees
+		unindex_obj_keywords(obj);
+
 		/* move new obj info over to old object and delete new obj */
 		memcpy(&tmpobj, o, sizeof(*o));
 		tmpobj.in_room = IN_ROOM(obj);
@@ -582,7 +591,14 @@ OCMD(do_otransform) {
 		tmpobj.script = obj->script;
 		tmpobj.next_content = obj->next_content;
 		tmpobj.next = obj->next;
+		tmpobj.list_seq = obj->list_seq;
+		tmpobj.keyword_refs = NULL;
+		tmpobj.keyword_index_src = NULL;
 		memcpy(obj, &tmpobj, sizeof(*obj));
+		
+		schedule_obj_timer(obj);
+		add_to_autostore_queue(obj);
+		index_obj_keywords(obj);
 
 		if (wearer) {
 			equip_char(wearer, obj, pos);
@@ -292,6 +292,7 @@ vehicle_data *find_vehicle(int n) {
 
 /* search the entire world for a char, and return a pointer */
 char_data *get_char(char *name) {
+	struct keyword_index_ref *kwi;
 	char_data *i;
 
 	if (*name == UID_CHAR) {
@@ -301,7 +302,7 @@ char_data *get_char(char *name) {
 			return i;
 	}
 	else {
-		for (i = character_list; i; i = i->next)
+		for (i = first_char_by_keyword(name, &kwi); i; i = next_char_by_keyword(i, &kwi))
 			if (isname(name, i->player.name) && valid_dg_target(i, DG_ALLOW_GODS))
 				return i;
 	}
@@ -498,12 +499,13 @@ obj_data *get_obj_near_vehicle(vehicle_data *veh, char *name) {
 
 /* returns the object in the world with name name, or NULL if not found */
 obj_data *get_obj(char *name)  {
+	struct keyword_index_ref *kwi;
 	obj_data *obj;
 
 	if (*name == UID_CHAR)
 		return find_obj(atoi(name + 1), TRUE);
 	else {
-		for (obj = object_list; obj; obj = obj->next)
+		for (obj = first_obj_by_keyword(name, &kwi); obj; obj = next_obj_by_keyword(obj, &kwi))
 			if (isname(name, obj->name))
 				return obj;
 	}
@@ -588,13 +590,14 @@ room_data *get_room_by_script(int type, void *go) {
 * @return vehicle_data* The found vehicle, or NULL if none.
 */
 vehicle_data *get_vehicle(char *name) {
+	struct keyword_index_ref *kwi;
 	vehicle_data *veh;
 	
 	if (*name == UID_CHAR) {
 		return find_vehicle(atoi(name + 1));
 	}
 	else {
-		LL_FOREACH(vehicle_list, veh) {
+		for (veh = first_vehicle_by_keyword(name, &kwi); veh; veh = next_vehicle_by_keyword(veh, &kwi)) {
 			if (isname(name, VEH_KEYWORDS(veh))) {
 				return veh;
 			}
@@ -610,6 +613,7 @@ vehicle_data *get_vehicle(char *name) {
 * or NULL if none found.  Starts searching with the person owing the object
 */
 char_data *get_char_by_obj(obj_data *obj, char *name) {
+	struct keyword_index_ref *kwi;
 	char_data *ch;
 
 	if (*name == UID_CHAR) {
@@ -625,7 +629,7 @@ char_data *get_char_by_obj(obj_data *obj, char *name) {
 		if (obj->worn_by && isname(name, obj->worn_by->player.name) && valid_dg_target(obj->worn_by, DG_ALLOW_GODS))
 			return obj->worn_by;
 
-		for (ch = character_list; ch; ch = ch->next)
+		for (ch = first_char_by_keyword(name, &kwi); ch; ch = next_char_by_keyword(ch, &kwi))
 			if (isname(name, ch->player.name) && valid_dg_target(ch, DG_ALLOW_GODS))
 				return ch;
 	}
@@ -642,6 +646,7 @@ char_data *get_char_by_obj(obj_data *obj, char *name) {
 * @return char_data* The found character, or NULL.
 */
 char_data *get_char_by_vehicle(vehicle_data *veh, char *name) {
+	struct keyword_index_ref *kwi;
 	char_data *ch;
 
 	if (*name == UID_CHAR) {
@@ -671,7 +676,7 @@ char_data *get_char_by_vehicle(vehicle_data *veh, char *name) {
 		}
 		
 		// try whole world
-		LL_FOREACH(character_list, ch) {
+		for (ch = first_char_by_keyword(name, &kwi); ch; ch = next_char_by_keyword(ch, &kwi)) {
 			if (isname(name, GET_PC_NAME(ch)) && valid_dg_target(ch, DG_ALLOW_GODS)) {
 				return ch;
 			}
@@ -687,6 +692,7 @@ char_data *get_char_by_vehicle(vehicle_data *veh, char *name) {
 * or NULL if none found.  Starts searching in room room first
 */
 char_data *get_char_by_room(room_data *room, char *name) {
+	struct keyword_index_ref *kwi;
 	char_data *ch;
 
 	if (*name == UID_CHAR) {
@@ -700,7 +706,7 @@ char_data *get_char_by_room(room_data *room, char *name) {
 			if (isname(name, ch->player.name) && valid_dg_target(ch, DG_ALLOW_GODS))
 				return ch;
 
-		for (ch = character_list; ch; ch = ch->next)
+		for (ch = first_char_by_keyword(name, &kwi); ch; ch = next_char_by_keyword(ch, &kwi))
 			if (isname(name, ch->player.name) && valid_dg_target(ch, DG_ALLOW_GODS))
 				return ch;
 	}
@@ -788,6 +794,7 @@ obj_data *get_obj_in_room(room_data *room, char *name) {
 
 /* returns obj with name - searches room, then world */
 obj_data *get_obj_by_room(room_data *room, char *name) {
+	struct keyword_index_ref *kwi;
 	obj_data *obj;
 
 	if (*name == UID_CHAR) 
@@ -797,7 +804,7 @@ obj_data *get_obj_by_room(room_data *room, char *name) {
 		if (isname(name, obj->name))
 			return obj;
 
-	for (obj = object_list; obj; obj = obj->next)
+	for (obj = first_obj_by_keyword(name, &kwi); obj; obj = next_obj_by_keyword(obj, &kwi))
 		if (isname(name, obj->name))
 			return obj;
 
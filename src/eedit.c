@@ -273,6 +273,7 @@ ACMD(do_eedit) {
 		
 		// always save
 		save_empire(emp);
+		++EMPIRE_MSDP_VERSION(emp);
 	}
 }
 
@@ -327,6 +328,7 @@ EEDIT(eedit_adjective) {
 
 
 EEDIT(eedit_banner) {
+	extern char get_banner_mapout_token(char *banner);
 	extern char *show_color_codes(char *string);
 	
 	if (!*argument) {
@@ -342,6 +344,7 @@ EEDIT(eedit_banner) {
 		EMPIRE_BANNER(emp) = str_dup(argument);
 		
 		EMPIRE_BANNER_HAS_UNDERLINE(emp) = (strstr(EMPIRE_BANNER(emp), "&u") ? TRUE : FALSE);
+		EMPIRE_MAPOUT_TOKEN(emp) = get_banner_mapout_token(EMPIRE_BANNER(emp));
 
 		log_to_empire(emp, ELOG_ADMIN, "%s has changed the banner color", PERS(ch, ch, TRUE));
 		msg_to_char(ch, "The empire's banner is now: %s%s&0\r\n", EMPIRE_BANNER(emp), show_color_codes(EMPIRE_BANNER(emp)));
@@ -75,8 +75,11 @@ const struct wear_data_type wear_data[NUM_WEARS];
 // external funcs
 void adjust_building_tech(empire_data *emp, room_data *room, bool add);
 void check_delayed_load(char_data *ch);
+void clear_map_icon_cache(room_data *room, struct map_data *map);
 void extract_trigger(trig_data *trig);
 void scale_item_to_level(obj_data *obj, int level);
+void schedule_room_chores(room_data *room);
+void stats_adjust_building_count(bld_data *bdg, int amount);
 
 // locals
 static void add_obj_binding(int idnum, struct obj_binding **list);
@@ -309,7 +312,7 @@ void affect_join(char_data *ch, struct affected_type *af, int flags) {
 	}
 	
 	// affect_to_char seems to duplicate af so we must free it
-	free(af);
+	FREE_SLAB(SLAB_AFFECT, af);
 }
 
 
@@ -521,7 +524,7 @@ void affect_remove(char_data *ch, struct affected_type *af) {
 
 	affect_modify(ch, af->location, af->modifier, af->bitvector, FALSE);
 	REMOVE_FROM_LIST(af, ch->affected, next);
-	free(af);
+	FREE_SLAB(SLAB_AFFECT, af);
 	affect_total(ch);
 }
 
@@ -545,9 +548,13 @@ void affect_remove_room(room_data *room, struct affected_type *af) {
 	REMOVE_BIT(ROOM_AFF_FLAGS(room), af->bitvector);
 	// restore base flags, in case we removed one of them
 	SET_BIT(ROOM_AFF_FLAGS(room), ROOM_BASE_FLAGS(room));
+	
+	if (IS_SET(af->bitvector, ROOM_AFF_NO_FLY | ROOM_AFF_CHAMELEON)) {
+		clear_map_icon_cache(room, NULL);
+	}
 
 	REMOVE_FROM_LIST(af, ROOM_AFFECTS(room), next);
-	free(af);
+	FREE_SLAB(SLAB_AFFECT, af);
 }
 
 
@@ -563,7 +570,7 @@ void affect_remove_room(room_data *room, struct affected_type *af) {
 void affect_to_char(char_data *ch, struct affected_type *af) {
 	struct affected_type *affected_alloc;
 
-	CREATE(affected_alloc, struct affected_type, 1);
+	CREATE_SLAB(affected_alloc, struct affected_type, SLAB_AFFECT);
 
 	*affected_alloc = *af;
 	affected_alloc->next = ch->affected;
@@ -585,13 +592,18 @@ void affect_to_char(char_data *ch, struct affected_type *af) {
 void affect_to_room(room_data *room, struct affected_type *af) {
 	struct affected_type *affected_alloc;
 
-	CREATE(affected_alloc, struct affected_type, 1);
+	CREATE_SLAB(affected_alloc, struct affected_type, SLAB_AFFECT);
 
 	*affected_alloc = *af;
 	affected_alloc->next = ROOM_AFFECTS(room);
 	ROOM_AFFECTS(room) = affected_alloc;
 
 	SET_BIT(ROOM_AFF_FLAGS(room), af->bitvector);
+	schedule_room_updates(room);
+	
+	if (IS_SET(af->bitvector, ROOM_AFF_NO_FLY | ROOM_AFF_CHAMELEON)) {
+		clear_map_icon_cache(room, NULL);
+	}
 }
 
 
@@ -609,14 +621,15 @@ void affect_total(char_data *ch) {
 	int i, iter, level;
 	empire_data *emp = GET_LOYALTY(ch);
 	struct obj_apply *apply;
-	int health, move, mana;
+	int health, move, mana, greatness;
 	
-	int pool_bonus_amount = config_get_int("pool_bonus_amount");
+	int pool_bonus_amount = CONFIG_INT(CONF_POOL_BONUS_AMOUNT);
 	
 	// save these for later -- they shouldn't change during an affect_total
 	health = GET_HEALTH(ch);
 	move = GET_MOVE(ch);
 	mana = GET_MANA(ch);
+	greatness = GET_GREATNESS(ch);
 	level = get_approximate_level(ch);
 	
 	// only update greatness if ch is in a room (playing)
@@ -707,6 +720,10 @@ void affect_total(char_data *ch) {
 	// only update greatness if ch is in a room (playing)
 	if (!IS_NPC(ch) && emp && IN_ROOM(ch)) {
 		EMPIRE_GREATNESS(emp) += GET_GREATNESS(ch);
+		
+		if (GET_GREATNESS(ch) != greatness) {
+			++EMPIRE_MSDP_VERSION(emp);	// territory limit depends on greatness
+		}
 	}
 	
 	// limit this
@@ -724,6 +741,8 @@ void affect_total(char_data *ch) {
 	
 	// this is to prevent weird quirks because GET_MAX_BLOOD is a function
 	GET_MAX_POOL(ch, BLOOD) = GET_MAX_BLOOD(ch);
+	
+	MSDP_DIRTY(ch, MSDP_DIRTY_CHARACTER | MSDP_DIRTY_REGEN | MSDP_DIRTY_AFFECTS | MSDP_DIRTY_COMBAT);
 }
 
 
@@ -790,7 +809,7 @@ bool affected_by_spell_and_apply(char_data *ch, int type, int apply) {
 struct affected_type *create_aff(int type, int duration, int location, int modifier, bitvector_t bitvector, char_data *cast_by) {
 	struct affected_type *af;
 	
-	CREATE(af, struct affected_type, 1);
+	CREATE_SLAB(af, struct affected_type, SLAB_AFFECT);
 	af->type = type;
 	af->cast_by = cast_by ? CAST_BY_ID(cast_by) : 0;
 	af->duration = duration;
@@ -841,6 +860,8 @@ void apply_dot_effect(char_data *ch, sh_int type, sh_int duration, sh_int damage
 		dot->stack = 1;
 		dot->max_stack = max_stack;
 	}
+	
+	MSDP_DIRTY(ch, MSDP_DIRTY_AFFECTS);
 }
 
 
@@ -855,6 +876,8 @@ void dot_remove(char_data *ch, struct over_time_effect_type *dot) {
 
 	REMOVE_FROM_LIST(dot, ch->over_time_effects, next);
 	free(dot);
+	
+	MSDP_DIRTY(ch, MSDP_DIRTY_AFFECTS);
 }
 
 
@@ -982,6 +1005,8 @@ void extract_char_final(char_data *ch) {
 
 	// pc-only frees
 	if (!IS_NPC(ch)) {
+		remove_player_from_name_index(ch);
+
 		// find if someone was switched into this person, and return them
 		if (!ch->desc) {
 			for (t_desc = descriptor_list; t_desc; t_desc = t_desc->next) {
@@ -1018,6 +1043,7 @@ void extract_char_final(char_data *ch) {
 
 	// remove from the room
 	char_from_room(ch);
+	unindex_char_keywords(ch);
 
 	// if this was a switched player, return them back
 	if (ch->desc && ch->desc->original) {
@@ -1198,6 +1224,164 @@ bool match_char_name(char_data *ch, char_data *target, char *name, bitvector_t f
 }
 
 
+/**
+* Finds the player_name_index entry for one exact name word.
+*
+* @param char *name The name word to look up (case-insensitive).
+* @return struct player_name_index* The entry, or NULL if no in-game player uses that word.
+*/
+static struct player_name_index *find_player_name_index(char *name) {
+	char lower[MAX_INPUT_LENGTH];
+	struct player_name_index *index;
+
+	if (!name || !*name) {
+		return NULL;
+	}
+
+	strncpy(lower, name, sizeof(lower) - 1);
+	lower[sizeof(lower) - 1] = '\0';
+	strtolower(lower);
+
+	HASH_FIND_STR(player_name_index, lower, index);
+	return index;
+}
+
+
+/**
+* Adds each word of a namelist to the player_name_index for a player. Words
+* the player is already indexed under are skipped.
+*
+* @param char_data *ch The player.
+* @param const char *namelist A space-separated list of names (may be NULL).
+*/
+static void index_player_name_words(char_data *ch, const char *namelist) {
+	char temp[MAX_STRING_LENGTH], *word;
+	struct player_name_index *index;
+	struct player_name_ref *ref;
+
+	if (!namelist || !*namelist) {
+		return;
+	}
+
+	strncpy(temp, namelist, sizeof(temp) - 1);
+	temp[sizeof(temp) - 1] = '\0';
+	strtolower(temp);
+
+	for (word = strtok(temp, " \t"); word; word = strtok(NULL, " \t")) {
+		HASH_FIND_STR(player_name_index, word, index);
+		if (!index) {
+			CREATE(index, struct player_name_index, 1);
+			index->keyword = str_dup(word);
+			HASH_ADD_KEYPTR(hh, player_name_index, index->keyword, strlen(index->keyword), index);
+		}
+
+		// already indexed under this word?
+		for (ref = GET_NAME_INDEX_REFS(ch); ref; ref = ref->next_for_char) {
+			if (ref->index == index) {
+				break;
+			}
+		}
+		if (ref) {
+			continue;
+		}
+
+		CREATE(ref, struct player_name_ref, 1);
+		ref->ch = ch;
+		ref->index = index;
+		DL_PREPEND(index->refs, ref);
+		ref->next_for_char = GET_NAME_INDEX_REFS(ch);
+		GET_NAME_INDEX_REFS(ch) = ref;
+	}
+}
+
+
+/**
+* Removes all of a player's entries from the player_name_index, and frees
+* any index entries that no longer have players.
+*
+* @param char_data *ch The player.
+*/
+static void unindex_player_name_words(char_data *ch) {
+	struct player_name_ref *ref;
+
+	while ((ref = GET_NAME_INDEX_REFS(ch))) {
+		GET_NAME_INDEX_REFS(ch) = ref->next_for_char;
+		DL_DELETE(ref->index->refs, ref);
+
+		if (!ref->index->refs) {
+			HASH_DEL(player_name_index, ref->index);
+			free(ref->index->keyword);
+			free(ref->index);
+		}
+		free(ref);
+	}
+}
+
+
+/**
+* Adds a player who is entering the game to player_character_list and indexes
+* all the names they can be targeted by.
+*
+* @param char_data *ch The player.
+*/
+void add_player_to_name_index(char_data *ch) {
+	if (IS_NPC(ch)) {
+		return;
+	}
+
+	// prev_plr is only NULL when not in the list (utlist keeps head->prev as the tail)
+	if (!ch->prev_plr) {
+		DL_PREPEND2(player_character_list, ch, prev_plr, next_plr);
+	}
+	update_player_name_index(ch);
+}
+
+
+/**
+* Removes a player who is leaving the game from player_character_list and the
+* name index.
+*
+* @param char_data *ch The player.
+*/
+void remove_player_from_name_index(char_data *ch) {
+	if (IS_NPC(ch)) {
+		return;
+	}
+
+	unindex_player_name_words(ch);
+	if (ch->prev_plr) {
+		DL_DELETE2(player_character_list, ch, prev_plr, next_plr);
+		ch->prev_plr = ch->next_plr = NULL;
+	}
+}
+
+
+/**
+* Re-indexes an in-game player's names. Call this any time a player's name,
+* lastname, morph, or disguise changes. Does nothing for players who are not
+* in the game.
+*
+* @param char_data *ch The player.
+*/
+void update_player_name_index(char_data *ch) {
+	if (IS_NPC(ch) || !ch->prev_plr) {
+		return;
+	}
+
+	unindex_player_name_words(ch);
+	index_char_keywords(ch);
+
+	index_player_name_words(ch, GET_PC_NAME(ch));
+	index_player_name_words(ch, GET_LASTNAME(ch));
+	if (IS_MORPHED(ch)) {
+		index_player_name_words(ch, MORPH_KEYWORDS(GET_MORPH(ch)));
+	}
+	if (IS_DISGUISED(ch)) {
+		index_player_name_words(ch, GET_DISGUISED_NAME(ch));
+	}
+}
+
+
 /**
 * Handles the actual extract of an idle character.
 * 
@@ -1284,6 +1468,11 @@ void char_from_room(char_data *ch) {
 		}
 	}
 
+	// instance counts
+	if (!IS_NPC(ch) && ROOM_INSTANCE(IN_ROOM(ch))) {
+		--ROOM_INSTANCE(IN_ROOM(ch))->player_count;
+	}
+
 	REMOVE_FROM_LIST(ch, ROOM_PEOPLE(IN_ROOM(ch)), next_in_room);
 	IN_ROOM(ch) = NULL;
 	ch->next_in_room = NULL;
@@ -1319,6 +1508,12 @@ void char_to_room(char_data *ch, room_data *room) {
 		ch->next_in_room = ROOM_PEOPLE(room);
 		ROOM_PEOPLE(room) = ch;
 		IN_ROOM(ch) = room;
+		check_char_keyword_index(ch);
+		
+		// instance counts
+		if (!IS_NPC(ch) && ROOM_INSTANCE(room)) {
+			++ROOM_INSTANCE(room)->player_count;
+		}
 
 		// update lights
 		for (pos = 0; pos < NUM_WEARS; pos++) {
@@ -1512,6 +1707,7 @@ char_data *get_char_room_vis(char_data *ch, char *name) {
 * @return char_data *The found character, or NULL.
 */
 char_data *get_char_vis(char_data *ch, char *name, bitvector_t where) {
+	struct keyword_index_ref *kwi;
 	char_data *i, *found = NULL;
 	int j = 0, number;
 	char tmpname[MAX_INPUT_LENGTH];
@@ -1530,7 +1726,7 @@ char_data *get_char_vis(char_data *ch, char *name, bitvector_t where) {
 			return get_player_vis(ch, tmp, where);
 		}
 
-		for (i = character_list; i && (j <= number) && !found; i = i->next) {
+		for (i = first_char_by_keyword(tmp, &kwi); i && (j <= number) && !found; i = next_char_by_keyword(i, &kwi)) {
 			if (IS_SET(where, FIND_NPC_ONLY) && !IS_NPC(i)) {	
 				continue;
 			}
@@ -1549,6 +1745,33 @@ char_data *get_char_vis(char_data *ch, char *name, bitvector_t where) {
 }
 
 
+/**
+* Checks one player as a potential get_player_vis() match.
+*
+* @param char_data *ch The person looking (may be NULL if FIND_CHAR_ROOM is not set).
+* @param char_data *i The player to check.
+* @param char *name The argument string.
+* @param bitvector_t flags FIND_x flags.
+* @return bool TRUE if i matches, FALSE if not.
+*/
+static bool player_vis_match(char_data *ch, char_data *i, char *name, bitvector_t flags) {
+	if (IS_NPC(i)) {
+		return FALSE;
+	}
+	if (IS_SET(flags, FIND_CHAR_ROOM) && !WIZHIDE_OK(ch, i)) {
+		return FALSE;
+	}
+	if (IS_SET(flags, FIND_CHAR_ROOM) && IN_ROOM(i) != IN_ROOM(ch)) {
+		return FALSE;
+	}
+	if (IS_SET(flags, FIND_CHAR_ROOM) && AFF_FLAGGED(i, AFF_NO_TARGET_IN_ROOM)) {
+		return FALSE;
+	}
+	
+	return match_char_name(ch, i, name, (IS_SET(flags, FIND_CHAR_ROOM) ? MATCH_IN_ROOM : 0) | (IS_SET(flags, FIND_NO_DARK | FIND_CHAR_WORLD) ? MATCH_GLOBAL : 0));
+}
+
+
 /**
 * Finds a player.
 *
@@ -1558,23 +1781,24 @@ char_data *get_char_vis(char_data *ch, char *name, bitvector_t where) {
 * @return char_data *The found player, or NULL.
 */
 char_data *get_player_vis(char_data *ch, char *name, bitvector_t flags) {
+	struct player_name_index *index;
+	struct player_name_ref *ref;
 	char_data *i, *found = NULL;
-
-	for (i = character_list; i && !found; i = i->next) {
-		if (IS_NPC(i))
-			continue;
-		if (IS_SET(flags, FIND_CHAR_ROOM) && !WIZHIDE_OK(ch, i)) {
-			continue;
+	
+	// exact name words come straight from the index
+	if ((index = find_player_name_index(name))) {
+		for (ref = index->refs; ref && !found; ref = ref->next) {
+			if (player_vis_match(ch, ref->ch, name, flags)) {
+				found = ref->ch;
+			}
 		}
-		if (IS_SET(flags, FIND_CHAR_ROOM) && IN_ROOM(i) != IN_ROOM(ch))
-			continue;
-		if (IS_SET(flags, FIND_CHAR_ROOM) && AFF_FLAGGED(i, AFF_NO_TARGET_IN_ROOM))
-			continue;
-		if (!match_char_name(ch, i, name, (IS_SET(flags, FIND_CHAR_ROOM) ? MATCH_IN_ROOM : 0) | (IS_SET(flags, FIND_NO_DARK | FIND_CHAR_WORLD) ? MATCH_GLOBAL : 0))) {
-			continue;
+	}
+	
+	// abbreviations only need to check in-game players, not the whole character_list
+	for (i = player_character_list; i && !found; i = i->next_plr) {
+		if (player_vis_match(ch, i, name, flags)) {
+			found = i;
 		}
-		
-		found = i;
 	}
 
 	return found;
@@ -1590,18 +1814,19 @@ char_data *get_player_vis(char_data *ch, char *name, bitvector_t flags) {
 */
 char_data *get_char_world(char *name) {
 	char tmpname[MAX_INPUT_LENGTH], *tmp = tmpname;
+	struct keyword_index_ref *kwi;
 	int number, pos = 0;
-	bool pc_only = FALSE;
 	char_data *ch, *found = NULL;
 	
 	strcpy(tmp, name);
 	if ((number = get_number(&tmp)) == 0) {
-		pc_only = TRUE;
+		// 0.name: players only, via the name index
+		return get_player_vis(NULL, tmp, FIND_CHAR_WORLD);
 	}
 
-	for (ch = character_list; ch && (pos <= number) && !found; ch = ch->next) {
-		if ((!IS_NPC(ch) || !pc_only) && match_char_name(NULL, ch, tmp, MATCH_GLOBAL)) {
-			if (++pos == number || pc_only) {	// pc_only messes up pos
+	for (ch = first_char_by_keyword(tmp, &kwi); ch && (pos <= number) && !found; ch = next_char_by_keyword(ch, &kwi)) {
+		if (match_char_name(NULL, ch, tmp, MATCH_GLOBAL)) {
+			if (++pos == number) {
 				found = ch;
 			}
 		}
@@ -2334,6 +2559,7 @@ void abandon_room(room_data *room) {
 	}
 	
 	perform_abandon_room(room);
+	clear_map_icon_cache(room, NULL);	// city centers show their owner's city
 	
 	// inside
 	LL_FOREACH_SAFE2(interior_room_list, iter, next_iter, next_interior) {
@@ -2359,6 +2585,7 @@ void claim_room(room_data *room, empire_data *emp) {
 	}
 	
 	perform_claim_room(home, emp);
+	clear_map_icon_cache(home, NULL);	// city centers show their owner's city
 	
 	LL_FOREACH_SAFE2(interior_room_list, iter, next_iter, next_interior) {
 		if (HOME_ROOM(iter) == home) {
@@ -2429,17 +2656,16 @@ struct empire_political_data *find_relation(empire_data *from, empire_data *to)
 * @return struct empire_territory_data* the territory data, or NULL if not found
 */
 struct empire_territory_data *find_territory_entry(empire_data *emp, room_data *room) {
-	struct empire_territory_data *found = NULL, *ter_iter;
+	struct empire_territory_data *found = NULL;
+	room_vnum vnum;
 	
-	if (emp) {
-		for (ter_iter = EMPIRE_TERRITORY_LIST(emp); ter_iter && !found; ter_iter = ter_iter->next) {
-			if (ter_iter->room == room) {
-				found = ter_iter;
-			}
-		}
+	if (emp && room) {
+		vnum = GET_ROOM_VNUM(room);
+		HASH_FIND_INT(EMPIRE_TERRITORY_HASH(emp), &vnum, found);
 	}
 	
-	return found;
+	// the hash is by vnum; make sure it's really the same room
+	return (found && found->room == room) ? found : NULL;
 }
 
 
@@ -3349,6 +3575,391 @@ bool run_room_interactions(char_data *ch, room_data *room, int type, INTERACTION
 }
 
 
+ //////////////////////////////////////////////////////////////////////////////
+//// KEYWORD INDEX HANDLERS //////////////////////////////////////////////////
+
+/**
+* Copies the keyword_index bucket prefix for a word: its first few letters,
+* lowercased.
+*
+* @param const char *word The keyword or search word.
+* @param char *prefix A buffer of at least KEYWORD_INDEX_PREFIX+1 chars.
+*/
+static void get_keyword_index_prefix(const char *word, char *prefix) {
+	int iter;
+	
+	for (iter = 0; iter < KEYWORD_INDEX_PREFIX && word[iter]; ++iter) {
+		prefix[iter] = LOWER(word[iter]);
+	}
+	prefix[iter] = '\0';
+}
+
+
+/**
+* Adds a thing to the keyword_index bucket for each word in a namelist. A
+* thing is only added once to any bucket. Buckets are kept in the same order
+* as the global lists (newest first), so that "2.name" searches find the same
+* thing whether they walk a bucket or the whole list.
+*
+* @param int type KWI_x: which index.
+* @param void *thing The char, obj, or vehicle.
+* @param unsigned long long seq The thing's list_seq.
+* @param struct keyword_index_ref **refs The thing's keyword_refs list.
+* @param const char *namelist Its keywords (may be NULL).
+*/
+static void add_keyword_index_refs(int type, void *thing, unsigned long long seq, struct keyword_index_ref **refs, const char *namelist) {
+	char prefix[KEYWORD_INDEX_PREFIX + 1];
+	struct keyword_index_ref *ref, *pos;
+	struct keyword_index *index;
+	const char *word;
+	
+	if (!namelist) {
+		return;
+	}
+	
+	for (word = namelist; *word; ) {
+		// skip to the start of the next word (same separators as isname)
+		while (*word == ' ' || *word == '\t') {
+			++word;
+		}
+		if (!*word) {
+			break;
+		}
+		
+		get_keyword_index_prefix(word, prefix);
+		while (*word && *word != ' ' && *word != '\t') {
+			++word;
+		}
+		
+		HASH_FIND_STR(keyword_index[type], prefix, index);
+		if (!index) {
+			CREATE(index, struct keyword_index, 1);
+			strcpy(index->prefix, prefix);
+			HASH_ADD_STR(keyword_index[type], prefix, index);
+		}
+		
+		// already in this bucket?
+		for (ref = *refs; ref; ref = ref->next_for_thing) {
+			if (ref->index == index) {
+				break;
+			}
+		}
+		if (ref) {
+			continue;
+		}
+		
+		CREATE(ref, struct keyword_index_ref, 1);
+		ref->thing = thing;
+		ref->index = index;
+		ref->seq = seq;
+		
+		// new things go at the front; re-indexed ones go back to their list position
+		for (pos = index->refs; pos && pos->seq > seq; pos = pos->next);
+		if (pos) {
+			DL_PREPEND_ELEM(index->refs, pos, ref);
+		}
+		else {
+			DL_APPEND(index->refs, ref);
+		}
+		ref->next_for_thing = *refs;
+		*refs = ref;
+	}
+}
+
+
+/**
+* Removes all of a thing's keyword_index entries, and frees any buckets that
+* are left empty.
+*
+* @param int type KWI_x: which index.
+* @param struct keyword_index_ref **refs The thing's keyword_refs list.
+*/
+static void remove_keyword_index_refs(int type, struct keyword_index_ref **refs) {
+	struct keyword_index_ref *ref;
+	
+	while ((ref = *refs)) {
+		*refs = ref->next_for_thing;
+		DL_DELETE(ref->index->refs, ref);
+		
+		if (!ref->index->refs) {
+			HASH_DEL(keyword_index[type], ref->index);
+			free(ref->index);
+		}
+		free(ref);
+	}
+}
+
+
+/**
+* Finds the keyword_index bucket that must contain anything matching a name
+* argument with isname() or multi_isname(). The index can only answer for
+* arguments whose first word is at least KEYWORD_INDEX_PREFIX long, and (for
+* objects) that could not be the name of a liquid in a drink container.
+*
+* @param int type KWI_x: which index.
+* @param const char *arg The name argument (after get_number).
+* @param struct keyword_index_ref **refs Will be set to the bucket's refs (NULL if there are no candidates at all).
+* @return bool TRUE if the index can answer this argument; FALSE if the caller must scan the whole list.
+*/
+static bool find_keyword_index_refs(int type, const char *arg, struct keyword_index_ref **refs) {
+	char word[MAX_INPUT_LENGTH], prefix[KEYWORD_INDEX_PREFIX + 1];
+	struct keyword_index *index;
+	int iter;
+	
+	*refs = NULL;
+	
+	one_argument((char*)arg, word);
+	if (strlen(word) < KEYWORD_INDEX_PREFIX) {
+		return FALSE;	// short abbreviations could be in many buckets
+	}
+	if (type == KWI_OBJ) {
+		// MATCH_ITEM_NAME also matches drink container contents
+		for (iter = 0; *drinks[iter] != '\n'; ++iter) {
+			if (isname(word, drinks[iter])) {
+				return FALSE;
+			}
+		}
+	}
+	
+	get_keyword_index_prefix(word, prefix);
+	HASH_FIND_STR(keyword_index[type], prefix, index);
+	*refs = index ? index->refs : NULL;
+	return TRUE;
+}
+
+
+/**
+* (Re-)indexes a character's keywords: name, plus lastname, morph keywords,
+* and disguise name where they apply. Characters are only indexed while they
+* are in a room.
+*
+* @param char_data *ch The character.
+*/
+void index_char_keywords(char_data *ch) {
+	remove_keyword_index_refs(KWI_CHAR, &ch->keyword_refs);
+	ch->keyword_index_src = GET_PC_NAME(ch);
+	
+	if (!IN_ROOM(ch)) {
+		return;
+	}
+	
+	add_keyword_index_refs(KWI_CHAR, ch, ch->list_seq, &ch->keyword_refs, GET_PC_NAME(ch));
+	if (!IS_NPC(ch)) {
+		add_keyword_index_refs(KWI_CHAR, ch, ch->list_seq, &ch->keyword_refs, GET_LASTNAME(ch));
+	}
+	if (IS_MORPHED(ch)) {
+		add_keyword_index_refs(KWI_CHAR, ch, ch->list_seq, &ch->keyword_refs, MORPH_KEYWORDS(GET_MORPH(ch)));
+	}
+	if (IS_DISGUISED(ch)) {
+		add_keyword_index_refs(KWI_CHAR, ch, ch->list_seq, &ch->keyword_refs, GET_DISGUISED_NAME(ch));
+	}
+}
+
+
+/**
+* Re-indexes a character's keywords if its name was changed since it was last
+* indexed (or it was never indexed).
+*
+* @param char_data *ch The character.
+*/
+void check_char_keyword_index(char_data *ch) {
+	if (ch->keyword_index_src != GET_PC_NAME(ch) || !ch->keyword_refs) {
+		index_char_keywords(ch);
+	}
+}
+
+
+/**
+* Removes a character from the keyword index.
+*
+* @param char_data *ch The character.
+*/
+void unindex_char_keywords(char_data *ch) {
+	remove_keyword_index_refs(KWI_CHAR, &ch->keyword_refs);
+	ch->keyword_index_src = NULL;
+}
+
+
+/**
+* (Re-)indexes an object's keywords. Objects are only indexed while they are
+* in the object_list.
+*
+* @param obj_data *obj The object.
+*/
+void index_obj_keywords(obj_data *obj) {
+	remove_keyword_index_refs(KWI_OBJ, &obj->keyword_refs);
+	obj->keyword_index_src = GET_OBJ_KEYWORDS(obj);
+	
+	if (obj->in_object_list) {
+		add_keyword_index_refs(KWI_OBJ, obj, obj->list_seq, &obj->keyword_refs, GET_OBJ_KEYWORDS(obj));
+	}
+}
+
+
+/**
+* Re-indexes an object's keywords if they were changed since it was last
+* indexed. This is called as objects are placed, after most restrings.
+*
+* @param obj_data *obj The object.
+*/
+void check_obj_keyword_index(obj_data *obj) {
+	if (obj->keyword_index_src != GET_OBJ_KEYWORDS(obj)) {
+		index_obj_keywords(obj);
+	}
+}
+
+
+/**
+* Removes an object from the keyword index.
+*
+* @param obj_data *obj The object.
+*/
+void unindex_obj_keywords(obj_data *obj) {
+	remove_keyword_index_refs(KWI_OBJ, &obj->keyword_refs);
+	obj->keyword_index_src = NULL;
+}
+
+
+/**
+* (Re-)indexes a vehicle's keywords. Vehicles are only indexed while they are
+* in a room.
+*
+* @param vehicle_data *veh The vehicle.
+*/
+void index_vehicle_keywords(vehicle_data *veh) {
+	remove_keyword_index_refs(KWI_VEHICLE, &veh->keyword_refs);
+	veh->keyword_index_src = VEH_KEYWORDS(veh);
+	
+	if (IN_ROOM(veh)) {
+		add_keyword_index_refs(KWI_VEHICLE, veh, veh->list_seq, &veh->keyword_refs, VEH_KEYWORDS(veh));
+	}
+}
+
+
+/**
+* Re-indexes a vehicle's keywords if they were changed since it was last
+* indexed (or it was never indexed).
+*
+* @param vehicle_data *veh The vehicle.
+*/
+void check_vehicle_keyword_index(vehicle_data *veh) {
+	if (veh->keyword_index_src != VEH_KEYWORDS(veh) || !veh->keyword_refs) {
+		index_vehicle_keywords(veh);
+	}
+}
+
+
+/**
+* Removes a vehicle from the keyword index.
+*
+* @param vehicle_data *veh The vehicle.
+*/
+void unindex_vehicle_keywords(vehicle_data *veh) {
+	remove_keyword_index_refs(KWI_VEHICLE, &veh->keyword_refs);
+	veh->keyword_index_src = NULL;
+}
+
+
+/**
+* Starts iterating over the characters that could match a name argument: the
+* matching keyword_index bucket if possible, or else the whole character_list.
+* Callers must still check the name on each character. Use it like:
+*   for (ch = first_char_by_keyword(arg, &kwi); ch; ch = next_char_by_keyword(ch, &kwi))
+*
+* @param const char *arg The name argument (after get_number).
+* @param struct keyword_index_ref **kwi Iterator state.
+* @return char_data* The first candidate, or NULL.
+*/
+char_data *first_char_by_keyword(const char *arg, struct keyword_index_ref **kwi) {
+	if (find_keyword_index_refs(KWI_CHAR, arg, kwi)) {
+		return *kwi ? (char_data*)(*kwi)->thing : NULL;
+	}
+	return character_list;
+}
+
+
+/**
+* Continues iterating from first_char_by_keyword().
+*
+* @param char_data *ch The current candidate.
+* @param struct keyword_index_ref **kwi Iterator state.
+* @return char_data* The next candidate, or NULL.
+*/
+char_data *next_char_by_keyword(char_data *ch, struct keyword_index_ref **kwi) {
+	if (*kwi) {
+		*kwi = (*kwi)->next;
+		return *kwi ? (char_data*)(*kwi)->thing : NULL;
+	}
+	return ch->next;
+}
+
+
+/**
+* Starts iterating over the objects that could match a name argument: the
+* matching keyword_index bucket if possible, or else the whole object_list.
+* Callers must still check the name on each object.
+*
+* @param const char *arg The name argument (after get_number).
+* @param struct keyword_index_ref **kwi Iterator state.
+* @return obj_data* The first candidate, or NULL.
+*/
+obj_data *first_obj_by_keyword(const char *arg, struct keyword_index_ref **kwi) {
+	if (find_keyword_index_refs(KWI_OBJ, arg, kwi)) {
+		return *kwi ? (obj_data*)(*kwi)->thing : NULL;
+	}
+	return object_list;
+}
+
+
+/**
+* Continues iterating from first_obj_by_keyword().
+*
+* @param obj_data *obj The current candidate.
+* @param struct keyword_index_ref **kwi Iterator state.
+* @return obj_data* The next candidate, or NULL.
+*/
+obj_data *next_obj_by_keyword(obj_data *obj, struct keyword_index_ref **kwi) {
+	if (*kwi) {
+		*kwi = (*kwi)->next;
+		return *kwi ? (obj_data*)(*kwi)->thing : NULL;
+	}
+	return obj->next;
+}
+
+
+/**
+* Starts iterating over the vehicles that could match a name argument: the
+* matching keyword_index bucket if possible, or else the whole vehicle_list.
+* Callers must still check the name on each vehicle.
+*
+* @param const char *arg The name argument (after get_number).
+* @param struct keyword_index_ref **kwi Iterator state.
+* @return vehicle_data* The first candidate, or NULL.
+*/
+vehicle_data *first_vehicle_by_keyword(const char *arg, struct keyword_index_ref **kwi) {
+	if (find_keyword_index_refs(KWI_VEHICLE, arg, kwi)) {
+		return *kwi ? (vehicle_data*)(*kwi)->thing : NULL;
+	}
+	return vehicle_list;
+}
+
+
+/**
+* Continues iterating from first_vehicle_by_keyword().
+*
+* @param vehicle_data *veh The current candidate.
+* @param struct keyword_index_ref **kwi Iterator state.
+* @return vehicle_data* The next candidate, or NULL.
+*/
+vehicle_data *next_vehicle_by_keyword(vehicle_data *veh, struct keyword_index_ref **kwi) {
+	if (*kwi) {
+		*kwi = (*kwi)->next;
+		return *kwi ? (vehicle_data*)(*kwi)->thing : NULL;
+	}
+	return veh->next;
+}
+
+
  //////////////////////////////////////////////////////////////////////////////
 //// LORE HANDLERS ///////////////////////////////////////////////////////////
 
@@ -3790,6 +4401,13 @@ void perform_mount(char_data *ch, char_data *mount) {
 void add_to_object_list(obj_data *obj) {
 	obj->next = object_list;
 	object_list = obj;
+	obj->in_object_list = TRUE;
+	obj->list_seq = ++top_list_seq;
+	index_obj_keywords(obj);
+	
+	// start any timers now that it's in the world
+	schedule_obj_timer(obj);
+	add_to_autostore_queue(obj);
 }
 
 
@@ -3859,7 +4477,7 @@ obj_data *copy_warehouse_obj(obj_data *input) {
 	GET_OBJ_EXTRA(obj) = GET_OBJ_EXTRA(input);
 	GET_OBJ_CURRENT_SCALE_LEVEL(obj) = GET_OBJ_CURRENT_SCALE_LEVEL(input);
 	GET_OBJ_AFF_FLAGS(obj) = GET_OBJ_AFF_FLAGS(input);
-	GET_OBJ_TIMER(obj) = GET_OBJ_TIMER(input);
+	SET_OBJ_TIMER(obj, GET_OBJ_TIMER(input));
 	GET_OBJ_TYPE(obj) = GET_OBJ_TYPE(input);
 	GET_OBJ_WEAR(obj) = GET_OBJ_WEAR(input);
 	GET_STOLEN_TIMER(obj) = GET_STOLEN_TIMER(input);
@@ -3982,7 +4600,7 @@ obj_data *fresh_copy_obj(obj_data *obj, int scale_level) {
 	
 	if (GET_OBJ_TIMER(obj) != UNLIMITED && GET_OBJ_TIMER(proto) != UNLIMITED) {
 		// only change if BOTH are unlimited. Otherwise, this trait was changed and we should inherit it.
-		GET_OBJ_TIMER(new) = GET_OBJ_TIMER(obj);
+		SET_OBJ_TIMER(new, GET_OBJ_TIMER(obj));
 	}
 	GET_AUTOSTORE_TIMER(new) = GET_AUTOSTORE_TIMER(obj);
 	new->stolen_timer = obj->stolen_timer;
@@ -4194,6 +4812,12 @@ bool parse_component(char *str, int *type, bitvector_t *flags) {
 void remove_from_object_list(obj_data *obj) {
 	obj_data *temp;
 	REMOVE_FROM_LIST(obj, object_list, next);
+	obj->in_object_list = FALSE;
+	unindex_obj_keywords(obj);
+	
+	// stop timers (the decay timer is stored back on the obj)
+	cancel_obj_timer(obj);
+	remove_from_autostore_queue(obj);
 }
 
 
@@ -4435,6 +5059,7 @@ void equip_char(char_data *ch, obj_data *obj, int pos) {
 	}
 	else {
 		check_obj_in_void(obj);
+		check_obj_keyword_index(obj);
 		
 		// check binding
 		if (OBJ_FLAGGED(obj, OBJ_BIND_FLAGS)) {
@@ -4529,6 +5154,8 @@ void obj_from_obj(obj_data *obj) {
 * @param obj_data *object The item to remove.
 */
 void obj_from_room(obj_data *object) {
+	void adjust_instance_count(struct instance_mob **hash, any_vnum vnum, int amount);
+	
 	obj_data *temp;
 
 	if (!object || !IN_ROOM(object)) {
@@ -4540,6 +5167,11 @@ void obj_from_room(obj_data *object) {
 			ROOM_LIGHTS(IN_ROOM(object))--;
 		}
 
+		// instance counts
+		if (ROOM_INSTANCE(IN_ROOM(object))) {
+			adjust_instance_count(&ROOM_INSTANCE(IN_ROOM(object))->obj_counts, GET_OBJ_VNUM(object), -1);
+		}
+
 		REMOVE_FROM_LIST(object, ROOM_CONTENTS(IN_ROOM(object)), next_content);
 		IN_ROOM(object) = NULL;
 		object->next_content = NULL;
@@ -4588,6 +5220,7 @@ void obj_to_char(obj_data *object, char_data *ch) {
 	check_obj_in_void(object);
 
 	if (object && ch) {
+		check_obj_keyword_index(object);
 		object->next_content = ch->carrying;
 		ch->carrying = object;
 		object->carried_by = ch;
@@ -4727,6 +5360,7 @@ void obj_to_obj(obj_data *obj, obj_data *obj_to) {
 	}
 	else {
 		check_obj_in_void(obj);
+		check_obj_keyword_index(obj);
 	
 		GET_OBJ_CARRYING_N(obj_to) += obj_carry_size(obj);
 
@@ -4739,6 +5373,9 @@ void obj_to_obj(obj_data *obj, obj_data *obj_to) {
 		obj->next_content = obj_to->contains;
 		obj_to->contains = obj;
 		obj->in_obj = obj_to;
+		
+		// only queues it if obj_to is on the ground
+		add_to_autostore_queue(obj);
 	}
 }
 
@@ -4750,11 +5387,14 @@ void obj_to_obj(obj_data *obj, obj_data *obj_to) {
 * @param room_data *room Where to place it.
 */
 void obj_to_room(obj_data *object, room_data *room) {
+	void adjust_instance_count(struct instance_mob **hash, any_vnum vnum, int amount);
+	
 	if (!object || !room) {
 		log("SYSERR: Illegal value(s) passed to obj_to_room. (Room %p, obj %p)", room, object);
 	}
 	else {
 		check_obj_in_void(object);
+		check_obj_keyword_index(object);
 		object->next_content = ROOM_CONTENTS(room);
 		ROOM_CONTENTS(room) = object;
 		IN_ROOM(object) = room;
@@ -4765,11 +5405,17 @@ void obj_to_room(obj_data *object, room_data *room) {
 			ROOM_LIGHTS(IN_ROOM(object))++;
 		}
 		
+		// instance counts
+		if (ROOM_INSTANCE(room)) {
+			adjust_instance_count(&ROOM_INSTANCE(room)->obj_counts, GET_OBJ_VNUM(object), 1);
+		}
+		
 		// clear keep now
 		REMOVE_BIT(GET_OBJ_EXTRA(object), OBJ_KEEP);
 
 		// set the timer here; actual rules for it are in limits.c
 		GET_AUTOSTORE_TIMER(object) = time(0);
+		add_to_autostore_queue(object);
 	}
 }
 
@@ -4786,6 +5432,7 @@ void obj_to_vehicle(obj_data *object, vehicle_data *veh) {
 	}
 	else {
 		check_obj_in_void(object);
+		check_obj_keyword_index(object);
 		
 		LL_PREPEND2(VEH_CONTAINS(veh), object, next_content);
 		object->in_vehicle = veh;
@@ -5196,6 +5843,7 @@ obj_vnum get_obj_vnum_by_name(char *name, bool storable_only) {
 * @return obj_data *The found item, or NULL.
 */
 obj_data *get_obj_vis(char_data *ch, char *name) {
+	struct keyword_index_ref *kwi;
 	obj_data *i, *found = NULL;
 	int j = 0, number;
 	char tmpname[MAX_INPUT_LENGTH];
@@ -5213,8 +5861,8 @@ obj_data *get_obj_vis(char_data *ch, char *name) {
 	if ((number = get_number(&tmp)) == 0)
 		return (NULL);
 
-	/* ok.. no luck yet. scan the entire obj list   */
-	for (i = object_list; i && (j <= number) && !found; i = i->next) {
+	/* ok.. no luck yet. scan the objs with a matching keyword   */
+	for (i = first_obj_by_keyword(tmp, &kwi); i && (j <= number) && !found; i = next_obj_by_keyword(i, &kwi)) {
 		if (CAN_SEE_OBJ(ch, i) && MATCH_ITEM_NAME(tmp, i)) {
 			if (++j == number) {
 				found = i;
@@ -5261,6 +5909,7 @@ obj_data *get_object_in_equip_vis(char_data *ch, char *arg, obj_data *equipment[
 * @return obj_data *The found item, or NULL.
 */
 obj_data *get_obj_world(char *name) {
+	struct keyword_index_ref *kwi;
 	obj_data *i, *found = NULL;
 	int j = 0, number;
 	char tmpname[MAX_INPUT_LENGTH];
@@ -5270,7 +5919,7 @@ obj_data *get_obj_world(char *name) {
 	if ((number = get_number(&tmp)) == 0)
 		return (NULL);
 
-	for (i = object_list; i && (j <= number) && !found; i = i->next) {
+	for (i = first_obj_by_keyword(tmp, &kwi); i && (j <= number) && !found; i = next_obj_by_keyword(i, &kwi)) {
 		if (MATCH_ITEM_NAME(tmp, i)) {
 			if (++j == number) {
 				found = i;
@@ -6017,7 +6666,17 @@ void attach_building_to_room(bld_data *bld, room_data *room, bool with_triggers)
 	if (!COMPLEX_DATA(room)) {
 		COMPLEX_DATA(room) = init_complex_data();
 	}
+	
+	// world counts only include the map
+	if (GET_ROOM_VNUM(room) < MAP_SIZE) {
+		stats_adjust_building_count(COMPLEX_DATA(room)->bld_ptr, -1);
+		stats_adjust_building_count(bld, 1);
+	}
+	
 	COMPLEX_DATA(room)->bld_ptr = bld;
+	schedule_room_updates(room);
+	schedule_room_chores(room);
+	clear_map_icon_cache(room, NULL);
 
 	// copy proto script
 	if (with_triggers) {
@@ -6045,6 +6704,8 @@ void attach_template_to_room(room_template *rmt, room_data *room) {
 		COMPLEX_DATA(room) = init_complex_data();
 	}
 	COMPLEX_DATA(room)->rmt_ptr = rmt;
+	schedule_room_updates(room);
+	schedule_room_chores(room);
 }
 
 
@@ -6073,6 +6734,11 @@ void detach_building_from_room(room_data *room) {
 	}
 	
 	COMPLEX_DATA(room)->bld_ptr = NULL;
+	if (GET_ROOM_VNUM(room) < MAP_SIZE) {
+		stats_adjust_building_count(bld, -1);
+	}
+	clear_map_icon_cache(room, NULL);
+	
 	LL_FOREACH_SAFE(room->proto_script, tpl, next_tpl) {
 		LL_SEARCH_SCALAR(GET_BLD_SCRIPTS(bld), search, vnum, tpl->vnum);
 		if (search) {	// matching vnum on the proto
@@ -6214,6 +6880,13 @@ void set_room_extra_data(room_data *room, int type, int value) {
 	}
 	
 	red->value = value;
+	
+	if (type == ROOM_EXTRA_SEED_TIME) {
+		schedule_room_updates(room);
+	}
+	else if (type == ROOM_EXTRA_RUINS_ICON) {
+		clear_map_icon_cache(room, NULL);
+	}
 }
 
 
@@ -6871,6 +7544,7 @@ void read_vault(empire_data *emp) {
 	obj_data *proto;
 	
 	EMPIRE_WEALTH(emp) = 0;
+	++EMPIRE_MSDP_VERSION(emp);	// territory limit depends on wealth
 
 	for (store = EMPIRE_STORAGE(emp); store; store = store->next) {
 		if ((proto = obj_proto(store->vnum))) {
@@ -7387,6 +8061,7 @@ void extract_vehicle(vehicle_data *veh) {
 	}
 	
 	LL_DELETE2(vehicle_list, veh, next);
+	unindex_vehicle_keywords(veh);
 	free_vehicle(veh);
 }
 
@@ -7426,11 +8101,18 @@ void unseat_char_from_vehicle(char_data *ch) {
 * @param vehicle_data *veh The vehicle to remove from its room.
 */
 void vehicle_from_room(vehicle_data *veh) {
+	void adjust_instance_count(struct instance_mob **hash, any_vnum vnum, int amount);
+	
 	if (!veh || !IN_ROOM(veh)) {
 		log("SYSERR: NULL vehicle (%p) or vehicle not in a room (%p) passed to vehicle_from_room", veh, IN_ROOM(veh));
 		return;
 	}
 	
+	// instance counts
+	if (ROOM_INSTANCE(IN_ROOM(veh))) {
+		adjust_instance_count(&ROOM_INSTANCE(IN_ROOM(veh))->vehicle_counts, VEH_VNUM(veh), -1);
+	}
+	
 	LL_DELETE2(ROOM_VEHICLES(IN_ROOM(veh)), veh, next_in_room);
 	IN_ROOM(veh) = NULL;
 }
@@ -7443,6 +8125,8 @@ void vehicle_from_room(vehicle_data *veh) {
 * @param room_data *room The room to put it in.
 */
 void vehicle_to_room(vehicle_data *veh, room_data *room) {
+	void adjust_instance_count(struct instance_mob **hash, any_vnum vnum, int amount);
+	
 	if (!veh || !room) {
 		log("SYSERR: Illegal value(s) passed to vehicle_to_room. (Room %p, vehicle %p)", room, veh);
 		return;
@@ -7455,6 +8139,12 @@ void vehicle_to_room(vehicle_data *veh, room_data *room) {
 	LL_PREPEND2(ROOM_VEHICLES(room), veh, next_in_room);
 	IN_ROOM(veh) = room;
 	VEH_LAST_MOVE_TIME(veh) = time(0);
+	check_vehicle_keyword_index(veh);
+	
+	// instance counts
+	if (ROOM_INSTANCE(room)) {
+		adjust_instance_count(&ROOM_INSTANCE(room)->vehicle_counts, VEH_VNUM(veh), 1);
+	}
 }
 
 
@@ -7508,6 +8198,7 @@ vehicle_data *get_vehicle_in_target_room_vis(char_data *ch, room_data *room, cha
 * @return vehicle_data* The vehicle found, or NULL.
 */
 vehicle_data *get_vehicle_vis(char_data *ch, char *name) {
+	struct keyword_index_ref *kwi;
 	int found = 0, number;
 	char tmpname[MAX_INPUT_LENGTH];
 	char *tmp = tmpname;
@@ -7525,7 +8216,7 @@ vehicle_data *get_vehicle_vis(char_data *ch, char *name) {
 		return (NULL);
 	}
 	
-	LL_FOREACH2(vehicle_list, iter, next) {
+	for (iter = first_vehicle_by_keyword(tmp, &kwi); iter; iter = next_vehicle_by_keyword(iter, &kwi)) {
 		if (!isname(tmp, VEH_KEYWORDS(iter))) {
 			continue;
 		}
@@ -7585,6 +8276,7 @@ vehicle_data *get_vehicle_room(room_data *room, char *name) {
 * @return vehicle_data* The vehicle found, or NULL.
 */
 vehicle_data *get_vehicle_world(char *name) {
+	struct keyword_index_ref *kwi;
 	int found = 0, number;
 	char tmpname[MAX_INPUT_LENGTH];
 	char *tmp = tmpname;
@@ -7597,7 +8289,7 @@ vehicle_data *get_vehicle_world(char *name) {
 		return (NULL);
 	}
 	
-	LL_FOREACH2(vehicle_list, iter, next) {
+	for (iter = first_vehicle_by_keyword(tmp, &kwi); iter; iter = next_vehicle_by_keyword(iter, &kwi)) {
 		if (!isname(tmp, VEH_KEYWORDS(iter))) {
 			continue;
 		}
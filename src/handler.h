@@ -90,6 +90,11 @@ void extract_char_final(char_data *ch);
 extern bool match_char_name(char_data *ch, char_data *target, char *name, bitvector_t flags);
 void perform_idle_out(char_data *ch);
 
+// online player name index
+void add_player_to_name_index(char_data *ch);
+void remove_player_from_name_index(char_data *ch);
+void update_player_name_index(char_data *ch);
+
 // character location handlers
 void char_from_room(char_data *ch);
 void char_to_room(char_data *ch, room_data *room);
@@ -168,6 +173,23 @@ extern bool run_global_mob_interactions(char_data *ch, char_data *mob, int type,
 extern bool run_interactions(char_data *ch, struct interaction_item *run_list, int type, room_data *inter_room, char_data *inter_mob, obj_data *inter_item, INTERACTION_FUNC(*func));
 extern bool run_room_interactions(char_data *ch, room_data *room, int type, INTERACTION_FUNC(*func));
 
+// keyword index handlers
+void check_char_keyword_index(char_data *ch);
+void check_obj_keyword_index(obj_data *obj);
+void check_vehicle_keyword_index(vehicle_data *veh);
+extern char_data *first_char_by_keyword(const char *arg, struct keyword_index_ref **kwi);
+extern obj_data *first_obj_by_keyword(const char *arg, struct keyword_index_ref **kwi);
+extern vehicle_data *first_vehicle_by_keyword(const char *arg, struct keyword_index_ref **kwi);
+void index_char_keywords(char_data *ch);
+void index_obj_keywords(obj_data *obj);
+void index_vehicle_keywords(vehicle_data *veh);
+extern char_data *next_char_by_keyword(char_data *ch, struct keyword_index_ref **kwi);
+extern obj_data *next_obj_by_keyword(obj_data *obj, struct keyword_index_ref **kwi);
+extern vehicle_data *next_vehicle_by_keyword(vehicle_data *veh, struct keyword_index_ref **kwi);
+void unindex_char_keywords(char_data *ch);
+void unindex_obj_keywords(obj_data *obj);
+void unindex_vehicle_keywords(vehicle_data *veh);
+
 // lore handlers
 void add_lore(char_data *ch, int type, const char *str, ...) __attribute__((format(printf, 3, 4)));
 void remove_lore(char_data *ch, int type);
@@ -368,7 +390,11 @@ extern struct instance_data *real_instance(any_vnum instance_id);
 void subtract_instance_mob(struct instance_data *inst, mob_vnum vnum);
 
 // limits.c
+void add_to_autostore_queue(obj_data *obj);
+void cancel_obj_timer(obj_data *obj);
 extern int limit_crowd_control(char_data *victim, int atype);
+void remove_from_autostore_queue(obj_data *obj);
+void schedule_obj_timer(obj_data *obj);
 
 // morph.c
 void perform_morph(char_data *ch, morph_data *morph);
@@ -42,6 +42,7 @@ extern int stats_get_building_count(bld_data *bdg);
 extern int stats_get_sector_count(sector_data *sect);
 
 // locals
+void adjust_instance_count(struct instance_mob **hash, any_vnum vnum, int amount);
 bool can_instance(adv_data *adv);
 int count_instances(adv_data *adv);
 int count_mobs_in_instance(struct instance_data *inst, mob_vnum vnum);
@@ -51,9 +52,12 @@ int count_vehicles_in_instance(struct instance_data *inst, any_vnum vnum);
 static int determine_random_exit(adv_data *adv, room_data *from, room_data *to);
 struct instance_data *find_instance_by_room(room_data *room, bool check_homeroom);
 room_data *find_room_template_in_instance(struct instance_data *inst, rmt_vnum vnum);
+static void free_instance_counts(struct instance_mob **hash);
 static struct adventure_link_rule *get_link_rule_by_type(adv_data *adv, int type);
 any_vnum get_new_instance_id(void);
 static void instantiate_rooms(adv_data *adv, struct instance_data *inst, struct adventure_link_rule *rule, room_data *loc, int dir, int rotation);
+static void recount_instance_contents(struct instance_data *inst);
+static void try_generate_adventure_instance(void);
 void reset_instance(struct instance_data *inst);
 void scale_instance_to_level(struct instance_data *inst, int level);
 void unlink_instance_entrance(room_data *room, struct instance_data *inst);
@@ -61,9 +65,27 @@ void unlink_instance_entrance(room_data *room, struct instance_data *inst);
 
 // local globals
 struct instance_data *instance_list = NULL;	// global instance list
+struct instance_data *instance_table = NULL;	// hash table of instances by id (hh)
 bool instance_save_wait = FALSE;	// prevents repeated instance saving
 struct instance_data *quest_instance_global = NULL;	// passes instances through to some quest triggers
 
+// precomputed "not near" limits for one adventure (see get_link_exclusions)
+struct link_exclusion {
+	int x, y;	// map location that new instances must stay away from
+	int distance;	// how far away
+};
+
+// complete buildings by vnum, gathered once per generate_adventure_instances() cycle for ADV_LINK_BUILDING_EXISTING/PORTAL_BUILDING_EXISTING
+struct bld_link_candidates {
+	bld_vnum vnum;
+	room_data **rooms;
+	int count, size;
+	UT_hash_handle hh;
+};
+static struct bld_link_candidates *bld_link_candidates = NULL;	// hash table (or NULL outside a cycle)
+static bool bld_link_candidates_ready = FALSE;	// TRUE once gathered (during a cycle)
+static bool generating_instances = FALSE;	// TRUE during generate_adventure_instances()
+
 // ADV_LINK_x: whether or not a rule specifies a possible location (other types are for limits)
 const bool is_location_rule[] = {
 	TRUE,	// ADV_LINK_BUILDING_EXISTING
@@ -228,6 +250,7 @@ struct instance_data *build_instance_loc(adv_data *adv, struct adventure_link_ru
 	else {
 		instance_list = inst;
 	}
+	HASH_ADD_INT(instance_table, id, inst);
 	
 	if (ADVENTURE_FLAGGED(adv, ADV_ROTATABLE)) {
 		if (dir != NO_DIR && dir != DIR_RANDOM) {
@@ -502,7 +525,7 @@ static void instantiate_rooms(adv_data *adv, struct instance_data *inst, struct
 					inst->start = room_list[pos];
 				}
 				else {
-					COMPLEX_DATA(room_list[pos])->home_room = inst->start;
+					set_room_home(room_list[pos], inst->start);
 				}
 			}
 			
@@ -568,29 +591,29 @@ static void instantiate_rooms(adv_data *adv, struct instance_data *inst, struct
 //// INSTANCE GENERATION /////////////////////////////////////////////////////
 
 /**
-* Checks secondary link limiters like ADV_LINK_NOT_NEAR_SELF.
+* Gathers the secondary link limiters (like ADV_LINK_NOT_NEAR_SELF) for an
+* adventure into a short list of places it can't link near, so that each
+* candidate tile only has to be checked against these.
 *
 * @param adv_data *adv The adventure we are trying to link.
-* @param room_data *loc The chosen room -- OPTIONAL (pass loc OR map).
-* @param struct map_data *map The chosen map tile -- OPTIONAL (pass loc OR map).
-* @return bool TRUE if the location is ok, FALSE if not.
+* @param int *count A variable to store the length of the list.
+* @return struct link_exclusion* The list (free it when done), or NULL if there are none.
 */
-bool validate_linking_limits(adv_data *adv, room_data *loc, struct map_data *map) {
+static struct link_exclusion *get_link_exclusions(adv_data *adv, int *count) {
+	struct link_exclusion *list = NULL;
 	struct adventure_link_rule *rule;
 	struct instance_data *inst;
+	int size = 0;
 	
-	if (!loc && !map) {
-		return FALSE;
-	}
+	*count = 0;
 	
-	// Warning: these must all account for having loc OR map
 	for (rule = GET_ADV_LINKING(adv); rule; rule = rule->next) {
 		// ADV_LINK_x: but only some rules matter here (secondary limiters)
 		switch (rule->type) {
 			case ADV_LINK_NOT_NEAR_SELF: {
 				// adventure cannot link within X tiles of itself
 				for (inst = instance_list; inst; inst = inst->next) {
-					if (GET_ADV_VNUM(inst->adventure) != GET_ADV_VNUM(adv)) {
+					if (GET_ADV_VNUM(inst->adventure) != GET_ADV_VNUM(adv) || !inst->location) {
 						continue;
 					}
 					if (INSTANCE_FLAGGED(inst, INST_COMPLETED)) {
@@ -598,11 +621,19 @@ bool validate_linking_limits(adv_data *adv, room_data *loc, struct map_data *map
 						continue;
 					}
 					
-					// check distance
-					if (inst->location && compute_map_distance(X_COORD(inst->location), Y_COORD(inst->location), (loc ? X_COORD(loc) : MAP_X_COORD(map->vnum)), (loc ? Y_COORD(loc) : MAP_Y_COORD(map->vnum))) <= rule->value) {
-						// NO! Too close.
-						return FALSE;
+					if (*count >= size) {
+						size = MAX(8, size * 2);
+						if (list) {
+							RECREATE(list, struct link_exclusion, size);
+						}
+						else {
+							CREATE(list, struct link_exclusion, size);
+						}
 					}
+					list[*count].x = X_COORD(inst->location);
+					list[*count].y = Y_COORD(inst->location);
+					list[*count].distance = rule->value;
+					++*count;
 				}
 				
 				break;
@@ -611,11 +642,90 @@ bool validate_linking_limits(adv_data *adv, room_data *loc, struct map_data *map
 		}
 	}
 	
+	return list;
+}
+
+
+/**
+* Checks secondary link limiters like ADV_LINK_NOT_NEAR_SELF, using the list
+* from get_link_exclusions().
+*
+* @param struct link_exclusion *list The exclusions for the adventure.
+* @param int count How many are in the list.
+* @param int x The chosen location's x-coordinate.
+* @param int y The chosen location's y-coordinate.
+* @return bool TRUE if the location is ok, FALSE if not.
+*/
+static bool validate_linking_limits(struct link_exclusion *list, int count, int x, int y) {
+	int iter;
+	
+	for (iter = 0; iter < count; ++iter) {
+		if (compute_map_distance(list[iter].x, list[iter].y, x, y) <= list[iter].distance) {
+			// NO! Too close.
+			return FALSE;
+		}
+	}
+	
 	// all clear
 	return TRUE;
 }
 
 
+/**
+* Frees the building candidates gathered for a generate_adventure_instances()
+* cycle.
+*/
+static void free_bld_link_candidates(void) {
+	struct bld_link_candidates *blc, *next_blc;
+	
+	HASH_ITER(hh, bld_link_candidates, blc, next_blc) {
+		HASH_DEL(bld_link_candidates, blc);
+		if (blc->rooms) {
+			free(blc->rooms);
+		}
+		free(blc);
+	}
+	bld_link_candidates_ready = FALSE;
+}
+
+
+/**
+* Finds every complete building in the world, by vnum, in one pass. This is
+* done at most once per generate_adventure_instances() cycle, rather than once
+* per adventure that links to an existing building.
+*/
+static void gather_bld_link_candidates(void) {
+	struct bld_link_candidates *blc;
+	room_data *room, *next_room;
+	bld_vnum vnum;
+	
+	HASH_ITER(hh, world_table, room, next_room) {
+		if ((vnum = BUILDING_VNUM(room)) == NOTHING || !IS_COMPLETE(room)) {
+			continue;
+		}
+		
+		HASH_FIND_INT(bld_link_candidates, &vnum, blc);
+		if (!blc) {
+			CREATE(blc, struct bld_link_candidates, 1);
+			blc->vnum = vnum;
+			HASH_ADD_INT(bld_link_candidates, vnum, blc);
+		}
+		if (blc->count >= blc->size) {
+			blc->size = MAX(8, blc->size * 2);
+			if (blc->rooms) {
+				RECREATE(blc->rooms, room_data*, blc->size);
+			}
+			else {
+				CREATE(blc->rooms, room_data*, blc->size);
+			}
+		}
+		blc->rooms[blc->count++] = room;
+	}
+	
+	bld_link_candidates_ready = TRUE;
+}
+
+
 /**
 * This function checks basic room properties too see if the location is allowed
 * at all. It does NOT check the sector/building/bld_on rules -- that is done
@@ -669,7 +779,7 @@ bool validate_one_loc(adv_data *adv, struct adventure_link_rule *rule, room_data
 		if (ROOM_OWNER(home) && !LINK_FLAGGED(rule, ADV_LINKF_CLAIMED_OK | ADV_LINKF_CITY_ONLY)) {
 			return FALSE;
 		}
-		if (ROOM_OWNER(home) && (EMPIRE_LAST_LOGON(ROOM_OWNER(home)) + (config_get_int("time_to_empire_emptiness") * SECS_PER_REAL_WEEK)) < time(0)) {
+		if (ROOM_OWNER(home) && (EMPIRE_LAST_LOGON(ROOM_OWNER(home)) + (CONFIG_INT(CONF_TIME_TO_EMPIRE_EMPTINESS) * SECS_PER_REAL_WEEK)) < time(0)) {
 			return FALSE;	// owner is timed out -- don't spawn here
 		}
 	
@@ -754,7 +864,11 @@ room_data *find_location_for_rule(adv_data *adv, struct adventure_link_rule *rul
 	sector_data *findsect = NULL;
 	bool match_buildon = FALSE;
 	bld_data *findbdg = NULL, *bdg = NULL;
+	struct bld_link_candidates *blc;
+	struct link_exclusion *excl;
 	struct map_data *map;
+	bld_vnum bld_vnum;
+	int num_excl;
 	
 	const int max_tries = 500, max_dir_tries = 10;	// for random checks
 	
@@ -793,24 +907,46 @@ room_data *find_location_for_rule(adv_data *adv, struct adventure_link_rule *rul
 		}
 	}
 	
+	// places this adventure can't link near
+	excl = get_link_exclusions(adv, &num_excl);
+	
 	// two ways of doing this:
-	if (findsect) {	// scan the whole map
+	if (findsect) {	// scan the map tiles of that sector (land only)
 		num_found = 0;
-		for (map = land_map; map; map = map->next) {
-			// looking for sect: fail
-			if (findsect && map->sector_type != findsect) {
-				continue;
+		if (GET_SECT_VNUM(findsect) != BASIC_OCEAN) {
+			LL_FOREACH2(find_sector_index(GET_SECT_VNUM(findsect))->sect_rooms, map, next_in_sect) {
+				// limits/attributes checks (cheapest first)
+				if (!validate_linking_limits(excl, num_excl, MAP_X_COORD(map->vnum), MAP_Y_COORD(map->vnum)) || !validate_one_loc(adv, rule, NULL, map)) {
+					continue;
+				}
+			
+				// SUCCESS: mark it ok
+				if (!number(0, num_found++) || !found) {
+					// may already have looked up room
+					found = real_room(map->vnum);
+				}
 			}
+		}
+	}
+	else if (findbdg && generating_instances) {	// buildings are gathered once per cycle
+		if (!bld_link_candidates_ready) {
+			gather_bld_link_candidates();
+		}
+		
+		num_found = 0;
+		bld_vnum = GET_BLD_VNUM(findbdg);
+		HASH_FIND_INT(bld_link_candidates, &bld_vnum, blc);
+		for (iter = 0; blc && iter < blc->count; ++iter) {
+			room = blc->rooms[iter];
 			
-			// attributes/limits checks
-			if (!validate_one_loc(adv, rule, NULL, map) || !validate_linking_limits(adv, NULL, map)) {
+			// limits/attributes checks (cheapest first)
+			if (!validate_linking_limits(excl, num_excl, X_COORD(room), Y_COORD(room)) || !validate_one_loc(adv, rule, room, NULL)) {
 				continue;
 			}
 			
 			// SUCCESS: mark it ok
 			if (!number(0, num_found++) || !found) {
-				// may already have looked up room
-				found = real_room(map->vnum);
+				found = room;
 			}
 		}
 	}
@@ -821,8 +957,8 @@ room_data *find_location_for_rule(adv_data *adv, struct adventure_link_rule *rul
 				continue;
 			}
 			
-			// attributes/limits checks
-			if (!validate_one_loc(adv, rule, room, NULL) || !validate_linking_limits(adv, room, NULL)) {
+			// limits/attributes checks (cheapest first)
+			if (!validate_linking_limits(excl, num_excl, X_COORD(room), Y_COORD(room)) || !validate_one_loc(adv, rule, room, NULL)) {
 				continue;
 			}
 			
@@ -850,7 +986,7 @@ room_data *find_location_for_rule(adv_data *adv, struct adventure_link_rule *rul
 			}
 			
 			// check secondary limits
-			if (!validate_linking_limits(adv, NULL, map)) {
+			if (!validate_linking_limits(excl, num_excl, MAP_X_COORD(map->vnum), MAP_Y_COORD(map->vnum))) {
 				continue;
 			}
 			
@@ -895,6 +1031,10 @@ room_data *find_location_for_rule(adv_data *adv, struct adventure_link_rule *rul
 		}
 	}
 	
+	if (excl) {
+		free(excl);
+	}
+	
 	return found;
 }
 
@@ -904,8 +1044,20 @@ room_data *find_location_for_rule(adv_data *adv, struct adventure_link_rule *rul
 * if possible.
 */
 void generate_adventure_instances(void) {
-	void sort_world_table();
+	generating_instances = TRUE;
+	try_generate_adventure_instance();
+	generating_instances = FALSE;
+	
+	free_bld_link_candidates();
+}
+
 
+/**
+* Tries each adventure in turn (picking up after the last one that was
+* instanced) until one instance is created. Called by
+* generate_adventure_instances().
+*/
+static void try_generate_adventure_instance(void) {
 	struct adventure_link_rule *rule, *rule_iter;
 	adv_data *iter, *next_iter;
 	room_data *loc;
@@ -974,7 +1126,6 @@ void delete_instance(struct instance_data *inst) {
 	void extract_pending_chars();
 	void relocate_players(room_data *room, room_data *to_room);
 	
-	struct instance_mob *im, *next_im;
 	vehicle_data *veh, *next_veh;
 	struct instance_data *temp;
 	char_data *mob, *next_mob;
@@ -1035,14 +1186,17 @@ void delete_instance(struct instance_data *inst) {
 	
 	// remove from list AFTER removing rooms
 	REMOVE_FROM_LIST(inst, instance_list, next);
+	if (real_instance(inst->id) == inst) {
+		HASH_DEL(instance_table, inst);
+	}
 	if (inst->room) {
 		free(inst->room);
 	}
 	
 	// other stuff to free
-	HASH_ITER(hh, inst->mob_counts, im, next_im) {
-		free(im);
-	}
+	free_instance_counts(&inst->mob_counts);
+	free_instance_counts(&inst->obj_counts);
+	free_instance_counts(&inst->vehicle_counts);
 	
 	free(inst);
 	
@@ -1345,22 +1499,93 @@ void unlink_instance_entrance(room_data *room, struct instance_data *inst) {
 * @param mob_vnum vnum Which mob vnum to add to.
 */
 void add_instance_mob(struct instance_data *inst, mob_vnum vnum) {
+	if (inst) {
+		adjust_instance_count(&inst->mob_counts, vnum, 1);
+	}
+}
+
+
+/**
+* Adds to (or subtracts from) one of an instance's counts by vnum, e.g. the
+* objs on the ground. Entries are removed when they reach zero.
+*
+* @param struct instance_mob **hash A pointer to the instance's mob_counts, obj_counts, or vehicle_counts.
+* @param any_vnum vnum Which vnum to count.
+* @param int amount How much to add (may be negative).
+*/
+void adjust_instance_count(struct instance_mob **hash, any_vnum vnum, int amount) {
 	struct instance_mob *im;
 	
-	if (!inst || vnum == NOTHING) {
+	if (vnum == NOTHING) {
 		return;
 	}
 	
 	// find or create
-	HASH_FIND_INT(inst->mob_counts, &vnum, im);
-	if (!im) {
+	HASH_FIND_INT(*hash, &vnum, im);
+	if (!im && amount > 0) {
 		CREATE(im, struct instance_mob, 1);
 		im->vnum = vnum;
-		HASH_ADD_INT(inst->mob_counts, vnum, im);
+		HASH_ADD_INT(*hash, vnum, im);
+	}
+	
+	if (im) {
+		im->count += amount;
+		if (im->count <= 0) {
+			HASH_DEL(*hash, im);
+			free(im);
+		}
+	}
+}
+
+
+/**
+* Frees one of an instance's count tables.
+*
+* @param struct instance_mob **hash A pointer to the instance's mob_counts, obj_counts, or vehicle_counts.
+*/
+static void free_instance_counts(struct instance_mob **hash) {
+	struct instance_mob *im, *next_im;
+	
+	HASH_ITER(hh, *hash, im, next_im) {
+		HASH_DEL(*hash, im);
+		free(im);
 	}
+}
+
+
+/**
+* Rebuilds an instance's player/obj/vehicle counts from what's in its rooms.
+* These are normally kept up to date as things move in and out of rooms.
+*
+* @param struct instance_data *inst The instance to recount.
+*/
+static void recount_instance_contents(struct instance_data *inst) {
+	vehicle_data *veh;
+	obj_data *obj;
+	char_data *ch;
+	int iter;
+	
+	free_instance_counts(&inst->obj_counts);
+	free_instance_counts(&inst->vehicle_counts);
+	inst->player_count = 0;
 	
-	// add
-	im->count += 1;
+	for (iter = 0; iter < inst->size; ++iter) {
+		if (!inst->room[iter] || ROOM_INSTANCE(inst->room[iter]) != inst) {
+			continue;
+		}
+		
+		for (ch = ROOM_PEOPLE(inst->room[iter]); ch; ch = ch->next_in_room) {
+			if (!IS_NPC(ch)) {
+				++inst->player_count;
+			}
+		}
+		for (obj = ROOM_CONTENTS(inst->room[iter]); obj; obj = obj->next_content) {
+			adjust_instance_count(&inst->obj_counts, GET_OBJ_VNUM(obj), 1);
+		}
+		LL_FOREACH2(ROOM_VEHICLES(inst->room[iter]), veh, next_in_room) {
+			adjust_instance_count(&inst->vehicle_counts, VEH_VNUM(veh), 1);
+		}
+	}
 }
 
 
@@ -1464,20 +1689,14 @@ int count_mobs_in_instance(struct instance_data *inst, mob_vnum vnum) {
 * @return int Total number of that obj (on the ground) in the instance.
 */
 int count_objs_in_instance(struct instance_data *inst, obj_vnum vnum) {
-	int iter, count = 0;
-	obj_data *obj;
+	struct instance_mob *im;
 	
-	for (iter = 0; iter < inst->size; ++iter) {
-		if (inst->room[iter]) {
-			for (obj = ROOM_CONTENTS(inst->room[iter]); obj; obj = obj->next_content) {
-				if (GET_OBJ_VNUM(obj) == vnum) {
-					++count;
-				}
-			}
-		}
+	if (!inst || vnum == NOTHING) {
+		return 0;
 	}
 	
-	return count;
+	HASH_FIND_INT(inst->obj_counts, &vnum, im);
+	return im ? im->count : 0;
 }
 
 
@@ -1491,6 +1710,11 @@ int count_players_in_instance(struct instance_data *inst, bool count_imms, char_
 	int iter, count = 0;
 	char_data *ch;
 	
+	// player_count includes everyone, so only the imm/ignore_ch cases need a closer look
+	if (inst->player_count <= 0 || (count_imms && !ignore_ch)) {
+		return MAX(0, inst->player_count);
+	}
+	
 	for (iter = 0; iter < inst->size; ++iter) {
 		if (inst->room[iter]) {
 			for (ch = ROOM_PEOPLE(inst->room[iter]); ch; ch = ch->next_in_room) {
@@ -1511,20 +1735,14 @@ int count_players_in_instance(struct instance_data *inst, bool count_imms, char_
 * @return int Total number of that vehicle in the instance.
 */
 int count_vehicles_in_instance(struct instance_data *inst, any_vnum vnum) {
-	int iter, count = 0;
-	vehicle_data *veh;
+	struct instance_mob *im;
 	
-	for (iter = 0; iter < inst->size; ++iter) {
-		if (inst->room[iter]) {
-			LL_FOREACH2(ROOM_VEHICLES(inst->room[iter]), veh, next_in_room) {
-				if (VEH_VNUM(veh) == vnum) {
-					++count;
-				}
-			}
-		}
+	if (!inst || vnum == NOTHING) {
+		return 0;
 	}
 	
-	return count;
+	HASH_FIND_INT(inst->vehicle_counts, &vnum, im);
+	return im ? im->count : 0;
 }
 
 
@@ -1608,13 +1826,8 @@ room_data *find_room_template_in_instance(struct instance_data *inst, rmt_vnum v
 struct instance_data *get_instance_by_id(any_vnum instance_id) {
 	struct instance_data *inst;
 	
-	for (inst = instance_list; inst; inst = inst->next) {
-		if (inst->id == instance_id) {
-			return inst;
-		}
-	}
-	
-	return NULL;
+	HASH_FIND_INT(instance_table, &instance_id, inst);
+	return inst;
 }
 
 
@@ -1714,12 +1927,8 @@ any_vnum get_new_instance_id(void) {
 	if (top_id >= MAX_INT) {
 		// need to find a lower id available: this only fails if there are more than MAX_INT instances
 		for (top_id = 0;; ++top_id) {
-			found = FALSE;
-			for (inst = instance_list; inst && !found; inst = inst->next) {
-				if (inst->id == top_id) {
-					found = TRUE;
-				}
-			}
+			HASH_FIND_INT(instance_table, &top_id, inst);
+			found = (inst != NULL);
 			
 			if (!found) {
 				break;
@@ -1743,13 +1952,8 @@ struct instance_data *real_instance(any_vnum instance_id) {
 		return NULL;
 	}
 	
-	for (inst = instance_list; inst; inst = inst->next) {
-		if (inst->id == instance_id) {
-			return inst;
-		}
-	}
-	
-	return NULL;
+	HASH_FIND_INT(instance_table, &instance_id, inst);
+	return inst;
 }
 
 
@@ -1760,20 +1964,8 @@ struct instance_data *real_instance(any_vnum instance_id) {
 * @param mob_vnum vnum Which mob vnum to subtract.
 */
 void subtract_instance_mob(struct instance_data *inst, mob_vnum vnum) {
-	struct instance_mob *im;
-	
-	if (!inst || vnum == NOTHING) {
-		return;
-	}
-	
-	// find
-	HASH_FIND_INT(inst->mob_counts, &vnum, im);
-	if (im) {
-		im->count -= 1;
-		if (im->count <= 0) {
-			HASH_DEL(inst->mob_counts, im);
-			free(im);
-		}
+	if (inst) {
+		adjust_instance_count(&inst->mob_counts, vnum, -1);
 	}
 }
 
@@ -1991,6 +2183,9 @@ static void renum_instances(void) {
 			}
 		}
 		
+		// anything already in the rooms wasn't counted yet
+		recount_instance_contents(inst);
+		
 		// check bad instance
 		if (!inst->location || !inst->start) {
 			delete_instance(inst);
@@ -2024,6 +2219,13 @@ void load_instances(void) {
 				instance_list = inst;
 			}
 			last_inst = inst;
+			
+			if (real_instance(inst->id)) {
+				log("SYSERR: Duplicate instance id %d", inst->id);
+			}
+			else {
+				HASH_ADD_INT(instance_table, id, inst);
+			}
 		}
 		else if (*line == '$') {
 			// done;
@@ -1264,7 +1264,7 @@ void free_alias(struct alias_data *a) {
 #define NUM_TOKENS       9
 
 void perform_complex_alias(struct txt_q *input_q, char *orig, struct alias_data *a) {
-	struct txt_q temp_queue;
+	static struct txt_q temp_queue;	// kept between calls so its buffers are reused
 	char *tokens[NUM_TOKENS], *temp, *write_point;
 	int num_of_tokens = 0, num;
 
@@ -1279,7 +1279,6 @@ void perform_complex_alias(struct txt_q *input_q, char *orig, struct alias_data
 
 	/* initialize */
 	write_point = buf;
-	temp_queue.head = temp_queue.tail = NULL;
 
 	/* now parse the alias */
 	for (temp = a->replacement; *temp; temp++) {
@@ -1314,12 +1313,7 @@ void perform_complex_alias(struct txt_q *input_q, char *orig, struct alias_data
 	write_to_q(buf, &temp_queue, 1, FALSE);
 
 	/* push our temp_queue on to the _front_ of the input queue */
-	if (input_q->head == NULL)
-		*input_q = temp_queue;
-	else {
-		temp_queue.tail->next = input_q->head;
-		input_q->head = temp_queue.head;
-	}
+	prepend_q(input_q, &temp_queue);
 }
 
 
@@ -2204,7 +2198,7 @@ void nanny(descriptor_data *d, char *arg) {
 	switch (STATE(d)) {
 		case CON_GET_NAME: {	/* wait for input of name */
 			if (d->character == NULL) {
-				CREATE(d->character, char_data, 1);
+				CREATE_SLAB(d->character, char_data, SLAB_CHAR);
 				clear_char(d->character);
 				init_player_specials(d->character);
 				d->character->desc = d;
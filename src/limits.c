@@ -30,6 +30,7 @@
 *   Character Limits
 *   Empire Limits
 *   Object Limits
+*   Object Timers
 *   Room Limits
 *   Vehicle Limits
 *   Miscellaneous Limits
@@ -53,12 +54,31 @@ extern struct instance_data *get_instance_by_id(any_vnum instance_id);
 extern room_data *obj_room(obj_data *obj);
 void out_of_blood(char_data *ch);
 void perform_abandon_city(empire_data *emp, struct empire_city_data *city, bool full_abandon);
+void schedule_fire_brigade(room_data *home);
 void stop_room_action(room_data *room, int action, int chore);
 
 // locals
+static void add_obj_to_timer_wheel(obj_data *obj, long when);
 int health_gain(char_data *ch, bool info_only);
 int mana_gain(char_data *ch, bool info_only);
 int move_gain(char_data *ch, bool info_only);
+static long obj_timer_fire_tick(obj_data *obj, long earliest);
+
+// The decay timer wheel: running object timers are filed under the tick on
+// which they next need attention, so a point update only touches items that
+// are due. Each level has 256 slots; level 0 covers the next 256 ticks and
+// each level above it covers 256 times as much.
+#define OBJ_TIMER_WHEEL_BITS  8
+#define OBJ_TIMER_WHEEL_SIZE  (1 << OBJ_TIMER_WHEEL_BITS)
+#define OBJ_TIMER_WHEEL_MASK  (OBJ_TIMER_WHEEL_SIZE - 1)
+#define OBJ_TIMER_WHEEL_LEVELS  3
+#define OBJ_TIMER_WHEEL_SPAN(level)  (1L << (OBJ_TIMER_WHEEL_BITS * (level)))	// ticks covered by 1 slot at that level
+
+// local file scope variables
+static obj_data *obj_timer_wheel[OBJ_TIMER_WHEEL_LEVELS][OBJ_TIMER_WHEEL_SIZE];
+static long obj_timer_tick = 0;	// point updates since startup; object timers count against this
+static obj_data *autostore_queue = NULL;	// items on the ground (or in containers on the ground)
+static obj_data *autostore_queue_next = NULL;	// saved 'next' while iterating the autostore queue
 
 
  //////////////////////////////////////////////////////////////////////////////
@@ -456,9 +476,9 @@ void point_update_char(char_data *ch) {
 	}
 	
 	// check spawned
-	if (REAL_NPC(ch) && !ch->desc && MOB_FLAGGED(ch, MOB_SPAWNED) && (!MOB_FLAGGED(ch, MOB_ANIMAL) || !room_has_function_and_city_ok(IN_ROOM(ch), FNC_STABLE)) && MOB_SPAWN_TIME(ch) < (time(0) - config_get_int("mob_spawn_interval") * SECS_PER_REAL_MIN)) {
+	if (REAL_NPC(ch) && !ch->desc && MOB_FLAGGED(ch, MOB_SPAWNED) && (!MOB_FLAGGED(ch, MOB_ANIMAL) || !room_has_function_and_city_ok(IN_ROOM(ch), FNC_STABLE)) && MOB_SPAWN_TIME(ch) < (time(0) - CONFIG_INT(CONF_MOB_SPAWN_INTERVAL) * SECS_PER_REAL_MIN)) {
 		if (!GET_LED_BY(ch) && !GET_LEADING_MOB(ch) && !GET_LEADING_VEHICLE(ch) && !MOB_FLAGGED(ch, MOB_TIED)) {
-			if (distance_to_nearest_player(IN_ROOM(ch)) > config_get_int("mob_despawn_radius")) {
+			if (distance_to_nearest_player(IN_ROOM(ch)) > CONFIG_INT(CONF_MOB_DESPAWN_RADIUS)) {
 				despawn_mob(ch);
 				return;
 			}
@@ -621,6 +641,11 @@ void real_update_char(char_data *ch) {
 		apply_dot_effect(ch, ATYPE_NATURE_BURN, 6, DAM_MAGICAL, 5, 60, ch);
 	}
 	
+	// durations shown over MSDP change every update
+	if (ch->affected || ch->over_time_effects) {
+		MSDP_DIRTY(ch, MSDP_DIRTY_AFFECTS);
+	}
+	
 	// update affects (NPCs get this, too)
 	for (af = ch->affected; af; af = next_af) {
 		next_af = af->next;
@@ -1355,24 +1380,27 @@ bool check_autostore(obj_data *obj, bool force) {
 
 
 /**
-* This runs a point update (every tick) on an object.
+* Called by the timer wheel when an item's decay timer needs attention: this
+* sends light messages as the timer runs low, and decays the item when it
+* runs out. The item must already be unlinked from its wheel slot, and is
+* either re-linked or no longer running a timer when this returns.
 *
-* @param obj_data *obj The object to update.
+* @param obj_data *obj The item whose timer is due.
 */
-void point_update_obj(obj_data *obj) {
-	room_data *to_room, *obj_r;
+static void run_obj_timer(obj_data *obj) {
+	room_data *obj_r;
 	obj_data *top;
-	char_data *c;
-	time_t timer;
 	
-	// ensure this obj is actually in-game
+	// ensure this obj is actually in-game -- if not, its timer doesn't count down
 	top = get_top_object(obj);
 	if ((top->carried_by && !IN_ROOM(top->carried_by)) || (top->worn_by && !IN_ROOM(top->worn_by))) {
+		obj->timer_expires += 1;
+		add_obj_to_timer_wheel(obj, obj_timer_tick + 1);
 		return;
 	}
-
+	
 	if (OBJ_FLAGGED(obj, OBJ_LIGHT)) {
-		if (GET_OBJ_TIMER(obj) == 2) {
+		if (GET_OBJ_TIMER(obj) == 1) {
 			if (obj->worn_by) {
 				act("Your light begins to flicker and fade.", FALSE, obj->worn_by, obj, 0, TO_CHAR);
 				act("$n's light begins to flicker and fade.", TRUE, obj->worn_by, obj, 0, TO_ROOM);
@@ -1383,7 +1411,7 @@ void point_update_obj(obj_data *obj) {
 				if (ROOM_PEOPLE(IN_ROOM(obj)))
 					act("$p begins to flicker and fade.", FALSE, ROOM_PEOPLE(IN_ROOM(obj)), obj, 0, TO_CHAR | TO_ROOM);
 		}
-		else if (GET_OBJ_TIMER(obj) == 1) {
+		else if (GET_OBJ_TIMER(obj) == 0) {
 			if (obj->worn_by) {
 				act("Your light burns out.", FALSE, obj->worn_by, obj, 0, TO_CHAR);
 				act("$n's light burns out.", TRUE, obj->worn_by, obj, 0, TO_ROOM);
@@ -1397,7 +1425,139 @@ void point_update_obj(obj_data *obj) {
 			}
 		}
 	}
+	
+	if (GET_OBJ_TIMER(obj) > 0) {
+		// not expired yet (woke up early for a light message)
+		add_obj_to_timer_wheel(obj, obj_timer_fire_tick(obj, obj_timer_tick + 1));
+		return;
+	}
+	
+	// if a timer trigger blocks the decay, this will fire again next tick
+	add_obj_to_timer_wheel(obj, obj_timer_tick + 1);
+	obj_r = obj_room(obj);
+	
+	if (!timer_otrigger(obj) || obj_room(obj) != obj_r) {
+		return;
+	}
+	
+	if (IS_DRINK_CONTAINER(obj)) {
+		if (GET_DRINK_CONTAINER_CONTENTS(obj) > 0) {
+			if (obj->carried_by) {
+				act("$p has gone bad and you pour it out.", FALSE, obj->carried_by, obj, 0, TO_CHAR);
+			}
+			else if (obj->worn_by) {
+				act("$p has gone bad and you pour it out.", FALSE, obj->worn_by, obj, 0, TO_CHAR);
+			}
+		}
+		
+		GET_OBJ_VAL(obj, VAL_DRINK_CONTAINER_CONTENTS) = 0;
+		GET_OBJ_VAL(obj, VAL_DRINK_CONTAINER_TYPE) = 0;
+		
+		SET_OBJ_TIMER(obj, UNLIMITED);
+		
+		// do not extract
+	}
+	else {  // all others actually decay
+		switch (GET_OBJ_MATERIAL(obj)) {
+			case MAT_FLESH:
+				if (obj->carried_by)
+					act("$p decays in your hands.", FALSE, obj->carried_by, obj, 0, TO_CHAR);
+				else if (obj->worn_by)
+					act("$p decays in your hands.", FALSE, obj->worn_by, obj, 0, TO_CHAR);
+				else if (IN_ROOM(obj) && ROOM_PEOPLE(IN_ROOM(obj))) {
+					act("A quivering horde of maggots consumes $p.", TRUE, ROOM_PEOPLE(IN_ROOM(obj)), obj, 0, TO_ROOM);
+					act("A quivering horde of maggots consumes $p.", TRUE, ROOM_PEOPLE(IN_ROOM(obj)), obj, 0, TO_CHAR);
+				}
+				break;
+			case MAT_IRON:
+				if (obj->carried_by)
+					act("$p rusts in your hands.", FALSE, obj->carried_by, obj, 0, TO_CHAR);
+				else if (obj->worn_by)
+					act("$p rusts in your hands.", FALSE, obj->worn_by, obj, 0, TO_CHAR);
+				else if (IN_ROOM(obj) && ROOM_PEOPLE(IN_ROOM(obj))) {
+					act("$p rusts and disintegrates.", TRUE, ROOM_PEOPLE(IN_ROOM(obj)), obj, 0, TO_ROOM);
+					act("$p rusts and disintegrates.", TRUE, ROOM_PEOPLE(IN_ROOM(obj)), obj, 0, TO_CHAR);
+				}
+				break;
+			case MAT_ROCK:
+			case MAT_FLINT:
+				if (obj->carried_by)
+					act("$p disintegrates in your hands.", FALSE, obj->carried_by, obj, 0, TO_CHAR);
+				else if (obj->worn_by)
+					act("$p disintegrates in your hands.", FALSE, obj->worn_by, obj, 0, TO_CHAR);
+				else if (IN_ROOM(obj) && ROOM_PEOPLE(IN_ROOM(obj))) {
+					act("$p disintegrates.", TRUE, ROOM_PEOPLE(IN_ROOM(obj)), obj, 0, TO_ROOM);
+					act("$p disintegrates.", TRUE, ROOM_PEOPLE(IN_ROOM(obj)), obj, 0, TO_CHAR);
+				}
+				break;
+			case MAT_GOLD:
+			case MAT_SILVER:
+			case MAT_COPPER:
+			case MAT_CLAY:
+				if (obj->carried_by)
+					act("$p cracks and disintegrates in your hands.", FALSE, obj->carried_by, obj, 0, TO_CHAR);
+				else if (obj->worn_by)
+					act("$p cracks and disintegrates in your hands.", FALSE, obj->worn_by, obj, 0, TO_CHAR);
+				else if (IN_ROOM(obj) && ROOM_PEOPLE(IN_ROOM(obj))) {
+					act("$p cracks and disintegrates.", TRUE, ROOM_PEOPLE(IN_ROOM(obj)), obj, 0, TO_ROOM);
+					act("$p cracks and disintegrates.", TRUE, ROOM_PEOPLE(IN_ROOM(obj)), obj, 0, TO_CHAR);
+				}
+				break;
+			case MAT_MAGIC:
+				if (obj->carried_by)
+					act("$p flickers briefly in your hands, then vanishes with a poof.", FALSE, obj->carried_by, obj, 0, TO_CHAR);
+				else if (obj->worn_by)
+					act("$p flickers briefly in your hands, then vanishes with a poof.", FALSE, obj->worn_by, obj, 0, TO_CHAR);
+				else if (IN_ROOM(obj) && ROOM_PEOPLE(IN_ROOM(obj))) {
+					act("$p flickers briefly, then vanishes with a poof.", TRUE, ROOM_PEOPLE(IN_ROOM(obj)), obj, 0, TO_ROOM);
+					act("$p flickers briefly, then vanishes with a poof.", TRUE, ROOM_PEOPLE(IN_ROOM(obj)), obj, 0, TO_CHAR);
+				}
+				break;
+			case MAT_WAX: {
+				if (obj->carried_by)
+					act("$p melts in your hands and is gone.", FALSE, obj->carried_by, obj, 0, TO_CHAR);
+				else if (obj->worn_by)
+					act("$p melts off of you and is gone.", FALSE, obj->worn_by, obj, 0, TO_CHAR);
+				else if (IN_ROOM(obj) && ROOM_PEOPLE(IN_ROOM(obj))) {
+					act("$p melts and is gone.", TRUE, ROOM_PEOPLE(IN_ROOM(obj)), obj, 0, TO_ROOM);
+					act("$p melts and is gone.", TRUE, ROOM_PEOPLE(IN_ROOM(obj)), obj, 0, TO_CHAR);
+				}
+				break;
+			}
+			case MAT_WOOD:
+			case MAT_BONE:
+			case MAT_HAIR:
+			default:
+				if (obj->carried_by)
+					act("$p rots in your hands.", FALSE, obj->carried_by, obj, 0, TO_CHAR);
+				else if (obj->worn_by)
+					act("$p rots in your hands.", FALSE, obj->worn_by, obj, 0, TO_CHAR);
+				else if (IN_ROOM(obj) && ROOM_PEOPLE(IN_ROOM(obj))) {
+					act("$p rots and disintegrates.", TRUE, ROOM_PEOPLE(IN_ROOM(obj)), obj, 0, TO_ROOM);
+					act("$p rots and disintegrates.", TRUE, ROOM_PEOPLE(IN_ROOM(obj)), obj, 0, TO_CHAR);
+				}
+				break;
+		}
+
+		empty_obj_before_extract(obj);
+		extract_obj(obj);
+		return;
+	} // end non-drink decay
+}
+
 
+/**
+* This runs a point update (every tick) on an item on the ground, or in a
+* container on the ground. Only items in the autostore queue get this; decay
+* timers are handled separately by the timer wheel.
+*
+* @param obj_data *obj The object to update.
+*/
+void point_update_obj(obj_data *obj) {
+	room_data *to_room;
+	char_data *c;
+	time_t timer;
+	
 	// float or sink
 	if (IN_ROOM(obj) && CAN_WEAR(obj, ITEM_WEAR_TAKE) && ROOM_SECT_FLAGGED(IN_ROOM(obj), SECTF_FRESH_WATER | SECTF_OCEAN)) {
 		if (materials[GET_OBJ_MATERIAL(obj)].floats && (to_room = real_shift(IN_ROOM(obj), shift_dir[WEST][0], shift_dir[WEST][1]))) {
@@ -1433,124 +1593,7 @@ void point_update_obj(obj_data *obj) {
 		}
 	}
 
-	/* timer count down */
-	if (GET_OBJ_TIMER(obj) > 0) {
-		GET_OBJ_TIMER(obj)--;
-	}
-
-	if (GET_OBJ_TIMER(obj) == 0) {
-		obj_r = obj_room(obj);
-		
-		if (!timer_otrigger(obj) || obj_room(obj) != obj_r) {
-			return;
-		}
-		
-		if (IS_DRINK_CONTAINER(obj)) {
-			if (GET_DRINK_CONTAINER_CONTENTS(obj) > 0) {
-				if (obj->carried_by) {
-					act("$p has gone bad and you pour it out.", FALSE, obj->carried_by, obj, 0, TO_CHAR);
-				}
-				else if (obj->worn_by) {
-					act("$p has gone bad and you pour it out.", FALSE, obj->worn_by, obj, 0, TO_CHAR);
-				}
-			}
-			
-			GET_OBJ_VAL(obj, VAL_DRINK_CONTAINER_CONTENTS) = 0;
-			GET_OBJ_VAL(obj, VAL_DRINK_CONTAINER_TYPE) = 0;
-			
-			GET_OBJ_TIMER(obj) = UNLIMITED;
-			
-			// do not extract
-		}
-		else {  // all others actually decay
-			switch (GET_OBJ_MATERIAL(obj)) {
-				case MAT_FLESH:
-					if (obj->carried_by)
-						act("$p decays in your hands.", FALSE, obj->carried_by, obj, 0, TO_CHAR);
-					else if (obj->worn_by)
-						act("$p decays in your hands.", FALSE, obj->worn_by, obj, 0, TO_CHAR);
-					else if (IN_ROOM(obj) && ROOM_PEOPLE(IN_ROOM(obj))) {
-						act("A quivering horde of maggots consumes $p.", TRUE, ROOM_PEOPLE(IN_ROOM(obj)), obj, 0, TO_ROOM);
-						act("A quivering horde of maggots consumes $p.", TRUE, ROOM_PEOPLE(IN_ROOM(obj)), obj, 0, TO_CHAR);
-					}
-					break;
-				case MAT_IRON:
-					if (obj->carried_by)
-						act("$p rusts in your hands.", FALSE, obj->carried_by, obj, 0, TO_CHAR);
-					else if (obj->worn_by)
-						act("$p rusts in your hands.", FALSE, obj->worn_by, obj, 0, TO_CHAR);
-					else if (IN_ROOM(obj) && ROOM_PEOPLE(IN_ROOM(obj))) {
-						act("$p rusts and disintegrates.", TRUE, ROOM_PEOPLE(IN_ROOM(obj)), obj, 0, TO_ROOM);
-						act("$p rusts and disintegrates.", TRUE, ROOM_PEOPLE(IN_ROOM(obj)), obj, 0, TO_CHAR);
-					}
-					break;
-				case MAT_ROCK:
-				case MAT_FLINT:
-					if (obj->carried_by)
-						act("$p disintegrates in your hands.", FALSE, obj->carried_by, obj, 0, TO_CHAR);
-					else if (obj->worn_by)
-						act("$p disintegrates in your hands.", FALSE, obj->worn_by, obj, 0, TO_CHAR);
-					else if (IN_ROOM(obj) && ROOM_PEOPLE(IN_ROOM(obj))) {
-						act("$p disintegrates.", TRUE, ROOM_PEOPLE(IN_ROOM(obj)), obj, 0, TO_ROOM);
-						act("$p disintegrates.", TRUE, ROOM_PEOPLE(IN_ROOM(obj)), obj, 0, TO_CHAR);
-					}
-					break;
-				case MAT_GOLD:
-				case MAT_SILVER:
-				case MAT_COPPER:
-				case MAT_CLAY:
-					if (obj->carried_by)
-						act("$p cracks and disintegrates in your hands.", FALSE, obj->carried_by, obj, 0, TO_CHAR);
-					else if (obj->worn_by)
-						act("$p cracks and disintegrates in your hands.", FALSE, obj->worn_by, obj, 0, TO_CHAR);
-					else if (IN_ROOM(obj) && ROOM_PEOPLE(IN_ROOM(obj))) {
-						act("$p cracks and disintegrates.", TRUE, ROOM_PEOPLE(IN_ROOM(obj)), obj, 0, TO_ROOM);
-						act("$p cracks and disintegrates.", TRUE, ROOM_PEOPLE(IN_ROOM(obj)), obj, 0, TO_CHAR);
-					}
-					break;
-				case MAT_MAGIC:
-					if (obj->carried_by)
-						act("$p flickers briefly in your hands, then vanishes with a poof.", FALSE, obj->carried_by, obj, 0, TO_CHAR);
-					else if (obj->worn_by)
-						act("$p flickers briefly in your hands, then vanishes with a poof.", FALSE, obj->worn_by, obj, 0, TO_CHAR);
-					else if (IN_ROOM(obj) && ROOM_PEOPLE(IN_ROOM(obj))) {
-						act("$p flickers briefly, then vanishes with a poof.", TRUE, ROOM_PEOPLE(IN_ROOM(obj)), obj, 0, TO_ROOM);
-						act("$p flickers briefly, then vanishes with a poof.", TRUE, ROOM_PEOPLE(IN_ROOM(obj)), obj, 0, TO_CHAR);
-					}
-					break;
-				case MAT_WAX: {
-					if (obj->carried_by)
-						act("$p melts in your hands and is gone.", FALSE, obj->carried_by, obj, 0, TO_CHAR);
-					else if (obj->worn_by)
-						act("$p melts off of you and is gone.", FALSE, obj->worn_by, obj, 0, TO_CHAR);
-					else if (IN_ROOM(obj) && ROOM_PEOPLE(IN_ROOM(obj))) {
-						act("$p melts and is gone.", TRUE, ROOM_PEOPLE(IN_ROOM(obj)), obj, 0, TO_ROOM);
-						act("$p melts and is gone.", TRUE, ROOM_PEOPLE(IN_ROOM(obj)), obj, 0, TO_CHAR);
-					}
-					break;
-				}
-				case MAT_WOOD:
-				case MAT_BONE:
-				case MAT_HAIR:
-				default:
-					if (obj->carried_by)
-						act("$p rots in your hands.", FALSE, obj->carried_by, obj, 0, TO_CHAR);
-					else if (obj->worn_by)
-						act("$p rots in your hands.", FALSE, obj->worn_by, obj, 0, TO_CHAR);
-					else if (IN_ROOM(obj) && ROOM_PEOPLE(IN_ROOM(obj))) {
-						act("$p rots and disintegrates.", TRUE, ROOM_PEOPLE(IN_ROOM(obj)), obj, 0, TO_ROOM);
-						act("$p rots and disintegrates.", TRUE, ROOM_PEOPLE(IN_ROOM(obj)), obj, 0, TO_CHAR);
-					}
-					break;
-			}
-
-			empty_obj_before_extract(obj);
-			extract_obj(obj);
-			return;
-		} // end non-drink decay
-	}
-	
-	// 2nd type of timer: the autostore timer (keeps the world clean of litter)
+	// the autostore timer (keeps the world clean of litter)
 	if (!check_autostore(obj, FALSE)) {
 		return;
 	}
@@ -1582,6 +1625,8 @@ void real_update_obj(obj_data *obj) {
 				if (!emp || (enemy && (pol = find_relation(enemy, emp)) && IS_SET(pol->type, DIPL_WAR))) {
 					// TODO magic number -- this should be a config
 					COMPLEX_DATA(home)->burning = number(4, 12);
+					schedule_room_updates(home);
+					schedule_fire_brigade(home);
 					if (ROOM_PEOPLE(home)) {
 						act("A stray ember from $p ignites the room!", FALSE, ROOM_PEOPLE(home), obj, 0, TO_CHAR | TO_ROOM);
 
@@ -1596,6 +1641,248 @@ void real_update_obj(obj_data *obj) {
 }
 
 
+ //////////////////////////////////////////////////////////////////////////////
+//// OBJECT TIMERS ///////////////////////////////////////////////////////////
+
+/**
+* Gets an item's decay timer. Running timers are stored as the timer wheel
+* tick they expire on, and are converted back to ticks-remaining here.
+*
+* @param obj_data *obj The item.
+* @return int The number of ticks left, or UNLIMITED.
+*/
+int GET_OBJ_TIMER(obj_data *obj) {
+	if (obj->timer_running) {
+		return MAX(0, obj->timer_expires - obj_timer_tick);
+	}
+	return obj->obj_flags.timer;
+}
+
+
+/**
+* Sets an item's decay timer, and (re)schedules it in the timer wheel if the
+* item is in the object list.
+*
+* @param obj_data *obj The item.
+* @param int timer The number of ticks until it decays, or UNLIMITED.
+*/
+void SET_OBJ_TIMER(obj_data *obj, int timer) {
+	cancel_obj_timer(obj);
+	obj->obj_flags.timer = timer;
+	schedule_obj_timer(obj);
+}
+
+
+/**
+* Determines which tick an item in the timer wheel next needs to be looked at
+* on: this is when the timer expires, or 1 tick earlier for lights (which
+* send a warning message).
+*
+* @param obj_data *obj The item, which must have a running timer.
+* @param long earliest The soonest tick it's allowed to fire on.
+* @return long The tick to fire on.
+*/
+static long obj_timer_fire_tick(obj_data *obj, long earliest) {
+	long when = obj->timer_expires;
+	
+	if (OBJ_FLAGGED(obj, OBJ_LIGHT) && when - 1 >= earliest) {
+		--when;
+	}
+	
+	return MAX(when, earliest);
+}
+
+
+/**
+* Links an item into the timer wheel slot for a given tick. Ticks too far in
+* the future are parked in the last slot that can hold them, and are re-filed
+* when that slot cascades.
+*
+* @param obj_data *obj The item (must not already be in a wheel slot).
+* @param long when The tick to fire on, which must not be in the past.
+*/
+static void add_obj_to_timer_wheel(obj_data *obj, long when) {
+	int level;
+	
+	if (when - obj_timer_tick >= OBJ_TIMER_WHEEL_SPAN(OBJ_TIMER_WHEEL_LEVELS)) {
+		when = obj_timer_tick + OBJ_TIMER_WHEEL_SPAN(OBJ_TIMER_WHEEL_LEVELS) - 1;
+	}
+	
+	// find the lowest level that reaches that far
+	for (level = 0; level < OBJ_TIMER_WHEEL_LEVELS - 1; ++level) {
+		if (when - obj_timer_tick < OBJ_TIMER_WHEEL_SPAN(level + 1)) {
+			break;
+		}
+	}
+	
+	obj->timer_level = level;
+	obj->timer_slot = (when / OBJ_TIMER_WHEEL_SPAN(level)) & OBJ_TIMER_WHEEL_MASK;
+	DL_APPEND2(obj_timer_wheel[level][obj->timer_slot], obj, timer_prev, timer_next);
+	obj->timer_queued = TRUE;
+}
+
+
+/**
+* Unlinks an item from its timer wheel slot, if it's in one. This does not
+* stop the timer.
+*
+* @param obj_data *obj The item.
+*/
+static void remove_obj_from_timer_wheel(obj_data *obj) {
+	if (obj->timer_queued) {
+		DL_DELETE2(obj_timer_wheel[obj->timer_level][obj->timer_slot], obj, timer_prev, timer_next);
+		obj->timer_prev = obj->timer_next = NULL;
+		obj->timer_queued = FALSE;
+	}
+}
+
+
+/**
+* Stops an item's decay timer from running (e.g. when it leaves the object
+* list) and stores the remaining ticks back on the item.
+*
+* @param obj_data *obj The item.
+*/
+void cancel_obj_timer(obj_data *obj) {
+	if (obj->timer_running) {
+		obj->obj_flags.timer = GET_OBJ_TIMER(obj);
+		obj->timer_running = FALSE;
+	}
+	remove_obj_from_timer_wheel(obj);
+}
+
+
+/**
+* Starts an item's decay timer running in the timer wheel, if it has one. This
+* only applies to items in the object list.
+*
+* @param obj_data *obj The item.
+*/
+void schedule_obj_timer(obj_data *obj) {
+	if (!obj->in_object_list || obj->timer_running || obj->obj_flags.timer < 0) {
+		return;	// not in the world, already running, or UNLIMITED
+	}
+	
+	// a timer of 0 decays on the next tick, just like a timer of 1
+	obj->timer_expires = obj_timer_tick + MAX(1, obj->obj_flags.timer);
+	obj->timer_running = TRUE;
+	add_obj_to_timer_wheel(obj, obj_timer_fire_tick(obj, obj_timer_tick + 1));
+}
+
+
+/**
+* Advances the timer wheel by 1 tick and runs any object timers that are due.
+* This is called once per point update (mud hour).
+*/
+static void run_obj_timer_wheel(void) {
+	obj_data *obj;
+	int level, slot;
+	
+	++obj_timer_tick;
+	
+	// cascade: each level's next slot comes due when the level below it wraps
+	for (level = 1; level < OBJ_TIMER_WHEEL_LEVELS; ++level) {
+		if (obj_timer_tick % OBJ_TIMER_WHEEL_SPAN(level)) {
+			break;
+		}
+		
+		slot = (obj_timer_tick / OBJ_TIMER_WHEEL_SPAN(level)) & OBJ_TIMER_WHEEL_MASK;
+		while ((obj = obj_timer_wheel[level][slot])) {
+			remove_obj_from_timer_wheel(obj);
+			add_obj_to_timer_wheel(obj, obj_timer_fire_tick(obj, obj_timer_tick));
+		}
+	}
+	
+	// and fire everything in this tick's slot
+	slot = obj_timer_tick & OBJ_TIMER_WHEEL_MASK;
+	while ((obj = obj_timer_wheel[0][slot])) {
+		remove_obj_from_timer_wheel(obj);
+		run_obj_timer(obj);
+	}
+}
+
+
+/**
+* Determines if an item belongs in the autostore queue: this is anything on
+* the ground, plus takeable items in containers on the ground. Items in
+* vehicles are handled by the vehicle's own autostore.
+*
+* @param obj_data *obj The item.
+* @return bool TRUE if it should be in the queue.
+*/
+static bool wants_autostore_queue(obj_data *obj) {
+	if (!obj->in_object_list) {
+		return FALSE;
+	}
+	if (IN_ROOM(obj)) {
+		return TRUE;	// floats, sinks, burns, and stores
+	}
+	return (obj->in_obj && IN_ROOM(get_top_object(obj)) && CAN_WEAR(obj, ITEM_WEAR_TAKE));
+}
+
+
+/**
+* Adds an item to the autostore queue if it's somewhere that it could be
+* autostored, along with its contents (which may have left the queue while
+* the container was carried). Safe to call on items already in the queue.
+*
+* @param obj_data *obj The item that was just moved.
+*/
+void add_to_autostore_queue(obj_data *obj) {
+	obj_data *iter;
+	
+	if (!obj->in_autostore_queue && wants_autostore_queue(obj)) {
+		DL_APPEND2(autostore_queue, obj, autostore_prev, autostore_next);
+		obj->in_autostore_queue = TRUE;
+	}
+	
+	for (iter = obj->contains; iter; iter = iter->next_content) {
+		add_to_autostore_queue(iter);
+	}
+}
+
+
+/**
+* Removes an item from the autostore queue, if it's in it.
+*
+* @param obj_data *obj The item.
+*/
+void remove_from_autostore_queue(obj_data *obj) {
+	if (obj->in_autostore_queue) {
+		if (obj == autostore_queue_next) {
+			autostore_queue_next = obj->autostore_next;
+		}
+		DL_DELETE2(autostore_queue, obj, autostore_prev, autostore_next);
+		obj->autostore_prev = obj->autostore_next = NULL;
+		obj->in_autostore_queue = FALSE;
+	}
+}
+
+
+/**
+* Runs an update function on everything in the autostore queue, dropping any
+* items that no longer belong there (e.g. were picked up).
+*
+* @param void (*func)(obj_data *obj) The update to run on each item.
+*/
+static void update_autostore_queue(void (*func)(obj_data *obj)) {
+	obj_data *obj;
+	
+	for (obj = autostore_queue; obj; obj = autostore_queue_next) {
+		autostore_queue_next = obj->autostore_next;
+		
+		if (wants_autostore_queue(obj)) {
+			(func)(obj);
+		}
+		else {
+			remove_from_autostore_queue(obj);
+		}
+	}
+	
+	autostore_queue_next = NULL;
+}
+
+
  //////////////////////////////////////////////////////////////////////////////
 //// ROOM LIMITS /////////////////////////////////////////////////////////////
 
@@ -1612,6 +1899,7 @@ void point_update_room(room_data *room) {
 	obj_data *o, *next_o;
 	struct track_data *track, *next_track, *temp;
 	struct affected_type *af, *next_af;
+	room_data *iter;
 	empire_data *emp;
 	time_t now = time(0);
 	bool junk;
@@ -1702,13 +1990,13 @@ void point_update_room(room_data *room) {
 					act("The fire rages as the building burns!", FALSE, ROOM_PEOPLE(room), 0, 0, TO_CHAR | TO_ROOM);
 				}
 			}
-		}
-	}
-
-	// For remaining interior rooms, make sure everyone knows the place is crispy
-	if (GET_ROOM_VNUM(room) >= MAP_SIZE) {
-		if (HOME_ROOM(room) != room && BUILDING_BURNING(room) && ROOM_PEOPLE(room)) {
-			act("The walls crackle and crisp as they burn!", FALSE, ROOM_PEOPLE(room), 0, 0, TO_CHAR | TO_ROOM);
+			
+			// for interior rooms, make sure everyone knows the place is crispy
+			DL_FOREACH2(COMPLEX_DATA(room)->interior_rooms, iter, next_in_home) {
+				if (ROOM_PEOPLE(iter)) {
+					act("The walls crackle and crisp as they burn!", FALSE, ROOM_PEOPLE(iter), 0, 0, TO_CHAR | TO_ROOM);
+				}
+			}
 		}
 	}
 
@@ -1720,7 +2008,7 @@ void point_update_room(room_data *room) {
 		
 		if (now - track->timestamp > config_get_int("tracks_lifespan") * SECS_PER_REAL_MIN) {
 			REMOVE_FROM_LIST(track, ROOM_TRACKS(room), next);
-			free(track);
+			FREE_SLAB(SLAB_TRACK, track);
 		}
 	}
 	
@@ -2205,8 +2493,6 @@ void point_update(bool run_real) {
 	void update_players_online_stats();
 	
 	vehicle_data *veh, *next_veh;
-	room_data *room, *next_room;
-	obj_data *obj, *next_obj;
 	char_data *ch, *next_ch;
 	
 	long daily_cycle = data_get_long(DATA_DAILY_CYCLE);
@@ -2253,18 +2539,13 @@ void point_update(bool run_real) {
 		point_update_vehicle(veh);
 	}
 	
-	// objs
-	for (obj = object_list; obj; obj = next_obj) {
-		next_obj = obj->next;
-		
-		real_update_obj(obj);
-		point_update_obj(obj);
-	}
+	// objs: timers come due in the timer wheel; everything else is on the ground
+	run_obj_timer_wheel();
+	update_autostore_queue(real_update_obj);
+	update_autostore_queue(point_update_obj);
 	
-	// rooms
-	HASH_ITER(hh, world_table, room, next_room) {
-		point_update_room(room);
-	}
+	// rooms: only the ones in the world block update lists have anything to do
+	run_room_updates(NOTHING, FALSE, point_update_room);
 }
 
 
@@ -2273,7 +2554,6 @@ void point_update(bool run_real) {
 * affects.
 */
 void real_update(void) {
-	obj_data *obj, *next_obj;
 	char_data *ch, *next_ch;
 
 	// characters
@@ -2287,9 +2567,6 @@ void real_update(void) {
 		real_update_char(ch);
 	}
 
-	// objs
-	for (obj = object_list; obj; obj = next_obj) {
-		next_obj = obj->next;
-		real_update_obj(obj);
-	}
+	// objs: only items on the ground have anything to do here
+	update_autostore_queue(real_update_obj);
 }
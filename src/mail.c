@@ -180,7 +180,7 @@ ACMD(do_mail) {
 				GET_OBJ_LONG_DESC(obj) = str_dup("Someone has left a small letter here.");
 				GET_OBJ_TYPE(obj) = ITEM_MAIL;
 				GET_OBJ_WEAR(obj) = ITEM_WEAR_TAKE | ITEM_WEAR_HOLD;
-				GET_OBJ_TIMER(obj) = UNLIMITED;
+				SET_OBJ_TIMER(obj, UNLIMITED);
 				
 				index = find_player_index_by_idnum(mail->from);
 				tmstr = asctime(localtime(&mail->timestamp));
@@ -28,6 +28,8 @@
 * Contents:
 *   Data
 *   Helpers
+*   Map Icon Cache
+*   OOB Map Functions
 *   Mappc Functions
 *   Map View Functions
 *   Screen Reader Functions
@@ -61,6 +63,23 @@ struct mappc_data_container {
 };
 
 
+// map output is sent in chunks of about this many raw bytes, split at rows (color codes expand in ProtocolOutput)
+#define MAP_OUTPUT_CHUNK  (MAX_STRING_LENGTH / 4)
+#define MAP_TILE_BUFSIZE  256	// max raw length of one rendered tile
+#define MAP_OOB_MSG_SIZE  (MAX_VARIABLE_LENGTH - 64)	// max length of one MSDP MAP message, leaving room for the protocol wrapper
+
+// the tiles of one map view, each looked up once per look (including a border, for neighbors)
+struct map_view_grid {
+	room_data *origin;	// center of the view
+	int x_min, y_min;	// lowest offsets from origin in the grid
+	int width, height;	// size of the grid
+	room_data **rooms;	// width * height tiles (may be NULL)
+	bool *looked_up;	// TRUE once rooms[] has been filled in for that tile
+};
+
+int map_icon_cache_version = 0;	// cached map tiles from older versions are rebuilt (see clear_all_map_icon_caches)
+
+
 // external vars
 extern const int confused_dirs[NUM_2D_DIRS][2][NUM_OF_DIRS];
 extern const char *dirs[];
@@ -71,12 +90,64 @@ void replace_question_color(char *input, char *color, char *output);
 
 // locals
 ACMD(do_exits);
-static void show_map_to_char(char_data *ch, struct mappc_data_container *mappc, room_data *to_room, bitvector_t options);
+static void show_map_to_char(char_data *ch, struct mappc_data_container *mappc, struct map_view_grid *grid, int x_off, int y_off, bitvector_t options, char *output);
 
 
  //////////////////////////////////////////////////////////////////////////////
 //// HELPERS /////////////////////////////////////////////////////////////////
 
+/**
+* Adds text to a map being drawn, sending the buffered part to the character
+* whenever the next piece would make it too large for one write.
+*
+* @param char_data *ch The person looking.
+* @param char *frame The buffer (at least MAP_OUTPUT_CHUNK bytes).
+* @param size_t *frame_len The length of the text currently in the buffer.
+* @param const char *text The text to add (or NULL to just flush the buffer).
+*/
+static void add_map_output(char_data *ch, char *frame, size_t *frame_len, const char *text) {
+	size_t len = text ? strlen(text) : 0;
+	
+	if (*frame_len > 0 && (!text || *frame_len + len >= MAP_OUTPUT_CHUNK)) {
+		send_to_char(frame, ch);
+		*frame = '\0';
+		*frame_len = 0;
+	}
+	
+	if (len >= MAP_OUTPUT_CHUNK) {
+		send_to_char(text, ch);	// too big to buffer
+	}
+	else if (len > 0) {
+		strcpy(frame + *frame_len, text);
+		*frame_len += len;
+	}
+}
+
+
+/**
+* Gets a map tile by its offset from the center of a map view. Each tile is
+* only looked up once per view, so neighbors of neighbors come free.
+*
+* @param struct map_view_grid *grid The view's grid.
+* @param int x_off The x-offset from grid->origin.
+* @param int y_off The y-offset from grid->origin.
+* @return room_data* The room at that offset, or NULL if there is none.
+*/
+static room_data *map_view_room(struct map_view_grid *grid, int x_off, int y_off) {
+	int x = x_off - grid->x_min, y = y_off - grid->y_min;
+	
+	if (x < 0 || y < 0 || x >= grid->width || y >= grid->height) {
+		return real_shift(grid->origin, x_off, y_off);	// outside the grid
+	}
+	
+	if (!grid->looked_up[y * grid->width + x]) {
+		grid->rooms[y * grid->width + x] = real_shift(grid->origin, x_off, y_off);
+		grid->looked_up[y * grid->width + x] = TRUE;
+	}
+	return grid->rooms[y * grid->width + x];
+}
+
+
 
 /**
 * @param room_data *room The room to check.
@@ -192,7 +263,7 @@ int get_map_radius(char_data *ch) {
 		// auto-detected
 		if (ch->desc && ch->desc->pProtocol->ScreenWidth > 0) {
 			int wide = (ch->desc->pProtocol->ScreenWidth - 6) / 8;	// the /8 is 4 chars per tile, doubled
-			int max_size = config_get_int("max_map_size");
+			int max_size = CONFIG_INT(CONF_MAX_MAP_SIZE);
 			if (ch->desc->pProtocol->ScreenHeight > 0) {
 				// cap based on height, too (save some room)
 				// this saves roughly 4 lines below the map -- if you're going
@@ -204,15 +275,15 @@ int get_map_radius(char_data *ch) {
 			mapsize = MIN(wide, max_size);
 		}
 		else {
-			mapsize = config_get_int("default_map_size");
+			mapsize = CONFIG_INT(CONF_DEFAULT_MAP_SIZE);
 		}
 	}
 	
 	// automatically limit size if the player is moving too fast
 	if (mapsize > 5 && (recent = count_recent_moves(ch)) > 5) {
-		max = config_get_int("max_map_size") - (recent - 5);
+		max = CONFIG_INT(CONF_MAX_MAP_SIZE) - (recent - 5);
 		mapsize = MIN(mapsize, max);
-		smallmax = config_get_int("max_map_while_moving");
+		smallmax = CONFIG_INT(CONF_MAX_MAP_WHILE_MOVING);
 		mapsize = MAX(mapsize, smallmax);
 	}
 	
@@ -350,6 +421,262 @@ int pick_season(room_data *room) {
 }
 
 
+ //////////////////////////////////////////////////////////////////////////////
+//// MAP ICON CACHE //////////////////////////////////////////////////////////
+
+/**
+* Invalidates the cached icon for every map tile at once, e.g. when sector,
+* crop, or building icons are edited. Tiles are rebuilt as they are seen.
+*/
+void clear_all_map_icon_caches(void) {
+	++map_icon_cache_version;
+}
+
+
+/**
+* Frees the cached map icons on one room, if any.
+*
+* @param room_data *room The room to clear.
+*/
+static void free_map_icon_cache(room_data *room) {
+	int iter;
+	
+	if (room) {
+		for (iter = 0; iter < NUM_SIMPLE_DIRS; ++iter) {
+			if (room->map_icon[iter]) {
+				free(room->map_icon[iter]);
+				room->map_icon[iter] = NULL;
+			}
+		}
+	}
+}
+
+
+/**
+* Invalidates the cached map icon for a tile and its 8 neighbors (whose
+* roads and attachments may depend on it). Call this when anything that
+* shows in the tile's icon changes: terrain, crop, building, custom icon,
+* city, or the NO-FLY/CHAMELEON/INCOMPLETE/DISMANTLING flags.
+*
+* @param room_data *room The location that changed (optional, or provide map).
+* @param struct map_data *map The location that changed (optional, or provide room).
+*/
+void clear_map_icon_cache(room_data *room, struct map_data *map) {
+	int dir, x, y;
+	
+	if (room) {
+		free_map_icon_cache(room);
+	}
+	if (!map && room && GET_ROOM_VNUM(room) < MAP_SIZE) {
+		map = &(world_map[FLAT_X_COORD(room)][FLAT_Y_COORD(room)]);
+	}
+	if (!map) {
+		return;	// not on the map: nothing else to clear
+	}
+	
+	free_map_icon_cache(map->room);
+	for (dir = 0; dir < NUM_2D_DIRS; ++dir) {
+		if (get_coord_shift(MAP_X_COORD(map->vnum), MAP_Y_COORD(map->vnum), shift_dir[dir][0], shift_dir[dir][1], &x, &y)) {
+			free_map_icon_cache(world_map[x][y].room);
+		}
+	}
+}
+
+
+/**
+* Finds the cached map icon for a tile, if it's still good.
+*
+* @param room_data *room The map tile.
+* @param int tileset The tile's current pick_season().
+* @param int north The viewer's north (roads and attachments depend on it).
+* @return char* The tile, with its normal colors, or NULL if it is not cached.
+*/
+static char *get_map_icon_cache(room_data *room, int tileset, int north) {
+	if (!room->map_icon[north]) {
+		return NULL;
+	}
+	if (room->map_icon_tileset != tileset || room->map_icon_version != map_icon_cache_version) {
+		free_map_icon_cache(room);	// season rollover or icons edited
+		return NULL;
+	}
+	return room->map_icon[north];
+}
+
+
+/**
+* Stores the finished icon for a map tile.
+*
+* @param room_data *room The map tile.
+* @param int tileset The pick_season() it was built for.
+* @param int north The viewer's north it was built for.
+* @param char *icon The tile, with its normal colors.
+*/
+static void set_map_icon_cache(room_data *room, int tileset, int north, char *icon) {
+	if (room->map_icon_tileset != tileset || room->map_icon_version != map_icon_cache_version) {
+		free_map_icon_cache(room);	// any others are out of date
+	}
+	if (room->map_icon[north]) {
+		free(room->map_icon[north]);
+	}
+	room->map_icon[north] = str_dup(icon);
+	room->map_icon_tileset = tileset;
+	room->map_icon_version = map_icon_cache_version;
+}
+
+
+ //////////////////////////////////////////////////////////////////////////////
+//// OOB MAP FUNCTIONS ///////////////////////////////////////////////////////
+
+/**
+* The out-of-band map is sent as a series of MSDP "MAP" tables, so that a
+* client can draw it in its own window and only has to be told what changed:
+*
+*   MODE FULL, ROWS n, COLS n           - start of a new frame; discard the old one
+*   MODE SHIFT, ROWS n, COLS n, SHIFT_ROWS n, SHIFT_COLS n
+*                                       - start of a new frame: each spot now shows
+*                                         what [row + SHIFT_ROWS][col + SHIFT_COLS]
+*                                         showed in the last one
+*   MODE TILES, DATA [ "row,col,tile" ] - tiles to draw (all of them, on FULL)
+*   MODE END                            - the frame is complete
+*
+* Tiles are 4 characters wide and use the game's normal & color codes.
+*/
+
+
+/**
+* @param struct map_oob_frame *frame The frame to free.
+*/
+void free_map_oob_frame(struct map_oob_frame *frame) {
+	int iter;
+	
+	if (frame) {
+		if (frame->tiles) {
+			for (iter = 0; iter < frame->rows * frame->cols; ++iter) {
+				if (frame->tiles[iter]) {
+					free(frame->tiles[iter]);
+				}
+			}
+			free(frame->tiles);
+		}
+		if (frame->vnums) {
+			free(frame->vnums);
+		}
+		free(frame);
+	}
+}
+
+
+/**
+* @param char_data *ch The person looking at the map.
+* @return bool TRUE if ch's map should go out over MSDP instead of as text.
+*/
+static bool wants_oob_map(char_data *ch) {
+	return (ch->desc && PRF_FLAGGED(ch, PRF_OOB_MAP) && MSDPIsReported(ch->desc, eMSDP_MAP));
+}
+
+
+/**
+* Sends one MAP message with a list of tiles, e.g. MODE TILES.
+*
+* @param descriptor_data *desc The client.
+* @param char *data The MSDP array items (each starting with MSDP_VAL).
+*/
+static void send_map_oob_tiles(descriptor_data *desc, char *data) {
+	char msg[MAX_VARIABLE_LENGTH];
+	
+	snprintf(msg, sizeof(msg), "%cMODE%cTILES%cDATA%c%c%s%c", (char)MSDP_VAR, (char)MSDP_VAL, (char)MSDP_VAR, (char)MSDP_VAL, (char)MSDP_ARRAY_OPEN, data, (char)MSDP_ARRAY_CLOSE);
+	MSDPSendTable(desc, eMSDP_MAP, msg);
+}
+
+
+/**
+* Sends a map frame over MSDP. If the client already has the last frame and
+* this one only scrolled (the viewer moved), it gets the shift plus just the
+* tiles that scrolled into view or changed; otherwise it gets all of them.
+* The descriptor keeps the frame afterwards, to compare with the next one.
+*
+* @param descriptor_data *desc The client.
+* @param struct map_oob_frame *frame The new frame (the descriptor takes ownership).
+*/
+static void send_map_oob_frame(descriptor_data *desc, struct map_oob_frame *frame) {
+	struct map_oob_frame *last = desc->map_oob;
+	int iter, size, old_row, old_col, changed, shift_rows = 0, shift_cols = 0;
+	char msg[MAX_VARIABLE_LENGTH], data[MAX_VARIABLE_LENGTH], item[MAP_TILE_BUFSIZE + 32];
+	size_t data_len, item_len;
+	bool *send, full = TRUE;
+	
+	size = frame->rows * frame->cols;
+	CREATE(send, bool, size);
+	
+	// find the viewer's new tile in the last frame, to see how far the view scrolled
+	if (last && last->rows == frame->rows && last->cols == frame->cols && frame->vnums[frame->center] != NOWHERE) {
+		for (iter = 0; iter < size; ++iter) {
+			if (last->vnums[iter] == frame->vnums[frame->center]) {
+				shift_rows = (iter / last->cols) - (frame->center / frame->cols);
+				shift_cols = (iter % last->cols) - (frame->center % frame->cols);
+				full = FALSE;
+				break;
+			}
+		}
+	}
+	
+	// compare every tile to the one the client already has there
+	changed = 0;
+	for (iter = 0; iter < size && !full; ++iter) {
+		old_row = (iter / frame->cols) + shift_rows;
+		old_col = (iter % frame->cols) + shift_cols;
+		
+		if (old_row < 0 || old_row >= last->rows || old_col < 0 || old_col >= last->cols) {
+			send[iter] = TRUE;	// scrolled into view
+		}
+		else if (last->vnums[old_row * last->cols + old_col] != frame->vnums[iter]) {
+			full = TRUE;	// not a simple scroll (e.g. the viewer's north changed)
+		}
+		else if (strcmp(last->tiles[old_row * last->cols + old_col], frame->tiles[iter])) {
+			send[iter] = TRUE;	// tile changed
+		}
+		
+		if (send[iter] && ++changed > size / 2) {
+			full = TRUE;	// cheaper to start over
+		}
+	}
+	
+	// header
+	if (full) {
+		snprintf(msg, sizeof(msg), "%cMODE%cFULL%cROWS%c%d%cCOLS%c%d", (char)MSDP_VAR, (char)MSDP_VAL, (char)MSDP_VAR, (char)MSDP_VAL, frame->rows, (char)MSDP_VAR, (char)MSDP_VAL, frame->cols);
+	}
+	else {
+		snprintf(msg, sizeof(msg), "%cMODE%cSHIFT%cROWS%c%d%cCOLS%c%d%cSHIFT_ROWS%c%d%cSHIFT_COLS%c%d", (char)MSDP_VAR, (char)MSDP_VAL, (char)MSDP_VAR, (char)MSDP_VAL, frame->rows, (char)MSDP_VAR, (char)MSDP_VAL, frame->cols, (char)MSDP_VAR, (char)MSDP_VAL, shift_rows, (char)MSDP_VAR, (char)MSDP_VAL, shift_cols);
+	}
+	MSDPSendTable(desc, eMSDP_MAP, msg);
+	
+	// tiles, in as few messages as will fit
+	*data = '\0';
+	data_len = 0;
+	for (iter = 0; iter < size; ++iter) {
+		if (full || send[iter]) {
+			item_len = snprintf(item, sizeof(item), "%c%d,%d,%s", (char)MSDP_VAL, iter / frame->cols, iter % frame->cols, frame->tiles[iter]);
+			if (data_len + item_len > MAP_OOB_MSG_SIZE) {
+				send_map_oob_tiles(desc, data);
+				data_len = 0;
+			}
+			strcpy(data + data_len, item);
+			data_len += item_len;
+		}
+	}
+	if (data_len > 0) {
+		send_map_oob_tiles(desc, data);
+	}
+	
+	snprintf(msg, sizeof(msg), "%cMODE%cEND", (char)MSDP_VAR, (char)MSDP_VAL);
+	MSDPSendTable(desc, eMSDP_MAP, msg);
+	
+	free(send);
+	free_map_oob_frame(desc->map_oob);
+	desc->map_oob = frame;
+}
+
+
  //////////////////////////////////////////////////////////////////////////////
 //// MAPPC FUNCTIONS /////////////////////////////////////////////////////////
 
@@ -380,7 +707,7 @@ bool can_see_player_in_other_room(char_data *ch, char_data *vict) {
 }
 
 
-bool show_pc_in_room(char_data *ch, room_data *room, struct mappc_data_container *mappc) {
+bool show_pc_in_room(char_data *ch, room_data *room, struct mappc_data_container *mappc, char *output) {
 	struct mappc_data *pc, *pc_iter, *start_this_room = NULL;
 	char lbuf[60];
 	char_data *c;
@@ -426,7 +753,7 @@ bool show_pc_in_room(char_data *ch, room_data *room, struct mappc_data_container
 	}
 	else if (count == 1) {
 		emp = GET_LOYALTY(start_this_room->character);
-		msg_to_char(ch, "&0<%soo&0>", !emp ? "" : EMPIRE_BANNER(emp));
+		sprintf(output, "&0<%soo&0>", !emp ? "" : EMPIRE_BANNER(emp));
 	}
 	else if (count == 2) {
 		pc = start_this_room;
@@ -437,7 +764,7 @@ bool show_pc_in_room(char_data *ch, room_data *room, struct mappc_data_container
 		emp = GET_LOYALTY(pc->character);
 		sprintf(lbuf + strlen(lbuf), "%so&0>", !emp ? "" : EMPIRE_BANNER(emp));
 		
-		send_to_char(lbuf, ch);
+		strcpy(output, lbuf);
 	}
 	else if (count == 3) {
 		pc = start_this_room;
@@ -452,7 +779,7 @@ bool show_pc_in_room(char_data *ch, room_data *room, struct mappc_data_container
 		emp = GET_LOYALTY(pc->character);
 		sprintf(lbuf + strlen(lbuf), "%s>", !emp ? "" : EMPIRE_BANNER(emp));
 		
-		send_to_char(lbuf, ch);
+		strcpy(output, lbuf);
 	}
 	else if (count >= 4) {
 		pc = start_this_room;
@@ -465,7 +792,7 @@ bool show_pc_in_room(char_data *ch, room_data *room, struct mappc_data_container
 			pc = pc->next;
 		}
 		
-		send_to_char(lbuf, ch);
+		strcpy(output, lbuf);
 	}
 	
 	// if we got here we showed a pc
@@ -505,10 +832,15 @@ void look_at_room_by_loc(char_data *ch, room_data *room, bitvector_t options) {
 	struct mappc_data *pc, *next_pc;
 	struct empire_city_data *city;
 	char output[MAX_STRING_LENGTH], veh_buf[256], flagbuf[MAX_STRING_LENGTH], locbuf[128], partialbuf[MAX_STRING_LENGTH], rlbuf[MAX_STRING_LENGTH], tmpbuf[MAX_STRING_LENGTH], advcolbuf[128];
-	int s, t, mapsize, iter, check_x, check_y;
+	int s, mapsize, iter, check_x, check_y;
 	int first_iter, second_iter, xx, yy, magnitude, north;
 	int first_start, first_end, second_start, second_end, temp;
+	int x_lo, x_hi, y_lo, y_hi;
 	bool y_first, invert_x, invert_y, comma;
+	struct map_view_grid grid;
+	struct map_oob_frame *oob = NULL;
+	char frame[MAP_OUTPUT_CHUNK], border[MAX_STRING_LENGTH], *row;
+	size_t frame_len, row_len;
 	struct instance_data *inst;
 	player_index_data *index;
 	room_data *to_room;
@@ -617,22 +949,28 @@ void look_at_room_by_loc(char_data *ch, room_data *room, bitvector_t options) {
 		else {	// normal map view
 			magnitude = PRF_FLAGGED(ch, PRF_BRIEF) ? 3 : mapsize;
 			*buf = '\0';
+			*frame = '\0';
+			frame_len = 0;
 			
 			if (show_title) {
 				// spacing to center the title
 				s = ((4 * (magnitude * 2 + 1)) + 2 - (strlen(output)-4))/2;
-				if (!PRF_FLAGGED(ch, PRF_BRIEF))
-					for (t = 1; t <= s; t++)
-						send_to_char(" ", ch);
-				msg_to_char(ch, output);
-			}		
-		
+				if (!PRF_FLAGGED(ch, PRF_BRIEF)) {
+					snprintf(tmpbuf, sizeof(tmpbuf), "%*s", MAX(0, s), "");
+					add_map_output(ch, frame, &frame_len, tmpbuf);
+				}
+				add_map_output(ch, frame, &frame_len, output);
+			}
+			
 			// border
-			send_to_char("+", ch);
+			strcpy(border, "+");
 			for (iter = 0; iter < (magnitude * 2 + 1); ++iter) {
-				send_to_char("----", ch);
+				strcat(border, "----");
+			}
+			strcat(border, "+\r\n");
+			if (!wants_oob_map(ch)) {
+				add_map_output(ch, frame, &frame_len, border);
 			}
-			send_to_char("+\r\n", ch);
 		
 			// map setup
 			north = get_direction_for_char(ch, NORTH);
@@ -714,47 +1052,94 @@ void look_at_room_by_loc(char_data *ch, room_data *room, bitvector_t options) {
 				}
 			}
 		
+			// grid covers every visible tile plus a 1-tile border, so neighbors are only looked up once
+			x_lo = (y_first ? -second_end : -first_end) * (invert_x ? -1 : 1);
+			x_hi = (y_first ? second_start : first_start) * (invert_x ? -1 : 1);
+			y_lo = (y_first ? -first_end : -second_end) * (invert_y ? -1 : 1);
+			y_hi = (y_first ? first_start : second_start) * (invert_y ? -1 : 1);
+			grid.origin = room;
+			grid.x_min = MIN(x_lo, x_hi) - 1;
+			grid.y_min = MIN(y_lo, y_hi) - 1;
+			grid.width = ABSOLUTE(x_hi - x_lo) + 3;
+			grid.height = ABSOLUTE(y_hi - y_lo) + 3;
+			CREATE(grid.rooms, room_data*, grid.width * grid.height);
+			CREATE(grid.looked_up, bool, grid.width * grid.height);
+			
+			// each row is built in one buffer
+			CREATE(row, char, (second_start + second_end + 1) * MAP_TILE_BUFSIZE + 16);
+			
+			// out-of-band map: tiles are kept for send_map_oob_frame() instead of sent as text
+			if (wants_oob_map(ch)) {
+				CREATE(oob, struct map_oob_frame, 1);
+				oob->rows = first_start + first_end + 1;
+				oob->cols = second_start + second_end + 1;
+				CREATE(oob->vnums, room_vnum, oob->rows * oob->cols);
+				CREATE(oob->tiles, char*, oob->rows * oob->cols);
+			}
+			
 			// which iter is x/y depends on which way is north!
 			for (first_iter = first_start; first_iter >= -first_end; --first_iter) {
-				msg_to_char(ch, "|");
+				strcpy(row, "|");
+				row_len = 1;
 			
 				for (second_iter = second_start; second_iter >= -second_end; --second_iter) {
 					xx = (y_first ? second_iter : first_iter) * (invert_x ? -1 : 1);
 					yy = (y_first ? first_iter : second_iter) * (invert_y ? -1 : 1);
 				
-					to_room = real_shift(room, xx, yy);
+					to_room = map_view_room(&grid, xx, yy);
 				
 					if (!to_room) {
 						// nothing to show?
-						send_to_char("    ", ch);
+						strcpy(row + row_len, "    ");
 					}
 					else if (to_room != room && ROOM_AFF_FLAGGED(to_room, ROOM_AFF_DARK)) {
 						// magic dark
-						send_to_char("    ", ch);
+						strcpy(row + row_len, "    ");
 					}
 					else if (to_room != room && !CAN_SEE_IN_DARK_ROOM(ch, to_room) && compute_distance(room, to_room) > distance_can_see(ch) && !adjacent_room_is_light(to_room)) {
 						// normal dark
 						if (!PRF_FLAGGED(ch, PRF_NOMAPCOL)) {
-							show_map_to_char(ch, mappc, to_room, options | LRR_SHOW_DARK);
+							show_map_to_char(ch, mappc, &grid, xx, yy, options | LRR_SHOW_DARK, row + row_len);
 						}
 						else {
-							send_to_char("    ", ch);
+							strcpy(row + row_len, "    ");
 						}
 					}
 					else {
-						show_map_to_char(ch, mappc, to_room, options);
+						show_map_to_char(ch, mappc, &grid, xx, yy, options, row + row_len);
+					}
+					
+					if (oob) {
+						iter = (first_start - first_iter) * oob->cols + (second_start - second_iter);
+						oob->vnums[iter] = to_room ? GET_ROOM_VNUM(to_room) : NOWHERE;
+						oob->tiles[iter] = str_dup(row + row_len);
+						if (xx == 0 && yy == 0) {
+							oob->center = iter;
+						}
 					}
+					
+					row_len += strlen(row + row_len);
 				}
 			
-				msg_to_char(ch, "&0|\r\n");
+				if (!oob) {
+					strcpy(row + row_len, "&0|\r\n");
+					add_map_output(ch, frame, &frame_len, row);
+				}
 			}
-
-			// border
-			send_to_char("+", ch);
-			for (iter = 0; iter < (magnitude * 2 + 1); ++iter) {
-				send_to_char("----", ch);
+			
+			free(row);
+			free(grid.rooms);
+			free(grid.looked_up);
+			
+			if (oob) {
+				add_map_output(ch, frame, &frame_len, NULL);	// title
+				send_map_oob_frame(ch->desc, oob);
+			}
+			else {
+				// border
+				add_map_output(ch, frame, &frame_len, border);
+				add_map_output(ch, frame, &frame_len, NULL);
 			}
-			send_to_char("+\r\n", ch);
 		}
 
 		// notify character they can't see in the dark
@@ -1158,18 +1543,23 @@ void look_in_direction(char_data *ch, int dir) {
 *
 * @param char_data *ch the viewer
 * @param struct mappc_data_container *mappc Players visible on the map are stored in this, to be shown below the map
-* @param room_data *to_room The room the character is looking at.
+* @param struct map_view_grid *grid The tiles of the map view being drawn.
+* @param int x_off The x-offset of the tile to show, from the center of the grid.
+* @param int y_off The y-offset of the tile to show, from the center of the grid.
 * @param bitvector_t options Will recolor the tile if TRUE
+* @param char *output A buffer (MAP_TILE_BUFSIZE) to write the tile into.
 */
-static void show_map_to_char(char_data *ch, struct mappc_data_container *mappc, room_data *to_room, bitvector_t options) {
+static void show_map_to_char(char_data *ch, struct mappc_data_container *mappc, struct map_view_grid *grid, int x_off, int y_off, bitvector_t options, char *output) {
 	extern const char *closed_ruins_icons[NUM_RUINS_ICONS];
 	extern const char *open_ruins_icons[NUM_RUINS_ICONS];
 	extern int get_north_for_char(char_data *ch);
 	extern int get_direction_for_char(char_data *ch, int dir);
 	extern struct city_metadata_type city_type[];
 	
+	room_data *to_room = map_view_room(grid, x_off, y_off);
+	int north = get_north_for_char(ch);
 	bool need_color_terminator = FALSE;
-	char buf[30], buf1[30], lbuf[MAX_STRING_LENGTH];
+	char buf[MAP_TILE_BUFSIZE], buf1[MAP_TILE_BUFSIZE], lbuf[MAX_STRING_LENGTH];
 	struct empire_city_data *city;
 	int iter;
 	empire_data *emp, *chemp = GET_LOYALTY(ch);
@@ -1178,24 +1568,26 @@ static void show_map_to_char(char_data *ch, struct mappc_data_container *mappc,
 	bool junk, enchanted, hidden = FALSE;
 	crop_data *cp = ROOM_CROP(to_room);
 	sector_data *st, *base_sect = BASE_SECT(to_room);
-	char *base_color, *str;
+	char *base_color, *str, *cached = NULL;
 	room_data *map_loc = get_map_location_for(IN_ROOM(ch)), *map_to_room = get_map_location_for(to_room);
-	vehicle_data *show_veh;
+	vehicle_data *show_veh = NULL;
+	bool overlay = FALSE;	// tile is not just terrain, and won't be cached
 	
 	// options
 	bool show_dark = IS_SET(options, LRR_SHOW_DARK) ? TRUE : FALSE;
 	// bool ship_partial = IS_SET(options, LRR_SHIP_PARTIAL) ? TRUE : FALSE;
 		
-	// adjacent rooms, shifted by map change
+	// adjacent rooms, shifted by map change (same as SHIFT_CHAR_DIR but read from the grid)
 	// WARNING: You must make sure these are not NULL when you try to use them
-	room_data *r_north = SHIFT_CHAR_DIR(ch, to_room, NORTH);
-	room_data *r_east = SHIFT_CHAR_DIR(ch, to_room, EAST);
-	room_data *r_south = SHIFT_CHAR_DIR(ch, to_room, SOUTH);
-	room_data *r_west = SHIFT_CHAR_DIR(ch, to_room, WEST);
-	room_data *r_northwest = SHIFT_CHAR_DIR(ch, to_room, NORTHWEST);
-	room_data *r_northeast = SHIFT_CHAR_DIR(ch, to_room, NORTHEAST);
-	room_data *r_southwest = SHIFT_CHAR_DIR(ch, to_room, SOUTHWEST);
-	room_data *r_southeast = SHIFT_CHAR_DIR(ch, to_room, SOUTHEAST);
+	#define GRID_CHAR_DIR(dir)  map_view_room(grid, x_off + shift_dir[confused_dirs[north][0][(dir)]][0], y_off + shift_dir[confused_dirs[north][0][(dir)]][1])
+	room_data *r_north = GRID_CHAR_DIR(NORTH);
+	room_data *r_east = GRID_CHAR_DIR(EAST);
+	room_data *r_south = GRID_CHAR_DIR(SOUTH);
+	room_data *r_west = GRID_CHAR_DIR(WEST);
+	room_data *r_northwest = GRID_CHAR_DIR(NORTHWEST);
+	room_data *r_northeast = GRID_CHAR_DIR(NORTHEAST);
+	room_data *r_southwest = GRID_CHAR_DIR(SOUTHWEST);
+	room_data *r_southeast = GRID_CHAR_DIR(SOUTHEAST);
 	
 	#define distance(x, y, a, b)		((x - a) * (x - a) + (y - b) * (y - b))
 
@@ -1212,8 +1604,9 @@ static void show_map_to_char(char_data *ch, struct mappc_data_container *mappc,
 
 	if (to_room == IN_ROOM(ch) && !ROOM_IS_CLOSED(IN_ROOM(ch))) {
 		sprintf(buf, "&0<%soo&0>", chemp ? EMPIRE_BANNER(chemp) : "");
+		overlay = TRUE;
 	}
-	else if (!show_dark && !PRF_FLAGGED(ch, PRF_INFORMATIVE | PRF_POLITICAL) && show_pc_in_room(ch, to_room, mappc)) {
+	else if (!show_dark && !PRF_FLAGGED(ch, PRF_INFORMATIVE | PRF_POLITICAL) && show_pc_in_room(ch, to_room, mappc, output)) {
 		return;
 	}
 	
@@ -1227,6 +1620,11 @@ static void show_map_to_char(char_data *ch, struct mappc_data_container *mappc,
 		strcat(buf, base_icon->icon);
 		hidden = TRUE;
 	}
+	
+	/* Terrain tiles that were already built (with normal colors) */
+	else if ((cached = get_map_icon_cache(to_room, tileset, north))) {
+		strcpy(buf, cached);
+	}
 
 	/* Rooms with custom icons (take precedence over all but hidden rooms */
 	else if (ROOM_CUSTOM_ICON(to_room)) {
@@ -1355,7 +1753,7 @@ static void show_map_to_char(char_data *ch, struct mappc_data_container *mappc,
 	}
 	
 	// buf is now the completed icon, but has both color codes (&) and variable tile codes (@)
-	if (strchr(buf, '@')) {
+	if (!cached && strchr(buf, '@')) {
 		// NOTE: If you add new @ codes here, you must update "const char *icon_codes" in utils.c
 		
 		// here (@.) roadside icon
@@ -1439,6 +1837,20 @@ static void show_map_to_char(char_data *ch, struct mappc_data_container *mappc,
 	}
 
 	// buf now contains the tile with preliminary color codes including &?
+	
+	// terrain-only tiles get their normal colors now, and are cached for the next look
+	if (!cached && !overlay && !show_veh && !hidden) {
+		if (strstr(buf, "&?")) {
+			replace_question_color(buf, base_color, lbuf);
+			strcpy(buf, lbuf);
+		}
+		if (strstr(buf, "&#")) {
+			str = str_replace("&#", ROOM_AFF_FLAGGED(to_room, ROOM_AFF_NO_FLY) ? "&m" : "&0", buf);
+			strcpy(buf, str);
+			free(str);
+		}
+		set_map_icon_cache(to_room, tileset, north, buf);
+	}
 
 	if (BUILDING_BURNING(to_room)) {
 		strcpy(buf1, strip_color(buf));
@@ -1561,7 +1973,8 @@ static void show_map_to_char(char_data *ch, struct mappc_data_container *mappc,
 		strcat(buf, "&0");
 	}
 	
-	send_to_char(buf, ch);
+	strcpy(output, buf);
+	#undef GRID_CHAR_DIR
 }
 
 
@@ -1624,7 +2037,7 @@ void screenread_one_dir(char_data *ch, room_data *origin, int dir) {
 	
 	mapsize = GET_MAPSIZE(REAL_CHAR(ch));
 	if (mapsize == 0) {
-		mapsize = config_get_int("default_map_size");
+		mapsize = CONFIG_INT(CONF_DEFAULT_MAP_SIZE);
 	}
 	
 	// constrain for brief
@@ -1982,6 +2395,7 @@ void print_object_location(int num, obj_data *obj, char_data *ch, int recur) {
 
 
 void perform_immort_where(char_data *ch, char *arg) {
+	struct keyword_index_ref *kwi;
 	int check_x, check_y, num = 0, found = 0;
 	descriptor_data *d;
 	vehicle_data *veh;
@@ -2019,7 +2433,7 @@ void perform_immort_where(char_data *ch, char *arg) {
 		}
 	}
 	else {
-		for (i = character_list; i; i = i->next) {
+		for (i = first_char_by_keyword(arg, &kwi); i; i = next_char_by_keyword(i, &kwi)) {
 			if (CAN_SEE(ch, i) && IN_ROOM(i) && WIZHIDE_OK(ch, i) && multi_isname(arg, GET_PC_NAME(i))) {
 				found = 1;
 				check_x = X_COORD(IN_ROOM(i));	// not all locations are on the map
@@ -2033,7 +2447,7 @@ void perform_immort_where(char_data *ch, char *arg) {
 			}
 		}
 		num = 0;
-		LL_FOREACH2(vehicle_list, veh, next) {
+		for (veh = first_vehicle_by_keyword(arg, &kwi); veh; veh = next_vehicle_by_keyword(veh, &kwi)) {
 			if (CAN_SEE_VEHICLE(ch, veh) && multi_isname(arg, VEH_KEYWORDS(veh))) {
 				found = 1;
 				check_x = X_COORD(IN_ROOM(veh));	// not all locations are on the map
@@ -2046,7 +2460,7 @@ void perform_immort_where(char_data *ch, char *arg) {
 				}
 			}
 		}
-		for (num = 0, k = object_list; k; k = k->next) {
+		for (num = 0, k = first_obj_by_keyword(arg, &kwi); k; k = next_obj_by_keyword(k, &kwi)) {
 			if (CAN_SEE_OBJ(ch, k) && multi_isname(arg, GET_OBJ_KEYWORDS(k))) {
 				found = 1;
 				print_object_location(++num, k, ch, TRUE);
@@ -403,6 +403,7 @@ void setup_generic_npc(char_data *mob, empire_data *emp, int name, int sex) {
 	
 	// restrings: uses "afar"/"lost" if there is no empire
 	GET_PC_NAME(mob) = str_dup(replace_npc_names(GET_PC_NAME(proto ? proto : mob), name_set->names[name], !emp ? "afar" : EMPIRE_NAME(emp), !emp ? "lost" : EMPIRE_ADJECTIVE(emp)));
+	index_char_keywords(mob);
 	GET_SHORT_DESC(mob) = str_dup(replace_npc_names(GET_SHORT_DESC(proto ? proto : mob), name_set->names[name], !emp ? "afar" : EMPIRE_NAME(emp), !emp ? "lost" : EMPIRE_ADJECTIVE(emp)));
 	GET_LONG_DESC(mob) = str_dup(replace_npc_names(GET_LONG_DESC(proto ? proto : mob), name_set->names[name], !emp ? "afar" : EMPIRE_NAME(emp), !emp ? "lost" : EMPIRE_ADJECTIVE(emp)));
 	
@@ -614,7 +615,7 @@ void mobile_activity(void) {
 				next_purs = purs->next;
 				
 				// check pursuit timeout and distance
-				if (time(0) - purs->last_seen > config_get_int("mob_pursuit_timeout") * SECS_PER_REAL_MIN || compute_distance(IN_ROOM(ch), real_room(purs->location)) > config_get_int("mob_pursuit_distance")) {
+				if (time(0) - purs->last_seen > CONFIG_INT(CONF_MOB_PURSUIT_TIMEOUT) * SECS_PER_REAL_MIN || compute_distance(IN_ROOM(ch), real_room(purs->location)) > CONFIG_INT(CONF_MOB_PURSUIT_DISTANCE)) {
 					REMOVE_FROM_LIST(purs, MOB_PURSUIT(ch), next);
 					free(purs);
 				}
@@ -939,7 +940,7 @@ static void spawn_one_room(room_data *room, bool only_artisans) {
 	crop_data *cp;
 	mob_vnum artisan = NOTHING;
 	
-	int time_to_empire_emptiness = config_get_int("time_to_empire_emptiness") * SECS_PER_REAL_WEEK;
+	int time_to_empire_emptiness = CONFIG_INT(CONF_TIME_TO_EMPIRE_EMPTINESS) * SECS_PER_REAL_WEEK;
 	
 	// safety first
 	if (!room) {
@@ -983,7 +984,7 @@ static void spawn_one_room(room_data *room, bool only_artisans) {
 	}
 	
 	// normal spawn list
-	if (!only_artisans && count < config_get_int("spawn_limit_per_room")) {
+	if (!only_artisans && count < CONFIG_INT(CONF_SPAWN_LIMIT_PER_ROOM)) {
 		// find a spawn list
 		list = NULL;
 		if (GET_BUILDING(room)) {
@@ -1078,8 +1079,8 @@ void spawn_mobs_from_center(room_data *center) {
 	room_data *to_room;
 	time_t now = time(0);
 	
-	int mob_spawn_interval = config_get_int("mob_spawn_interval") * SECS_PER_REAL_MIN;
-	int mob_spawn_radius = config_get_int("mob_spawn_radius");
+	int mob_spawn_interval = CONFIG_INT(CONF_MOB_SPAWN_INTERVAL) * SECS_PER_REAL_MIN;
+	int mob_spawn_radius = CONFIG_INT(CONF_MOB_SPAWN_RADIUS);
 	
 	// always start on the map
 	center = get_map_location_for(center);
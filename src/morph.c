@@ -135,7 +135,7 @@ void add_morph_affects(char_data *ch) {
 		
 		if (af) {
 			affect_to_char(ch, af);
-			free(af);
+			FREE_SLAB(SLAB_AFFECT, af);
 			af = NULL;
 		}
 	}
@@ -143,7 +143,7 @@ void add_morph_affects(char_data *ch) {
 	if (MORPH_AFFECTS(morph)) {
 		af = create_flag_aff(ATYPE_MORPH, UNLIMITED, MORPH_AFFECTS(morph), ch);
 		affect_to_char(ch, af);
-		free(af);
+		FREE_SLAB(SLAB_AFFECT, af);
 	}
 	
 	// in case nothing else did
@@ -322,6 +322,12 @@ void perform_morph(char_data *ch, morph_data *morph) {
 	// Set the new form
 	GET_MORPH(ch) = morph;
 	add_morph_affects(ch);
+	if (IS_NPC(ch)) {
+		index_char_keywords(ch);
+	}
+	else {
+		update_player_name_index(ch);
+	}
 
 	// set new pools
 	GET_HEALTH(ch) = (sh_int) (GET_MAX_HEALTH(ch) * health_mod);
@@ -335,7 +335,7 @@ obj_data *Obj_load_from_file(FILE *fl, obj_vnum vnum, int *location, char_data *
 			case 'T': {
 				if (OBJ_FILE_TAG(line, "Timer:", length)) {
 					if (sscanf(line + length + 1, "%d", &i_in[0])) {
-						GET_OBJ_TIMER(obj) = i_in[0];
+						SET_OBJ_TIMER(obj, i_in[0]);
 					}
 				}
 				else if (OBJ_FILE_TAG(line, "Trigger:", length)) {
@@ -39,8 +39,10 @@ extern const char *room_aff_bits[];
 extern const char *spawn_flags[];
 
 // external funcs
+void clear_all_map_icon_caches();
 void init_building(bld_data *building);
 void replace_question_color(char *input, char *color, char *output);
+void schedule_all_territory_chores();
 void sort_interactions(struct interaction_item **list);
 
 
@@ -539,12 +541,14 @@ void save_olc_building(descriptor_data *desc) {
 	struct trig_proto_list *trig;
 	struct spawn_info *spawn;
 	struct quest_lookup *ql;
+	bitvector_t old_functions;
 	UT_hash_handle hh;
 	
 	// have a place to save it?
 	if (!(proto = building_proto(vnum))) {
 		proto = create_building_table_entry(vnum);
 	}
+	old_functions = GET_BLD_FUNCTIONS(proto);
 	
 	// free prototype strings and pointers
 	if (GET_BLD_NAME(proto)) {
@@ -616,6 +620,17 @@ void save_olc_building(descriptor_data *desc) {
 	proto->hh = hh;	// restore hash handle
 	proto->quest_lookups = ql;	// restore lookups
 	
+	// functions like tavern/stable decide which rooms get periodic updates
+	if (GET_BLD_FUNCTIONS(proto) != old_functions) {
+		schedule_all_room_updates();
+	}
+	
+	// functions and interactions decide which rooms get workforce chores
+	schedule_all_territory_chores();
+	
+	// icons may have changed
+	clear_all_map_icon_caches();
+	
 	// and save to file
 	save_library_file_for_vnum(DB_BOOT_BLD, vnum);
 }
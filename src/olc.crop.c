@@ -37,7 +37,9 @@ extern const char *mapout_color_names[];
 extern const char *spawn_flags[];
 
 // external funcs
+void clear_all_map_icon_caches();
 void init_crop(crop_data *cp);
+void schedule_all_territory_chores();
 void sort_interactions(struct interaction_item **list);
 
 
@@ -356,6 +358,12 @@ void save_olc_crop(descriptor_data *desc) {
 	*proto = *cp;	// copy over all data
 	proto->vnum = vnum;	// ensure correct vnum
 	proto->hh = hh;	// restore old hash handle
+	
+	// interactions decide which rooms get workforce chores
+	schedule_all_territory_chores();
+	
+	// icons may have changed
+	clear_all_map_icon_caches();
 		
 	// and save to file
 	save_library_file_for_vnum(DB_BOOT_CROP, vnum);
@@ -35,6 +35,7 @@ extern bool world_map_needs_save;
 void complete_building(room_data *room);
 void deactivate_workforce_room(empire_data *emp, room_data *room);
 extern crop_data *get_potential_crop_for_location(room_data *location);
+void stats_adjust_crop_count(crop_data *cp, int amount);
 
 
  //////////////////////////////////////////////////////////////////////////////
@@ -309,6 +310,7 @@ OLC_MODULE(mapedit_room_name) {
 
 
 OLC_MODULE(mapedit_icon) {
+	void clear_map_icon_cache(room_data *room, struct map_data *map);
 	extern bool validate_icon(char *icon);
 
 	delete_doubledollar(argument);
@@ -319,6 +321,7 @@ OLC_MODULE(mapedit_icon) {
 		if (ROOM_CUSTOM_ICON(IN_ROOM(ch))) {
 			free(ROOM_CUSTOM_ICON(IN_ROOM(ch)));
 			ROOM_CUSTOM_ICON(IN_ROOM(ch)) = NULL;
+			clear_map_icon_cache(IN_ROOM(ch), NULL);
 			}
 		msg_to_char(ch, "This area no longer has a specialized icon.\r\n");
 		}
@@ -333,6 +336,7 @@ OLC_MODULE(mapedit_icon) {
 			free(ROOM_CUSTOM_ICON(IN_ROOM(ch)));
 		}
 		ROOM_CUSTOM_ICON(IN_ROOM(ch)) = str_dup(argument);
+		clear_map_icon_cache(IN_ROOM(ch), NULL);
 		msg_to_char(ch, "This area now has the icon \"%s&0\".\r\n", argument);
 	}
 }
@@ -453,7 +457,7 @@ OLC_MODULE(mapedit_exits) {
 			}
 			COMPLEX_DATA(HOME_ROOM(IN_ROOM(ch)))->inside_rooms++;
 			
-			COMPLEX_DATA(to_room)->home_room = HOME_ROOM(IN_ROOM(ch));
+			set_room_home(to_room, HOME_ROOM(IN_ROOM(ch)));
 			
 			if (ROOM_OWNER(HOME_ROOM(IN_ROOM(ch)))) {
 				perform_claim_room(to_room, ROOM_OWNER(HOME_ROOM(IN_ROOM(ch))));
@@ -565,6 +569,7 @@ OLC_MODULE(mapedit_naturalize) {
 					set_crop_type(room, get_potential_crop_for_location(room));
 				}
 				else {
+					stats_adjust_crop_count(map->crop_type, -1);
 					map->crop_type = NULL;
 				}
 			}
@@ -149,7 +149,7 @@ char_data *create_mob_table_entry(mob_vnum vnum) {
 		return mob_proto(vnum);
 	}
 	
-	CREATE(mob, char_data, 1);
+	CREATE_SLAB(mob, char_data, SLAB_CHAR);
 	clear_char(mob);
 	mob->vnum = vnum;
 	SET_BIT(MOB_FLAGS(mob), MOB_ISNPC);	// need this for some macroes
@@ -702,6 +702,7 @@ void save_olc_mobile(descriptor_data *desc) {
 			// update strings
 			if (GET_PC_NAME(mob_iter) == GET_PC_NAME(proto)) {
 				GET_PC_NAME(mob_iter) = GET_PC_NAME(mob);
+				index_char_keywords(mob_iter);
 			}
 			if (GET_SHORT_DESC(mob_iter) == GET_SHORT_DESC(proto)) {
 				GET_SHORT_DESC(mob_iter) = GET_SHORT_DESC(mob);
@@ -792,7 +793,7 @@ void save_olc_mobile(descriptor_data *desc) {
 char_data *setup_olc_mobile(char_data *input) {
 	char_data *new;
 	
-	CREATE(new, char_data, 1);
+	CREATE_SLAB(new, char_data, SLAB_CHAR);
 	clear_char(new);
 	
 	if (input) {
@@ -309,7 +309,7 @@ obj_data *create_obj_table_entry(obj_vnum vnum) {
 		return obj_proto(vnum);
 	}
 	
-	CREATE(obj, obj_data, 1);
+	CREATE_SLAB(obj, obj_data, SLAB_OBJ);
 	clear_object(obj);
 	obj->vnum = vnum;
 	add_object_to_table(obj);
@@ -1405,6 +1405,7 @@ void update_live_obj_from_olc(obj_data *to_update, obj_data *old_proto, obj_data
 	// strings
 	if (GET_OBJ_KEYWORDS(to_update) == GET_OBJ_KEYWORDS(old_proto)) {
 		GET_OBJ_KEYWORDS(to_update) = GET_OBJ_KEYWORDS(new_proto);
+		index_obj_keywords(to_update);
 	}
 	if (GET_OBJ_LONG_DESC(to_update) == GET_OBJ_LONG_DESC(old_proto)) {
 		GET_OBJ_LONG_DESC(to_update) = GET_OBJ_LONG_DESC(new_proto);
@@ -1525,7 +1526,7 @@ void save_olc_object(descriptor_data *desc) {
 	
 	// timer must be converted
 	if (GET_OBJ_TIMER(obj) <= 0) {
-		GET_OBJ_TIMER(obj) = UNLIMITED;
+		SET_OBJ_TIMER(obj, UNLIMITED);
 	}
 	prune_extra_descs(&obj->ex_description);
 
@@ -1605,7 +1606,7 @@ obj_data *setup_olc_object(obj_data *input) {
 	struct obj_storage_type *store, *new_store, *last_store;
 	obj_data *new;
 	
-	CREATE(new, obj_data, 1);
+	CREATE_SLAB(new, obj_data, SLAB_OBJ);
 	clear_object(new);
 	
 	if (input) {
@@ -2884,7 +2885,7 @@ OLC_MODULE(oedit_storage) {
 
 OLC_MODULE(oedit_timer) {
 	obj_data *obj = GET_OLC_OBJECT(ch->desc);
-	GET_OBJ_TIMER(obj) = olc_process_number(ch, argument, "decay timer", "timer", -1, MAX_INT, GET_OBJ_TIMER(obj));
+	SET_OBJ_TIMER(obj, olc_process_number(ch, argument, "decay timer", "timer", -1, MAX_INT, GET_OBJ_TIMER(obj)));
 }
 
 
@@ -42,6 +42,7 @@ extern const char *room_template_flags[];
 // external funcs
 extern adv_data *get_adventure_for_vnum(rmt_vnum vnum);
 void init_room_template(room_template *rmt);
+void schedule_all_territory_chores();
 void sort_interactions(struct interaction_item **list);
 
 
@@ -512,12 +513,14 @@ void save_olc_room_template(descriptor_data *desc) {
 	struct trig_proto_list *trig;
 	struct exit_template *ex;
 	struct quest_lookup *ql;
+	bitvector_t old_functions;
 	UT_hash_handle hh;
 	
 	// have a place to save it?
 	if (!(proto = room_template_proto(vnum))) {
 		proto = create_room_template_table_entry(vnum);
 	}
+	old_functions = GET_RMT_FUNCTIONS(proto);
 	
 	// free prototype strings and pointers
 	if (GET_RMT_TITLE(proto)) {
@@ -569,6 +572,14 @@ void save_olc_room_template(descriptor_data *desc) {
 	proto->hh = hh;	// restore old hash handle
 	proto->quest_lookups = ql;	// restore lookups
 	
+	// functions like tavern/stable decide which rooms get periodic updates
+	if (GET_RMT_FUNCTIONS(proto) != old_functions) {
+		schedule_all_room_updates();
+	}
+	
+	// functions and interactions decide which rooms get workforce chores
+	schedule_all_territory_chores();
+	
 	// and save to file
 	save_library_file_for_vnum(DB_BOOT_RMT, vnum);
 }
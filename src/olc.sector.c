@@ -41,7 +41,9 @@ extern const char *spawn_flags[];
 extern const char *icon_types[];
 
 // external funcs
+void clear_all_map_icon_caches();
 void init_sector(sector_data *st);
+void schedule_all_territory_chores();
 void sort_interactions(struct interaction_item **list);
 
 
@@ -398,12 +400,14 @@ void save_olc_sector(descriptor_data *desc) {
 	sector_vnum vnum = GET_OLC_VNUM(desc);
 	struct interaction_item *interact;
 	struct spawn_info *spawn;
+	bitvector_t old_flags;
 	UT_hash_handle hh;
 	
 	// have a place to save it?
 	if (!(proto = sector_proto(vnum))) {
 		proto = create_sector_table_entry(vnum);
 	}
+	old_flags = GET_SECT_FLAGS(proto);
 	
 	// free prototype strings and pointers
 	free_icon_set(&GET_SECT_ICONS(proto));
@@ -451,6 +455,17 @@ void save_olc_sector(descriptor_data *desc) {
 	proto->vnum = vnum;	// ensure correct vnum
 	proto->hh = hh;	// restore old hash handle
 	
+	// flags like trench/crop decide which rooms get periodic updates
+	if (GET_SECT_FLAGS(proto) != old_flags) {
+		schedule_all_room_updates();
+	}
+	
+	// flags, evolutions, and interactions decide which rooms get workforce chores
+	schedule_all_territory_chores();
+	
+	// icons may have changed
+	clear_all_map_icon_caches();
+	
 	// and save to file
 	save_library_file_for_vnum(DB_BOOT_SECTOR, vnum);
 }
@@ -207,6 +207,7 @@ static variable_name_t VariableNameTable[eMSDP_MAX+1] = {
 	{ eMSDP_ROOM_VNUM, "ROOM_VNUM", NUMBER_READ_ONLY },
 	{ eMSDP_WORLD_TIME, "WORLD_TIME", NUMBER_READ_ONLY },
 	{ eMSDP_WORLD_SEASON, "WORLD_SEASON", STRING_READ_ONLY },
+	{ eMSDP_MAP, "MAP", STRING_READ_ONLY },
 	
 	/* Configurable variables */
 	{ eMSDP_CLIENT_ID, "CLIENT_ID", STRING_WRITE_ONCE(1,40) },
@@ -1078,7 +1079,7 @@ const char *ProtocolOutput(descriptor_t *apDescriptor, const char *apData, int *
 					break;
 
 				case '[': {	// extended codes
-					if (config_get_bool("allow_extended_color_codes")) {
+					if (CONFIG_BOOL(CONF_ALLOW_EXTENDED_COLOR_CODES)) {
 						if (tolower(apData[++j]) == 'f' || tolower(apData[j]) == 'b') {
 							char Buffer[8] = {'\0'};
 							int Index = 0;
@@ -1556,6 +1557,23 @@ void MSDPSetArray(descriptor_t *apDescriptor, variable_t aMSDP, const char *apVa
 	}
 }
 
+void MSDPSendTable(descriptor_t *apDescriptor, variable_t aMSDP, const char *apValue) {
+	if (MSDPIsReported(apDescriptor, aMSDP)) {
+		MSDPSetTable(apDescriptor, aMSDP, apValue);
+		MSDPSend(apDescriptor, aMSDP);
+		apDescriptor->pProtocol->pVariables[aMSDP]->bDirty = false;
+	}
+}
+
+bool_t MSDPIsReported(descriptor_t *apDescriptor, variable_t aMSDP) {
+	protocol_t *pProtocol = apDescriptor ? apDescriptor->pProtocol : NULL;
+
+	if (pProtocol != NULL && aMSDP > eMSDP_NONE && aMSDP < eMSDP_MAX) {
+		return pProtocol->pVariables[aMSDP]->bReport;
+	}
+	return false;
+}
+
 
 /******************************************************************************
  MSSP global functions.
@@ -208,6 +208,7 @@ typedef enum {
 	eMSDP_ROOM_VNUM,
 	eMSDP_WORLD_TIME,
 	eMSDP_WORLD_SEASON,
+	eMSDP_MAP,
 	
 	// Configuration
 	eMSDP_CLIENT_ID,
@@ -514,6 +515,21 @@ void MSDPSetTable(descriptor_t *apDescriptor, variable_t aMSDP, const char *apVa
  */
 void MSDPSetArray(descriptor_t *apDescriptor, variable_t aMSDP, const char *apValue);
 
+/* Function: MSDPSendTable
+ *
+ * Works like MSDPSetTable, but the table is sent right away (if the client 
+ * has asked for the variable), even if it's the same as the last value.  This 
+ * is for variables that are used as a stream of messages, like MAP, where 
+ * two identical messages in a row are both meaningful.
+ */
+void MSDPSendTable(descriptor_t *apDescriptor, variable_t aMSDP, const char *apValue);
+
+/* Function: MSDPIsReported
+ *
+ * Returns true if the client has asked to have this variable reported.
+ */
+bool_t MSDPIsReported(descriptor_t *apDescriptor, variable_t aMSDP);
+
 /******************************************************************************
  MSSP functions.
  ******************************************************************************/
@@ -391,10 +391,12 @@ void add_ability_by_set(char_data *ch, ability_data *abil, int skill_set, bool r
 	
 	if (data) {
 		data->purchased[skill_set] = TRUE;
+		GET_SKILL_CACHE(ch).valid = FALSE;
 		if (reset_levels) {
 			data->levels_gained = 0;
 		}
 		qt_change_ability(ch, ABIL_VNUM(abil));
+		MSDP_DIRTY(ch, MSDP_DIRTY_COMBAT | MSDP_DIRTY_REGEN);
 	}
 }
 
@@ -842,6 +844,7 @@ bool gain_skill_exp(char_data *ch, any_vnum skill_vnum, double amount) {
 	
 	// gain the exp
 	skdata->exp += amount;
+	MSDP_DIRTY(ch, MSDP_DIRTY_SKILLS);
 	
 	// can gain at all?
 	if (skdata->exp < config_get_int("min_exp_to_roll_skillup")) {
@@ -1250,6 +1253,7 @@ void perform_swap_skill_sets(char_data *ch) {
 	
 	// update skill set
 	GET_CURRENT_SKILL_SET(ch) = cur_set;
+	GET_SKILL_CACHE(ch).valid = FALSE;
 	
 	// update abilities:
 	HASH_ITER(hh, GET_ABILITY_HASH(ch), plab, next_plab) {
@@ -1268,6 +1272,7 @@ void perform_swap_skill_sets(char_data *ch) {
 		}
 		else {	// class ability: just ensure it matches the old one
 			plab->purchased[cur_set] = plab->purchased[old_set];
+			GET_SKILL_CACHE(ch).valid = FALSE;
 			qt_change_ability(ch, ABIL_VNUM(abil));	// in case
 		}
 	}
@@ -1302,12 +1307,14 @@ void remove_ability_by_set(char_data *ch, ability_data *abil, int skill_set, boo
 	
 	if (data) {
 		data->purchased[skill_set] = FALSE;
+		GET_SKILL_CACHE(ch).valid = FALSE;
 		
 		if (reset_levels) {
 			data->levels_gained = 0;
 		}
 		
 		qt_change_ability(ch, ABIL_VNUM(abil));
+		MSDP_DIRTY(ch, MSDP_DIRTY_COMBAT | MSDP_DIRTY_REGEN);
 	}
 }
 
@@ -1357,6 +1364,8 @@ void set_skill(char_data *ch, any_vnum skill, int level) {
 		
 		skdata->level = level;
 		skdata->exp = 0.0;
+		GET_SKILL_CACHE(ch).valid = FALSE;
+		MSDP_DIRTY(ch, MSDP_DIRTY_SKILLS | MSDP_DIRTY_CHARACTER | MSDP_DIRTY_COMBAT | MSDP_DIRTY_REGEN);
 		
 		if (!gain) {
 			reset_skill_gain_tracker_on_abilities_above_level(ch, skill);
@@ -1391,6 +1400,74 @@ bool skill_check(char_data *ch, any_vnum ability, int difficulty) {
 }
 
 
+/**
+* Rebuilds a player's skill cache from their skill and ability hashes. The
+* cache holds a bitset of abilities purchased in the current skill set and an
+* array of skill levels, both indexed by vnum, so that has_ability() and
+* get_skill_level() don't need a hash lookup. Anything that changes the hashes
+* (or the current skill set) just sets GET_SKILL_CACHE(ch).valid = FALSE, and
+* the next lookup calls this.
+*
+* @param char_data *ch The player.
+*/
+void update_skill_cache(char_data *ch) {
+	struct player_ability_data *abil, *next_abil;
+	struct player_skill_data *skill, *next_skill;
+	struct player_skill_cache *cache;
+	int set, max_abil, max_skill;
+	
+	if (!ch || IS_NPC(ch)) {
+		return;
+	}
+	
+	cache = &GET_SKILL_CACHE(ch);
+	set = GET_CURRENT_SKILL_SET(ch);
+	
+	// find sizes
+	max_abil = max_skill = -1;
+	HASH_ITER(hh, GET_ABILITY_HASH(ch), abil, next_abil) {
+		if (abil->purchased[set] && abil->vnum > max_abil) {
+			max_abil = abil->vnum;
+		}
+	}
+	HASH_ITER(hh, GET_SKILL_HASH(ch), skill, next_skill) {
+		if (skill->vnum > max_skill) {
+			max_skill = skill->vnum;
+		}
+	}
+	
+	// abilities: only grows
+	if (max_abil / 64 + 1 > cache->ability_words) {
+		cache->ability_words = max_abil / 64 + 1;
+		RECREATE(cache->abilities, bitvector_t, cache->ability_words);
+	}
+	if (cache->ability_words > 0) {
+		memset(cache->abilities, 0, cache->ability_words * sizeof(bitvector_t));
+	}
+	HASH_ITER(hh, GET_ABILITY_HASH(ch), abil, next_abil) {
+		if (abil->purchased[set] && abil->vnum >= 0) {
+			cache->abilities[abil->vnum / 64] |= BIT(abil->vnum % 64);
+		}
+	}
+	
+	// skills: only grows
+	if (max_skill + 1 > cache->num_levels) {
+		cache->num_levels = max_skill + 1;
+		RECREATE(cache->levels, int, cache->num_levels);
+	}
+	if (cache->num_levels > 0) {
+		memset(cache->levels, 0, cache->num_levels * sizeof(int));
+	}
+	HASH_ITER(hh, GET_SKILL_HASH(ch), skill, next_skill) {
+		if (skill->vnum >= 0) {
+			cache->levels[skill->vnum] = skill->level;
+		}
+	}
+	
+	cache->valid = TRUE;
+}
+
+
  //////////////////////////////////////////////////////////////////////////////
 //// CORE SKILL COMMANDS /////////////////////////////////////////////////////
 
@@ -1413,10 +1490,12 @@ ACMD(do_noskill) {
 	else {
 		if (skdata->noskill) {
 			skdata->noskill = FALSE;
+			MSDP_DIRTY(ch, MSDP_DIRTY_SKILLS);
 			msg_to_char(ch, "You will now &cbe able to gain&0 %s skill.\r\n", SKILL_NAME(skill));
 		}
 		else {
 			skdata->noskill = TRUE;
+			MSDP_DIRTY(ch, MSDP_DIRTY_SKILLS);
 			msg_to_char(ch, "You will &rno longer&0 gain %s skill.\r\n", SKILL_NAME(skill));
 		}
 	}
@@ -1566,6 +1645,7 @@ ACMD(do_skills) {
 		else {
 			if (!IS_IMMORTAL(ch) && (skdata = get_skill_data(ch, SKILL_VNUM(skill), TRUE))) {
 				skdata->resets = MAX(skdata->resets - 1, 0);
+				MSDP_DIRTY(ch, MSDP_DIRTY_SKILLS);
 			}
 			clear_char_abilities(ch, SKILL_VNUM(skill));
 			
@@ -2869,6 +2949,7 @@ void olc_delete_skill(char_data *ch, any_vnum vnum) {
 				clear_char_abilities(chiter, plsk->vnum);
 				HASH_DEL(GET_SKILL_HASH(chiter), plsk);
 				free(plsk);
+				GET_SKILL_CACHE(chiter).valid = FALSE;
 				found = TRUE;
 			}
 		}
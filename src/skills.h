@@ -62,6 +62,7 @@ void mark_level_gained_from_ability(char_data *ch, ability_data *abil);
 void remove_ability(char_data *ch, ability_data *abil, bool reset_levels);
 void set_skill(char_data *ch, any_vnum skill, int level);
 extern bool skill_check(char_data *ch, any_vnum ability, int difficulty);
+void update_skill_cache(char_data *ch);
 
 
 // skill_check difficulties
@@ -730,8 +731,13 @@ static inline double get_skill_exp(char_data *ch, any_vnum skill) {
 * @return int The player's level in that skill.
 */
 static inline int get_skill_level(char_data *ch, any_vnum skill) {
-	struct player_skill_data *sk = get_skill_data(ch, skill, 0);
-	return sk ? sk->level : 0;
+	if (!ch || IS_NPC(ch)) {
+		return 0;
+	}
+	if (!GET_SKILL_CACHE(ch).valid) {
+		update_skill_cache(ch);
+	}
+	return (skill >= 0 && skill < GET_SKILL_CACHE(ch).num_levels) ? GET_SKILL_CACHE(ch).levels[skill] : 0;
 }
 
 
@@ -759,6 +765,17 @@ static inline bool has_ability_in_set(char_data *ch, any_vnum abil_id, int skill
 		return FALSE;
 	}
 	
+	// current set: use the cache
+	if (skill_set == GET_CURRENT_SKILL_SET(ch)) {
+		if (!GET_SKILL_CACHE(ch).valid) {
+			update_skill_cache(ch);
+		}
+		if (abil_id < 0 || abil_id / 64 >= GET_SKILL_CACHE(ch).ability_words) {
+			return FALSE;
+		}
+		return (GET_SKILL_CACHE(ch).abilities[abil_id / 64] & BIT(abil_id % 64)) ? TRUE : FALSE;
+	}
+	
 	data = get_ability_data(ch, abil_id, 0);
 	return data && data->purchased[skill_set];
 }
@@ -39,15 +39,11 @@ struct stats_data_struct {
 	UT_hash_handle hh;	// hashable
 };
 
-// stats globals
+// stats globals (counted at startup, then kept current by the stats_adjust_ functions)
 struct stats_data_struct *global_sector_count = NULL;	// hash table of sector counts
-int global_sector_size = 0;
 struct stats_data_struct *global_crop_count = NULL;	// hash table count of crops
-int global_crop_size = 0;
 struct stats_data_struct *global_building_count = NULL;	// hash table of building counts
-int global_building_size = 0;
 
-time_t last_world_count = 0;	// timestamp of last sector/crop/building tally
 time_t last_account_count = 0;	// timestamp of last time accounts were read
 
 int total_accounts = 0;	// including inactive
@@ -63,7 +59,7 @@ int max_players_this_uptime = 0;
 
 
 // locals
-void update_world_count();
+int update_world_count(bool verify);
 
 
  //////////////////////////////////////////////////////////////////////////////
@@ -233,10 +229,6 @@ int stats_get_building_count(bld_data *bdg) {
 		return 0;
 	}
 	
-	if (HASH_COUNT(global_building_count) != global_building_size || last_world_count + rescan_world_after < time(0)) {
-		update_world_count();
-	}
-	
 	vnum = GET_BLD_VNUM(bdg);
 	HASH_FIND_INT(global_building_count, &vnum, data);
 	return data ? data->count : 0;
@@ -255,10 +247,6 @@ int stats_get_crop_count(crop_data *cp) {
 		return 0;
 	}
 	
-	if (HASH_COUNT(global_crop_count) != global_crop_size || last_world_count + rescan_world_after < time(0)) {
-		update_world_count();
-	}
-	
 	vnum = GET_CROP_VNUM(cp);
 	HASH_FIND_INT(global_crop_count, &vnum, data);
 	
@@ -278,10 +266,6 @@ int stats_get_sector_count(sector_data *sect) {
 		return 0;
 	}
 	
-	if (HASH_COUNT(global_sector_count) != global_sector_size || last_world_count + rescan_world_after < time(0)) {
-		update_world_count();
-	}
-	
 	vnum = GET_SECT_VNUM(sect);
 	HASH_FIND_INT(global_sector_count, &vnum, data);
 	
@@ -394,84 +378,175 @@ void update_players_online_stats(void) {
 //// WORLD STATS /////////////////////////////////////////////////////////////
 
 /**
-* Updates global_sector_count, global_crop_count, global_building_count.
+* Adds to (or subtracts from) one entry in a world count table.
+*
+* @param struct stats_data_struct **table The hash table to change.
+* @param any_vnum vnum Which entry.
+* @param int amount How much to add (may be negative).
+*/
+static void adjust_world_count(struct stats_data_struct **table, any_vnum vnum, int amount) {
+	struct stats_data_struct *data;
+	
+	HASH_FIND_INT(*table, &vnum, data);
+	if (!data) {
+		CREATE(data, struct stats_data_struct, 1);
+		data->vnum = vnum;
+		HASH_ADD_INT(*table, vnum, data);
+	}
+	data->count += amount;
+}
+
+
+/**
+* Counts up the whole world (map tiles only) into fresh tables.
+*
+* @param struct stats_data_struct **sect_table The sector table to fill.
+* @param struct stats_data_struct **crop_table The crop table to fill.
+* @param struct stats_data_struct **bld_table The building table to fill.
 */
-void update_world_count(void) {
-	struct stats_data_struct *sect_inf = NULL, *crop_inf = NULL, *bld_inf = NULL, *data, *next_data;
-	any_vnum vnum, last_bld_vnum = NOTHING, last_crop_vnum = NOTHING, last_sect_vnum = NOTHING;
+static void count_world(struct stats_data_struct **sect_table, struct stats_data_struct **crop_table, struct stats_data_struct **bld_table) {
+	room_data *room, *next_room;
 	struct map_data *map;
-	room_data *room;
+	int x, y;
 	
-	// free and recreate counts
-	HASH_ITER(hh, global_sector_count, data, next_data) {
-		HASH_DEL(global_sector_count, data);
-		free(data);
+	// sectors and crops come from the map itself
+	for (x = 0; x < MAP_WIDTH; ++x) {
+		for (y = 0; y < MAP_HEIGHT; ++y) {
+			map = &(world_map[x][y]);
+			if (map->sector_type && GET_SECT_VNUM(map->sector_type) != BASIC_OCEAN) {
+				adjust_world_count(sect_table, GET_SECT_VNUM(map->sector_type), 1);
+			}
+			if (map->crop_type) {
+				adjust_world_count(crop_table, GET_CROP_VNUM(map->crop_type), 1);
+			}
+		}
 	}
-	HASH_ITER(hh, global_crop_count, data, next_data) {
-		HASH_DEL(global_crop_count, data);
-		free(data);
+	
+	// only loaded rooms can have buildings
+	HASH_ITER(hh, world_table, room, next_room) {
+		if (GET_ROOM_VNUM(room) < MAP_SIZE && GET_BUILDING(room)) {
+			adjust_world_count(bld_table, GET_BLD_VNUM(GET_BUILDING(room)), 1);
+		}
 	}
-	HASH_ITER(hh, global_building_count, data, next_data) {
-		HASH_DEL(global_building_count, data);
+}
+
+
+/**
+* Frees a world count table.
+*
+* @param struct stats_data_struct **table The table to free.
+*/
+static void free_world_count(struct stats_data_struct **table) {
+	struct stats_data_struct *data, *next_data;
+	
+	HASH_ITER(hh, *table, data, next_data) {
+		HASH_DEL(*table, data);
 		free(data);
 	}
+}
+
+
+/**
+* Compares a tracked world count table against a fresh count, and logs any
+* entries that disagree.
+*
+* @param struct stats_data_struct *tracked The live table.
+* @param struct stats_data_struct *actual The fresh count.
+* @param const char *type "sector", etc, for the log.
+* @return int The number of entries that disagree.
+*/
+static int compare_world_count(struct stats_data_struct *tracked, struct stats_data_struct *actual, const char *type) {
+	struct stats_data_struct *data, *next_data, *find;
+	int bad = 0;
 	
-	// scan world
-	for (map = land_map; map; map = map->next) {
-		// sector
-		vnum = GET_SECT_VNUM(map->sector_type);
-		if (vnum != last_sect_vnum || !sect_inf) {
-			HASH_FIND_INT(global_sector_count, &vnum, sect_inf);
-			if (!sect_inf) {
-				CREATE(sect_inf, struct stats_data_struct, 1);
-				sect_inf->vnum = vnum;
-				HASH_ADD_INT(global_sector_count, vnum, sect_inf);
-			}
-			last_sect_vnum = vnum;
-		}
-		++sect_inf->count;
-		
-		// crop
-		if (map->crop_type) {
-			vnum = GET_CROP_VNUM(map->crop_type);
-			
-			if (vnum != last_crop_vnum || !crop_inf) {
-				HASH_FIND_INT(global_crop_count, &vnum, crop_inf);
-				if (!crop_inf) {
-					CREATE(crop_inf, struct stats_data_struct, 1);
-					crop_inf->vnum = vnum;
-					HASH_ADD_INT(global_crop_count, vnum, crop_inf);
-				}
-				last_crop_vnum = vnum;
-			}
-			
-			++crop_inf->count;
+	HASH_ITER(hh, tracked, data, next_data) {
+		HASH_FIND_INT(actual, &data->vnum, find);
+		if (data->count != (find ? find->count : 0)) {
+			log("SYSERR: world count for %s %d is %d but should be %d", type, data->vnum, data->count, find ? find->count : 0);
+			++bad;
 		}
-		
-		// any further data?
-		if (!(room = real_real_room(map->vnum))) {
-			continue;
-		}
-		
-		// building?
-		vnum = BUILDING_VNUM(room);
-		if (vnum != NOTHING) {
-			if (vnum != last_bld_vnum) {
-				HASH_FIND_INT(global_building_count, &vnum, bld_inf);
-				if (!bld_inf) {
-					CREATE(bld_inf, struct stats_data_struct, 1);
-					bld_inf->vnum = vnum;
-					HASH_ADD_INT(global_building_count, vnum, bld_inf);
-				}
-				last_bld_vnum = vnum;
-			}
-			
-			++bld_inf->count;
+	}
+	HASH_ITER(hh, actual, data, next_data) {
+		HASH_FIND_INT(tracked, &data->vnum, find);
+		if (!find) {
+			log("SYSERR: world count for %s %d is missing but should be %d", type, data->vnum, data->count);
+			++bad;
 		}
 	}
 	
-	last_world_count = time(0);
-	global_sector_size = HASH_COUNT(global_sector_count);
-	global_crop_size = HASH_COUNT(global_crop_count);
-	global_building_size = HASH_COUNT(global_building_count);
+	return bad;
+}
+
+
+/**
+* Updates the count for a building on the map. This is called whenever a map
+* room gains or loses a building.
+*
+* @param bld_data *bdg The building type.
+* @param int amount How many were added (negative for removed).
+*/
+void stats_adjust_building_count(bld_data *bdg, int amount) {
+	if (bdg) {
+		adjust_world_count(&global_building_count, GET_BLD_VNUM(bdg), amount);
+	}
+}
+
+
+/**
+* Updates the count for a crop on the map. This is called whenever a map
+* tile's crop changes.
+*
+* @param crop_data *cp The crop type.
+* @param int amount How many were added (negative for removed).
+*/
+void stats_adjust_crop_count(crop_data *cp, int amount) {
+	if (cp) {
+		adjust_world_count(&global_crop_count, GET_CROP_VNUM(cp), amount);
+	}
+}
+
+
+/**
+* Updates the count for a sector on the map. This is called whenever a map
+* tile's sector changes. Ocean is not counted.
+*
+* @param sector_data *sect The sector type.
+* @param int amount How many were added (negative for removed).
+*/
+void stats_adjust_sector_count(sector_data *sect, int amount) {
+	if (sect && GET_SECT_VNUM(sect) != BASIC_OCEAN) {
+		adjust_world_count(&global_sector_count, GET_SECT_VNUM(sect), amount);
+	}
+}
+
+
+/**
+* Recounts global_sector_count, global_crop_count, global_building_count from
+* scratch. This is done once at startup; after that, the counts are kept up
+* to date as the world changes.
+*
+* @param bool verify If TRUE, logs any counts that had drifted from the recount.
+* @return int The number of counts that had drifted (always 0 if !verify).
+*/
+int update_world_count(bool verify) {
+	struct stats_data_struct *sect_table = NULL, *crop_table = NULL, *bld_table = NULL;
+	int bad = 0;
+	
+	count_world(&sect_table, &crop_table, &bld_table);
+	
+	if (verify) {
+		bad += compare_world_count(global_sector_count, sect_table, "sector");
+		bad += compare_world_count(global_crop_count, crop_table, "crop");
+		bad += compare_world_count(global_building_count, bld_table, "building");
+	}
+	
+	// swap in the fresh counts
+	free_world_count(&global_sector_count);
+	free_world_count(&global_crop_count);
+	free_world_count(&global_building_count);
+	global_sector_count = sect_table;
+	global_crop_count = crop_table;
+	global_building_count = bld_table;
+	
+	return bad;
 }
@@ -103,6 +103,10 @@
 
 #define COIN_VALUE  0.1	// value of a coin as compared to 1 wealth (0.1 coin value = 10 coins per wealth)
 
+// TRUE to fill freed slab slots (objs, chars, rooms, affects, etc) with junk
+// and check them on reuse, to catch use-after-free bugs; this is slower
+#define SLAB_POISON  FALSE
+
 // ***WARNING*** Change this before starting your playerfile
 // but NEVER change it after, or you may not be able to log in to any character
 // NOTE: You should use a salt starting with "$5$" and ending with "$" in order
@@ -298,6 +302,16 @@ typedef struct vehicle_data vehicle_data;
 #define GLB_FLAG_CHOOSE_LAST  BIT(3)	// the first choose-last global that passes is saved for later, if nothing else is chosen
 
 
+// KWI_x: keyword_index types
+#define KWI_CHAR  0	// char_data (mobs and players in the world)
+#define KWI_OBJ  1	// obj_data (in the object_list)
+#define KWI_VEHICLE  2	// vehicle_data (in the world)
+#define NUM_KWI  3	// total
+
+// keyword_index buckets things by this many leading letters of each keyword
+#define KEYWORD_INDEX_PREFIX  3
+
+
 // Group Defines
 #define GROUP_ANON  BIT(0)	// Group is hidden/anonymous
 
@@ -375,6 +389,16 @@ typedef struct vehicle_data vehicle_data;
 #define SKILLF_IN_DEVELOPMENT  BIT(0)	// a. not live, won't show up on skill lists
 
 
+// SLAB_x: pools for frequently-created structs (see slab_alloc in utils.c)
+#define SLAB_OBJ  0	// obj_data
+#define SLAB_CHAR  1	// char_data
+#define SLAB_ROOM  2	// room_data
+#define SLAB_AFFECT  3	// struct affected_type
+#define SLAB_TRACK  4	// struct track_data
+#define SLAB_QUEUE_ELEMENT  5	// struct q_element
+#define NUM_SLABS  6	// total
+
+
 // mob spawn flags
 #define SPAWN_NOCTURNAL  BIT(0)	// a. only spawns at night
 #define SPAWN_DIURNAL  BIT(1)	// b. only spawns during day
@@ -850,6 +874,12 @@ typedef struct vehicle_data vehicle_data;
 #define NUM_CHORES  28		// total
 
 
+// workforce citizens are indexed by map area (see add_npc_to_worker_cells)
+#define WORKER_CELL_SIZE  10	// map tiles per side of a cell
+#define WORKER_CELLS_WIDE  ((MAP_WIDTH + WORKER_CELL_SIZE - 1) / WORKER_CELL_SIZE)
+#define WORKER_CELL_MOBILE  -1	// cell for homes with no fixed map location (e.g. in vehicles)
+
+
 /* Diplomacy types */
 #define DIPL_PEACE  BIT(0)	// At peace
 #define DIPL_WAR  BIT(1)	// At war
@@ -1020,6 +1050,44 @@ typedef struct vehicle_data vehicle_data;
 #define PK_REVENGE  BIT(2)	// pk when someone has pk'd you
 
 
+// CONF_x: configs read by hot code from typed, pre-resolved slots (see
+// config_slots[] and CONFIG_INT() etc. in utils.h) instead of by string key.
+// Each is X(CONF_x, "key", type) where type is the CONFTYPE_x suffix; the
+// string-key functions still work for these, too.
+#define CONFIG_SLOT_LIST(X) \
+	X(CONF_ALLOW_EXTENDED_COLOR_CODES, "allow_extended_color_codes", BOOL) \
+	X(CONF_BLOOD_STARVATION_LEVEL, "blood_starvation_level", INT) \
+	X(CONF_CHORE_DISTANCE, "chore_distance", INT) \
+	X(CONF_COMMON_DEPLETION, "common_depletion", INT) \
+	X(CONF_DEFAULT_MAP_SIZE, "default_map_size", INT) \
+	X(CONF_DISREPAIR_MAJOR, "disrepair_major", INT) \
+	X(CONF_DISREPAIR_MINOR, "disrepair_minor", INT) \
+	X(CONF_HIGH_DEPLETION, "high_depletion", INT) \
+	X(CONF_INPUT_BYTE_BURST, "input_byte_burst", INT) \
+	X(CONF_INPUT_BYTES_PER_SECOND, "input_bytes_per_second", INT) \
+	X(CONF_INPUT_COMMAND_BURST, "input_command_burst", INT) \
+	X(CONF_INPUT_COMMANDS_PER_SECOND, "input_commands_per_second", INT) \
+	X(CONF_MAX_INPUT_QUEUE, "max_input_queue", INT) \
+	X(CONF_MAX_MAP_SIZE, "max_map_size", INT) \
+	X(CONF_MAX_MAP_WHILE_MOVING, "max_map_while_moving", INT) \
+	X(CONF_MAX_NPC_ATTRIBUTE, "max_npc_attribute", INT) \
+	X(CONF_MAX_PLAYER_ATTRIBUTE, "max_player_attribute", INT) \
+	X(CONF_MOB_DESPAWN_RADIUS, "mob_despawn_radius", INT) \
+	X(CONF_MOB_PURSUIT_DISTANCE, "mob_pursuit_distance", INT) \
+	X(CONF_MOB_PURSUIT_TIMEOUT, "mob_pursuit_timeout", INT) \
+	X(CONF_MOB_SPAWN_INTERVAL, "mob_spawn_interval", INT) \
+	X(CONF_MOB_SPAWN_RADIUS, "mob_spawn_radius", INT) \
+	X(CONF_NEARBY_SECTOR_DISTANCE, "nearby_sector_distance", INT) \
+	X(CONF_POOL_BONUS_AMOUNT, "pool_bonus_amount", INT) \
+	X(CONF_SPAWN_LIMIT_PER_ROOM, "spawn_limit_per_room", INT) \
+	X(CONF_STOLEN_OBJECT_TIMER, "stolen_object_timer", INT) \
+	X(CONF_TIME_TO_EMPIRE_EMPTINESS, "time_to_empire_emptiness", INT) \
+	X(CONF_WHOLE_EMPIRE_TIMEOUT, "whole_empire_timeout", INT)
+
+#define CONFIG_SLOT_ENUM(slot, key, type)  slot,
+enum config_slot_type { CONFIG_SLOT_LIST(CONFIG_SLOT_ENUM) NUM_CONFIG_SLOTS };
+
+
 // mud-life time
 #define SECS_PER_MUD_HOUR  75
 #define SECS_PER_MUD_DAY  (24 * SECS_PER_MUD_HOUR)
@@ -1068,6 +1136,18 @@ typedef struct vehicle_data vehicle_data;
 #define SHUTDOWN_DIE  2	// kills the autorun
 
 
+// MSDP_DIRTY_x: groups of derived MSDP variables that must be recomputed
+#define MSDP_DIRTY_CHARACTER  BIT(0)	// names, class, levels
+#define MSDP_DIRTY_REGEN  BIT(1)	// health/mana/move regen
+#define MSDP_DIRTY_AFFECTS  BIT(2)	// affects and dots tables
+#define MSDP_DIRTY_SKILLS  BIT(3)	// skills table
+#define MSDP_DIRTY_COMBAT  BIT(4)	// block, dodge, to-hit, speed, healing
+#define MSDP_DIRTY_EMPIRE  BIT(5)	// empire name, rank, territory, score
+#define MSDP_DIRTY_ALL  (BIT(6) - 1)
+
+#define MSDP_FULL_REFRESH  30	// seconds between full recomputes, for inputs that raise no flag
+
+
  //////////////////////////////////////////////////////////////////////////////
 //// MOBILE DEFINES //////////////////////////////////////////////////////////
 
@@ -1734,6 +1814,7 @@ typedef struct vehicle_data vehicle_data;
 #define PRF_AUTODISMOUNT  BIT(29)	// will dismount while moving instead of seeing an error
 #define PRF_NOEMPIRE  BIT(30)	// the game will not automatically create an empire
 #define PRF_CLEARMETERS  BIT(31)	// automatically clears the damage meters before a new fight
+#define PRF_OOB_MAP  BIT(32)	// sends the map over MSDP (if the client asked for MAP) instead of as text
 
 
 // summon types for oval_summon, ofin_summon, and add_offer
@@ -2285,6 +2366,26 @@ struct interaction_item {
 };
 
 
+// inverted index from keyword prefixes to live things: keyword_index[KWI_x]
+struct keyword_index {
+	char prefix[KEYWORD_INDEX_PREFIX + 1];	// lowercase leading letters of a keyword (hash key)
+	struct keyword_index_ref *refs;	// DL of things with a keyword starting with prefix
+	
+	UT_hash_handle hh;	// keyword_index[type] hash
+};
+
+
+// links one live thing to one keyword_index bucket
+struct keyword_index_ref {
+	void *thing;	// char_data, obj_data, or vehicle_data, by KWI_x type
+	struct keyword_index *index;	// which bucket this is in
+	unsigned long long seq;	// the thing's list_seq: buckets are kept newest-first, like the global lists
+	
+	struct keyword_index_ref *prev, *next;	// DL in index->refs
+	struct keyword_index_ref *next_for_thing;	// LL of all the thing's refs
+};
+
+
 // see morph.c
 struct morph_data {
 	any_vnum vnum;
@@ -2411,6 +2512,30 @@ struct slash_channel {
 };
 
 
+// utils.c: one block of slots in a slab_pool
+struct slab_block {
+	char *data;	// per_block * size bytes
+	struct slab_block *next;
+};
+
+
+// utils.c: a pool of same-sized structs that are reused instead of freed
+struct slab_pool {
+	const char *name;
+	size_t size;	// bytes per slot
+	int per_block;	// slots per block
+	
+	struct slab_block *blocks;	// all blocks (never released)
+	int num_blocks;
+	int unused_in_block;	// never-used slots left at the end of the newest block
+	void *free_list;	// freed slots, linked through their first bytes
+	
+	// stats
+	int in_use, peak;
+	unsigned long long total_allocs, total_frees;
+};
+
+
 // for mob spawning in sects, buildings, etc
 struct spawn_info {
 	mob_vnum vnum;
@@ -2542,16 +2667,20 @@ struct instance_data {
 	int size;	// size of room arrays
 	room_data **room;	// array of rooms (some == NULL)
 	struct instance_mob *mob_counts;	// hash table (hh)
+	struct instance_mob *obj_counts;	// hash table (hh) of objs on the ground in the instance
+	struct instance_mob *vehicle_counts;	// hash table (hh) of vehicles in the instance
+	int player_count;	// players (including immortals) in the instance's rooms
 	
+	UT_hash_handle hh;	// instance_table
 	struct instance_data *next;
 };
 
 
-// tracks the mobs in an instance
+// tracks the mobs (or objs/vehicles) in an instance, by vnum
 struct instance_mob {
 	mob_vnum vnum;
 	int count;
-	UT_hash_handle hh;	// instance->mob_counts
+	UT_hash_handle hh;	// instance->mob_counts, obj_counts, vehicle_counts
 };
 
 
@@ -2906,6 +3035,25 @@ struct player_index_data {
 };
 
 
+// hash of name words for in-game players: player_name_index
+struct player_name_index {
+	char *keyword;	// lowercase name word (hash key)
+	struct player_name_ref *refs;	// DL of players with this word
+	
+	UT_hash_handle hh;	// player_name_index hash
+};
+
+
+// links an in-game player to one entry in the player_name_index
+struct player_name_ref {
+	char_data *ch;	// the player
+	struct player_name_index *index;	// which word this is
+	
+	struct player_name_ref *prev, *next;	// DL in index->refs
+	struct player_name_ref *next_for_char;	// LL in GET_NAME_INDEX_REFS(ch)
+};
+
+
 // for descriptor_data
 struct txt_block {
 	char *text;
@@ -2915,10 +3063,26 @@ struct txt_block {
 };
 
 
-// for descriptor_data
+// for txt_q: one queued line
+struct txt_q_line {
+	size_t pos;	// where the line's text starts in txt_q.text
+	size_t len;	// length of the text, not counting the \0
+	int aliased;
+};
+
+
+// for descriptor_data: input queue, kept as two ring buffers that grow as
+// needed and are reused, so queueing a line does not allocate
 struct txt_q {
-	struct txt_block *head;
-	struct txt_block *tail;
+	char *text;	// line text, each line \0-terminated and unbroken
+	size_t text_size;	// allocated size of text
+	size_t text_head;	// start of the first line's text
+	size_t text_tail;	// end of the last line's text (may wrap below text_head)
+	
+	struct txt_q_line *lines;	// ring of queued lines
+	int size;	// allocated size of lines
+	int head;	// index of the first line
+	int count;	// number of lines queued
 };
 
 
@@ -2935,6 +3099,15 @@ struct color_reducer {
 };
 
 
+// for descriptor_data, the last map frame sent over MSDP (mapview.c)
+struct map_oob_frame {
+	int rows, cols;	// size of the frame, as displayed
+	int center;	// index of the viewer's own tile
+	room_vnum *vnums;	// rows * cols: which map tile was shown at each spot (NOWHERE for none)
+	char **tiles;	// rows * cols: each tile as it was sent
+};
+
+
 // descriptors -- the connection to the game
 struct descriptor_data {
 	socket_t descriptor;	// file descriptor for socket
@@ -2979,6 +3152,15 @@ struct descriptor_data {
 	bool data_left_to_write;	// indicates there is more data to write, to prevent an extra crlf
 	struct txt_block *large_outbuf;	// ptr to large buffer, if we need it
 	struct txt_q input;	// q of unprocessed input
+	
+	// input rate limits (token buckets refilled each pulse; see game_loop)
+	double cmd_tokens;	// commands this descriptor may run before it must wait
+	double byte_tokens;	// bytes it may send before its socket is left unread
+	unsigned long input_refill_pulse;	// pulse the buckets were last refilled
+	unsigned long input_commands;	// total commands run
+	unsigned long input_bytes;	// total bytes read
+	unsigned long input_deferred;	// pulses it was held back by the limits
+	unsigned long input_dropped;	// lines discarded because the queue was full
 
 	char_data *character;	// linked to char
 	char_data *original;	// original char if switched
@@ -2987,6 +3169,15 @@ struct descriptor_data {
 	descriptor_data *snoop_by;	// And who is snooping this char
 
 	char *last_act_message;	// stores the last thing act() sent to this desc
+	struct map_oob_frame *map_oob;	// last map frame sent over MSDP, if any
+	
+	// msdp
+	bitvector_t msdp_dirty;	// MSDP_DIRTY_x groups to recompute on the next msdp_update()
+	int msdp_refresh;	// seconds until the next full recompute
+	unsigned int msdp_regen_key;	// summary of the inputs to health_gain() etc, last time they were computed
+	empire_data *msdp_empire;	// empire, rank, and empire version last computed
+	int msdp_rank;
+	int msdp_empire_version;
 	
 	// olc
 	int olc_type;	// OLC_OBJECT, etc -- only when an editor is open
@@ -3082,6 +3273,16 @@ struct player_skill_data {
 };
 
 
+// dense copy of a player's skill/ability hashes, for hot lookups (see update_skill_cache)
+struct player_skill_cache {
+	bitvector_t *abilities;	// 1 bit per ability vnum: purchased in the current skill set
+	int ability_words;	// size of the abilities array
+	int *levels;	// skill level by skill vnum
+	int num_levels;	// size of the levels array
+	bool valid;	// FALSE = rebuild before the next lookup
+};
+
+
 // channels a player is on
 struct player_slash_channel {
 	int id;
@@ -3233,6 +3434,8 @@ struct player_special_data {
 	bool needs_delayed_load;	// whether or not the player still needs delayed data
 	bool restore_on_login;	// mark the player to trigger a free reset when they enter the game
 	bool reread_empire_tech_on_login;	// mark the player to trigger empire tech re-read on entering the game
+	struct player_name_ref *name_index_refs;	// this player's entries in player_name_index (while in-game)
+	struct player_skill_cache skill_cache;	// for has_ability()/get_skill_level()
 };
 
 
@@ -3354,6 +3557,7 @@ struct char_data {
 	char_data *next_in_room;	// For room->people - list
 	char_data *next;	// For either monster or ppl-list
 	char_data *next_fighting;	// For fighting list
+	char_data *prev_plr, *next_plr;	// For player_character_list (in-game players)
 	
 	struct follow_type *followers;	// List of chars followers
 	char_data *master;	// Who is char following?
@@ -3364,6 +3568,9 @@ struct char_data {
 	
 	// live data (not saved, not freed)
 	struct quest_lookup *quest_lookups;
+	unsigned long long list_seq;	// when it joined character_list (keyword_index order)
+	struct keyword_index_ref *keyword_refs;	// entries in keyword_index[KWI_CHAR]
+	char *keyword_index_src;	// GET_PC_NAME() that was indexed, to detect restrings
 	
 	UT_hash_handle hh;	// mobile_table
 };
@@ -3640,10 +3847,23 @@ struct empire_npc_data {
 	
 	empire_vnum empire_id;	// empire vnum
 	char_data *mob;
+	
+	struct empire_npc_cell *cell;	// workforce index cell (citizens only)
+	struct empire_npc_data *prev_in_cell, *next_in_cell;	// cell's doubly-linked list
+	
 	struct empire_npc_data *next;	// linked list
 };
 
 
+// citizens bucketed by where they live, so workforce can find nearby ones
+struct empire_npc_cell {
+	int cell;	// x/WORKER_CELL_SIZE + y/WORKER_CELL_SIZE * WORKER_CELLS_WIDE, or WORKER_CELL_MOBILE
+	struct empire_npc_data *npcs;	// list (by next_in_cell)
+	
+	UT_hash_handle hh;	// EMPIRE_NPC_CELLS(emp) hash handle
+};
+
+
 // The political structure for the empires
 struct empire_political_data {
 	empire_vnum id;	// vnum of the other empire
@@ -3668,14 +3888,29 @@ struct empire_storage_data {
 
 // list of rooms and buildings owned
 struct empire_territory_data {
+	room_vnum vnum;	// hash key: GET_ROOM_VNUM(room)
 	room_data *room;	// pointer to territory location
 	int population_timer;	// time to re-populate
 	
 	struct empire_npc_data *npcs;	// list of empire mobs that live here
 	
+	bitvector_t chores;	// CHORE_x worklists this is in (as BIT(chore))
+	struct empire_chore_room *chore_rooms;	// its worklist entries (by next_in_ter)
+	
 	bool marked;	// for checking that rooms still exist
 	
 	struct empire_territory_data *next;	// linked list
+	UT_hash_handle hh;	// EMPIRE_TERRITORY_HASH(emp) hash handle
+};
+
+
+// one territory entry's place in an empire's per-chore worklist
+struct empire_chore_room {
+	struct empire_territory_data *ter;	// the territory it's for
+	int chore;	// which CHORE_x list it's in
+	
+	struct empire_chore_room *prev, *next;	// EMPIRE_CHORE_ROOMS(emp, chore) doubly-linked list
+	struct empire_chore_room *next_in_ter;	// ter->chore_rooms list
 };
 
 
@@ -3751,6 +3986,8 @@ struct empire_data {
 	
 	// unsaved data
 	struct empire_territory_data *territory_list;	// linked list of buildings/rooms
+	struct empire_territory_data *territory_hash;	// same entries, hashed by room vnum
+	struct empire_chore_room *chore_rooms[NUM_CHORES];	// territory that may have work, by chore
 	struct empire_city_data *city_list;	// linked list of cities
 	struct empire_workforce_tracker *ewt_tracker;	// workforce tracker
 	
@@ -3765,6 +4002,7 @@ struct empire_data {
 	int greatness;	// total greatness of members
 	int tech[NUM_TECHS];	// TECH_x, detected from buildings and abilities
 	struct empire_island *islands;	// empire island data hash
+	struct empire_npc_cell *npc_cells;	// hash of citizens by map area (for workforce)
 	int members;	// Number of members, calculated at boot time
 	int total_member_count;	// Total number of members including timeouts and dupes
 	int total_playtime;	// total playtime among all accounts, in hours
@@ -3776,6 +4014,8 @@ struct empire_data {
 	bool storage_loaded;	// record whether or not storage has been loaded, to prevent saving over it
 	int top_shipping_id;	// shipping system quick id for the empire
 	bool banner_has_underline;	// helper
+	char mapout_token;	// helper: political map color for the banner
+	int msdp_version;	// bumped when the empire's MSDP values (territory, score, etc) change
 	
 	bool needs_save;	// for things that delay-save
 	
@@ -3864,6 +4104,15 @@ struct message_list {
  //////////////////////////////////////////////////////////////////////////////
 //// GAME STRUCTS ////////////////////////////////////////////////////////////
 
+// a pre-resolved config value (CONF_x); the config system keeps these updated
+union config_slot_data {
+	bitvector_t bitvector_val;
+	bool bool_val;
+	double double_val;
+	int int_val;
+};
+
+
 // For reboots/shutdowns
 struct reboot_control_data {
 	int type;	// SCMD_REBOOT, SCMD_SHUTDOWN
@@ -3952,6 +4201,20 @@ struct obj_data {
 	struct quest_lookup *quest_lookups;
 	bool search_mark;
 	
+	bool in_object_list;	// TRUE while in the global object_list
+	unsigned long long list_seq;	// when it joined object_list (keyword_index order)
+	struct keyword_index_ref *keyword_refs;	// entries in keyword_index[KWI_OBJ]
+	char *keyword_index_src;	// GET_OBJ_KEYWORDS() that was indexed, to detect restrings
+	
+	// decay timer wheel and autostore queue (limits.c)
+	bool timer_running;	// if TRUE, timer_expires holds the real decay timer
+	long timer_expires;	// timer wheel tick on which the decay timer hits 0
+	bool timer_queued;	// TRUE if linked into a timer wheel slot
+	int timer_level, timer_slot;	// which timer wheel slot
+	obj_data *timer_prev, *timer_next;	// doubly-linked list for that slot
+	bool in_autostore_queue;	// TRUE if in the autostore queue
+	obj_data *autostore_prev, *autostore_next;	// doubly-linked autostore queue
+	
 	UT_hash_handle hh;	// object_table hash
 };
 
@@ -4185,6 +4448,9 @@ struct vehicle_data {
 	// lists
 	struct vehicle_data *next;	// vehicle_list (global) linked list
 	struct vehicle_data *next_in_room;	// ROOM_VEHICLES(room) linked list
+	unsigned long long list_seq;	// when it joined vehicle_list (keyword_index order)
+	struct keyword_index_ref *keyword_refs;	// entries in keyword_index[KWI_VEHICLE]
+	char *keyword_index_src;	// VEH_KEYWORDS() that was indexed, to detect restrings
 	UT_hash_handle hh;	// vehicle_table hash handle
 };
 
@@ -4285,6 +4551,28 @@ struct room_data {
 	
 	UT_hash_handle hh;	// hash handle for world_table
 	room_data *next_interior;	// linked list: interior_room_list
+	room_data *prev_in_home, *next_in_home;	// doubly-linked list: COMPLEX_DATA(home_room)->interior_rooms
+	
+	// world block lists (db.lib.c)
+	struct world_block_data *block;	// which world block this room is in
+	room_data *prev_in_block, *next_in_block;	// doubly-linked list: block->rooms, in vnum order
+	bool in_update_list;	// TRUE while in block->update_rooms
+	room_data *prev_update, *next_update;	// doubly-linked list: block->update_rooms
+	
+	// map icon cache (mapview.c)
+	char *map_icon[NUM_SIMPLE_DIRS];	// this tile as shown with normal colors, by the viewer's north (NULL if not cached)
+	int map_icon_tileset;	// pick_season() it was cached for
+	int map_icon_version;	// map_icon_cache_version it was cached in
+};
+
+
+// world_block_table: rooms are grouped by GET_WORLD_BLOCK() for saving and updating
+struct world_block_data {
+	int block;	// GET_WORLD_BLOCK() of the rooms in it
+	room_data *rooms;	// DLL of all rooms in the block, in vnum order (next_in_block)
+	room_data *update_rooms;	// DLL of rooms that need periodic updates (next_update)
+	
+	UT_hash_handle hh;	// world_block_table, sorted by block
 };
 
 
@@ -4303,6 +4591,7 @@ struct complex_room_data {
 	int patron;  // for shrine gods
 	byte inside_rooms;  // count of designated rooms inside
 	room_data *home_room;  // for interior rooms (and boats and instances), means this is actually part of another room; is saved as vnum to file but is room_data* in real life
+	room_data *interior_rooms;	// DLL of rooms whose home_room is this one (next_in_home); maintained by set_room_home()
 	
 	int disrepair;	// UNUSED: as of b4.15 this is 0 for all buildings and not used (but is saved to file and coule be repurposed)
 	
@@ -4401,6 +4690,8 @@ struct map_data {
 	
 	crop_data *crop_type;	// possible crop type
 	
+	room_data *room;	// the live room, if it's in memory (maintained by add_room_to_world_tables)
+	
 	// lists
 	struct map_data *next_in_sect;	// LL of all map locations of a given sect
 	struct map_data *next_in_base_sect;	// LL for base sect
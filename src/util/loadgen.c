@@ -0,0 +1,1140 @@
+/* ************************************************************************
+*   File: loadgen.c                                       EmpireMUD 2.0b5 *
+*  Usage: headless load generator that drives a running mud with clients  *
+*                                                                         *
+*  EmpireMUD code base by Paul Clarke, (C) 2000-2015                      *
+*  All rights reserved.  See license.doc for complete information.        *
+*                                                                         *
+*  EmpireMUD based upon CircleMUD 3.0, bpl 17, by Jeremy Elson.           *
+*  CircleMUD (C) 1993, 94 by the Trustees of the Johns Hopkins University *
+*  CircleMUD is based on DikuMUD, Copyright (C) 1990, 1991.               *
+************************************************************************ */
+
+/**
+* This connects a number of simulated telnet clients to a running mud, logs
+* each one in (creating a throwaway character the first time), and has them
+* play a script over and over. It reports per-command latency percentiles
+* and, if given an immortal to log in with, how many pulses the server
+* overran during the run.
+*
+* Usage: loadgen [options]
+*   -h <host>      server to connect to (default 127.0.0.1)
+*   -p <port>      port (default 4000)
+*   -c <clients>   number of simulated players (default 10)
+*   -d <seconds>   how long to run once everyone is logged in (default 60)
+*   -r <ms>        delay between connecting each client (default 100)
+*   -t <ms>        think time between commands (default 250)
+*   -T <seconds>   how long to wait for a command's prompt (default 10)
+*   -s <scripts>   comma-separated scripts, assigned to clients round-robin:
+*                  walk, look, combat, craft, chat, workforce, or a filename
+*                  (default look,walk,chat)
+*   -n <prefix>    character name prefix (default Loadbot)
+*   -w <password>  password for the throwaway characters (default loadgen)
+*   -i <name:pass> immortal to read pulse overruns from 'uptime' with (its
+*                  prompt is left alone; it waits for the 'uptime' output)
+*   -b             don't give each client its own loopback address
+*
+* Steps:
+*  1. boot the mud; consider setting 'nameserver_is_slow' so it doesn't try
+*     to resolve 127.x.x.x addresses
+*  2. run ./bin/loadgen with the options for the test you want
+*  3. run the same test again after a change and compare the numbers
+*
+* Clients' characters are named <prefix><aaa, aab, ...> and are re-used on
+* later runs with the same prefix and password. The mud only allows one
+* character per IP, so when the server is on a loopback address each client
+* connects from its own 127.1.x.y address (Linux routes all of 127/8 to lo).
+*
+* Script files have one command per line. Blank lines and lines starting
+* with # are ignored. "@setup <command>" runs once after logging in, and
+* "@wait <ms>" pauses the script.
+*/
+
+#include "conf.h"
+#include "sysdep.h"
+
+#include "structs.h"
+
+
+// tunables
+#define LG_BUF_SIZE  16384	// recent output kept per client
+#define LG_MAX_CLIENTS  (FD_SETSIZE - 16)
+#define LG_PROMPT_MARK  "LGEN>"	// player clients set their prompt to this
+#define LG_LOGIN_TIMEOUT  30	// seconds to get into the game
+
+
+// client states
+#define LG_LOGIN  0	// answering the login/creation prompts
+#define LG_ENTERING  1	// waiting for the first marked prompt
+#define LG_IDLE  2	// thinking until wake_at
+#define LG_BUSY  3	// waiting for the prompt after a command
+#define LG_DONE  4	// finished the run
+#define LG_FAILED  5	// gave up on this client
+
+
+// telnet/ansi filter states
+#define TS_DATA  0
+#define TS_IAC  1
+#define TS_OPT  2
+#define TS_SB  3
+#define TS_SB_IAC  4
+
+#define AS_DATA  0
+#define AS_ESC  1
+#define AS_CSI  2
+
+#define IAC_BYTE  255
+#define SB_BYTE  250
+#define SE_BYTE  240
+#define WILL_BYTE  251
+#define DONT_BYTE  254
+
+#ifndef TRUE
+#define TRUE  1
+#define FALSE  0
+#endif
+
+#ifndef MAX
+#define MAX(a, b)  ((a) > (b) ? (a) : (b))
+#define MIN(a, b)  ((a) < (b) ? (a) : (b))
+#endif
+
+
+// one line of a script
+struct lg_step {
+	char *cmd;	// NULL for a pause
+	int wait_ms;
+};
+
+
+// a named list of commands
+struct lg_script {
+	char *name;
+	char **setup;
+	int num_setup;
+	struct lg_step *steps;
+	int num_steps;
+};
+
+
+// latency samples for one command word
+struct lg_stat {
+	char label[32];
+	double *samples;	// ms
+	int count, size;
+	int timeouts;
+};
+
+
+// one simulated player
+struct lg_client {
+	int id;
+	int fd;
+	int state;
+	int is_observer;	// the immortal that reads 'uptime'
+	char name[MAX_NAME_LENGTH + 1];
+	char *password;
+	struct lg_script *script;
+	int setup_pos, step_pos;
+
+	char text[LG_BUF_SIZE];	// filtered output since the last command
+	size_t len;
+	int telnet_state, ansi_state;
+
+	double sent_at;	// ms: when the pending command went out
+	double wake_at;	// ms: when to send the next command
+	struct lg_stat *pending;	// where to record the pending command
+	char *fail_reason;
+};
+
+
+// built-in scripts, in script-file format
+const char *builtin_scripts[][2] = {
+	{ "walk", "north\nnorth\neast\neast\nsouth\nsouth\nwest\nwest\nlook\n" },
+	{ "look", "look\nscore\ninventory\nequipment\nwho\nnearby\n" },
+	{ "combat", "look\nkill deer\nkill rabbit\nkill boar\nkill sheep\nkill wolf\n@wait 2000\nflee\nscore\n" },
+	{ "craft", "craft\nforge\nsew\ncook\nbrew\ninventory\n" },
+	{ "chat", "@setup /join loadgen\nsay Testing, testing.\n/loadgen Hello from the load generator.\nemote waves.\nwho\n/who loadgen\n" },
+	{ "workforce", "@setup claim\n@setup workforce chopping on all\n@setup workforce farming on all\nworkforce\neinventory\nterritory\nestats\nempires\nlook\n" },
+	{ "\n", "\n" }
+};
+
+
+// options
+char *opt_host = "127.0.0.1";
+int opt_port = 4000;
+int opt_clients = 10;
+int opt_duration = 60;
+int opt_ramp_ms = 100;
+int opt_think_ms = 250;
+int opt_timeout = 10;
+char *opt_scripts = "look,walk,chat";
+char *opt_prefix = "Loadbot";
+char *opt_password = "loadgen";
+char *opt_observer = NULL;
+int opt_bind = TRUE;
+
+// run data
+struct lg_client *clients = NULL;
+int num_clients = 0;
+struct lg_script **scripts = NULL;
+int num_scripts = 0;
+struct lg_stat *stats = NULL;
+int num_stats = 0, size_stats = 0;
+struct sockaddr_in server_addr;
+unsigned long overruns_at_start = 0, behind_at_start = 0;
+unsigned long overruns_at_end = 0, behind_at_end = 0;
+int have_overruns = 0;
+
+
+ //////////////////////////////////////////////////////////////////////////////
+//// UTILITIES ///////////////////////////////////////////////////////////////
+
+/**
+* @return double The current time in milliseconds.
+*/
+double now_ms(void) {
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+	return tv.tv_sec * 1000.0 + tv.tv_usec / 1000.0;
+}
+
+
+/**
+* Like strdup() but exits on failure.
+*
+* @param const char *str The string to copy.
+* @return char* A new copy.
+*/
+char *lg_strdup(const char *str) {
+	char *copy = strdup(str);
+	if (!copy) {
+		perror("strdup");
+		exit(1);
+	}
+	return copy;
+}
+
+
+/**
+* Like realloc() but exits on failure.
+*
+* @param void *ptr The old block (or NULL).
+* @param size_t size The new size.
+* @return void* The new block.
+*/
+void *lg_realloc(void *ptr, size_t size) {
+	void *block = realloc(ptr, size);
+	if (!block) {
+		perror("realloc");
+		exit(1);
+	}
+	return block;
+}
+
+
+/**
+* Finds (or adds) the latency stats for a command's first word.
+*
+* @param const char *cmd The command as sent.
+* @return struct lg_stat* Its stats.
+*/
+struct lg_stat *find_stat(const char *cmd) {
+	char label[32];
+	int iter;
+
+	// command word: slash-channels are all "/"
+	if (*cmd == '/') {
+		strcpy(label, "/channel");
+	}
+	else {
+		for (iter = 0; cmd[iter] && !isspace(cmd[iter]) && iter < sizeof(label) - 1; ++iter) {
+			label[iter] = cmd[iter];
+		}
+		label[iter] = '\0';
+	}
+
+	for (iter = 0; iter < num_stats; ++iter) {
+		if (!strcmp(stats[iter].label, label)) {
+			return &stats[iter];
+		}
+	}
+
+	if (num_stats >= size_stats) {
+		size_stats = size_stats ? size_stats * 2 : 16;
+		stats = lg_realloc(stats, sizeof(struct lg_stat) * size_stats);
+	}
+	memset(&stats[num_stats], 0, sizeof(struct lg_stat));
+	strcpy(stats[num_stats].label, label);
+	return &stats[num_stats++];
+}
+
+
+/**
+* Adds one latency sample.
+*
+* @param struct lg_stat *st The stats to add to.
+* @param double ms The latency.
+*/
+void add_sample(struct lg_stat *st, double ms) {
+	if (st->count >= st->size) {
+		st->size = st->size ? st->size * 2 : 64;
+		st->samples = lg_realloc(st->samples, sizeof(double) * st->size);
+	}
+	st->samples[st->count++] = ms;
+}
+
+
+// qsort helper for latencies
+int compare_doubles(const void *a, const void *b) {
+	double x = *(const double*)a, y = *(const double*)b;
+	return (x > y) - (x < y);
+}
+
+
+/**
+* @param double *sorted Sorted samples.
+* @param int count How many.
+* @param double pct Percentile, 0-100.
+* @return double The nearest-rank percentile.
+*/
+double percentile(double *sorted, int count, double pct) {
+	double exact = pct / 100.0 * count;
+	int rank = (int) exact;
+	
+	if (rank < exact) {
+		++rank;
+	}
+	return count ? sorted[MAX(1, MIN(count, rank)) - 1] : 0.0;
+}
+
+
+ //////////////////////////////////////////////////////////////////////////////
+//// SCRIPTS /////////////////////////////////////////////////////////////////
+
+/**
+* Parses a script in script-file format.
+*
+* @param const char *name The script's name.
+* @param const char *text The whole script.
+* @return struct lg_script* The parsed script.
+*/
+struct lg_script *parse_script(const char *name, const char *text) {
+	struct lg_script *scr;
+	char line[MAX_INPUT_LENGTH], *ptr;
+	const char *pos = text, *eol;
+	size_t len;
+
+	scr = lg_realloc(NULL, sizeof(struct lg_script));
+	memset(scr, 0, sizeof(struct lg_script));
+	scr->name = lg_strdup(name);
+
+	while (*pos) {
+		eol = strchr(pos, '\n');
+		len = eol ? (eol - pos) : strlen(pos);
+		len = MIN(len, sizeof(line) - 1);
+		memcpy(line, pos, len);
+		line[len] = '\0';
+		pos = eol ? eol + 1 : pos + strlen(pos);
+
+		// trim
+		for (ptr = line + strlen(line) - 1; ptr >= line && isspace(*ptr); --ptr) {
+			*ptr = '\0';
+		}
+		for (ptr = line; isspace(*ptr); ++ptr);
+
+		if (!*ptr || *ptr == '#') {
+			continue;
+		}
+		else if (!strncmp(ptr, "@setup ", 7)) {
+			scr->setup = lg_realloc(scr->setup, sizeof(char*) * (scr->num_setup + 1));
+			scr->setup[scr->num_setup++] = lg_strdup(ptr + 7);
+		}
+		else {
+			scr->steps = lg_realloc(scr->steps, sizeof(struct lg_step) * (scr->num_steps + 1));
+			if (!strncmp(ptr, "@wait ", 6)) {
+				scr->steps[scr->num_steps].cmd = NULL;
+				scr->steps[scr->num_steps].wait_ms = atoi(ptr + 6);
+			}
+			else {
+				scr->steps[scr->num_steps].cmd = lg_strdup(ptr);
+				scr->steps[scr->num_steps].wait_ms = 0;
+			}
+			++scr->num_steps;
+		}
+	}
+
+	if (scr->num_steps == 0) {
+		fprintf(stderr, "Script '%s' has no commands.\n", name);
+		exit(1);
+	}
+	return scr;
+}
+
+
+/**
+* Loads a built-in script by name, or else a script file.
+*
+* @param const char *name A built-in name or a filename.
+* @return struct lg_script* The script.
+*/
+struct lg_script *load_script(const char *name) {
+	char *text;
+	FILE *fl;
+	long size;
+	int iter;
+	struct lg_script *scr;
+
+	for (iter = 0; *builtin_scripts[iter][0] != '\n'; ++iter) {
+		if (!strcmp(name, builtin_scripts[iter][0])) {
+			return parse_script(name, builtin_scripts[iter][1]);
+		}
+	}
+
+	if (!(fl = fopen(name, "r"))) {
+		perror(name);
+		exit(1);
+	}
+	fseek(fl, 0, SEEK_END);
+	size = ftell(fl);
+	rewind(fl);
+	text = lg_realloc(NULL, size + 1);
+	size = fread(text, 1, size, fl);
+	text[size] = '\0';
+	fclose(fl);
+
+	scr = parse_script(name, text);
+	free(text);
+	return scr;
+}
+
+
+ //////////////////////////////////////////////////////////////////////////////
+//// CLIENTS /////////////////////////////////////////////////////////////////
+
+/**
+* Marks a client as failed and closes it.
+*
+* @param struct lg_client *cl The client.
+* @param char *reason Why (a string constant).
+*/
+void fail_client(struct lg_client *cl, char *reason) {
+	if (cl->fd != -1) {
+		close(cl->fd);
+		cl->fd = -1;
+	}
+	cl->state = LG_FAILED;
+	cl->fail_reason = reason;
+	if (cl->pending) {
+		++cl->pending->timeouts;
+		cl->pending = NULL;
+	}
+}
+
+
+/**
+* Sends one line to the server and clears the client's output buffer.
+*
+* @param struct lg_client *cl The client.
+* @param const char *line The line to send, without the newline.
+*/
+void send_line(struct lg_client *cl, const char *line) {
+	char buf[MAX_INPUT_LENGTH + 3];
+	size_t len;
+
+	len = snprintf(buf, sizeof(buf), "%s\r\n", line);
+	if (write(cl->fd, buf, len) != (ssize_t) len) {
+		fail_client(cl, "write failed");
+		return;
+	}
+	cl->len = 0;
+	*cl->text = '\0';
+}
+
+
+/**
+* Opens a client's connection.
+*
+* @param struct lg_client *cl The client.
+*/
+void connect_client(struct lg_client *cl) {
+	struct sockaddr_in local;
+	int flags;
+
+	if ((cl->fd = socket(PF_INET, SOCK_STREAM, 0)) < 0) {
+		perror("socket");
+		exit(1);
+	}
+
+	// one address per client so the mud's multiplaying check lets them all in
+	if (opt_bind && !cl->is_observer && (ntohl(server_addr.sin_addr.s_addr) >> 24) == 127) {
+		memset(&local, 0, sizeof(local));
+		local.sin_family = AF_INET;
+		local.sin_port = 0;
+		local.sin_addr.s_addr = htonl((127 << 24) | (1 << 16) | ((cl->id / 250) << 8) | (cl->id % 250 + 1));
+		if (bind(cl->fd, (struct sockaddr*) &local, sizeof(local)) < 0) {
+			perror("bind");
+			exit(1);
+		}
+	}
+
+	if (connect(cl->fd, (struct sockaddr*) &server_addr, sizeof(server_addr)) < 0) {
+		close(cl->fd);
+		cl->fd = -1;
+		fail_client(cl, "connect failed");
+		return;
+	}
+
+	flags = fcntl(cl->fd, F_GETFL, 0);
+	fcntl(cl->fd, F_SETFL, flags | O_NONBLOCK);
+
+	cl->state = LG_LOGIN;
+	cl->len = 0;
+	*cl->text = '\0';
+	cl->wake_at = now_ms() + LG_LOGIN_TIMEOUT * 1000.0;	// login deadline
+}
+
+
+/**
+* Appends server output to a client's buffer, dropping telnet negotiation
+* and ansi color codes so the prompts can be matched as plain text.
+*
+* @param struct lg_client *cl The client.
+* @param unsigned char *data Raw bytes from the socket.
+* @param int size How many.
+*/
+void filter_output(struct lg_client *cl, unsigned char *data, int size) {
+	int iter;
+	unsigned char ch;
+
+	for (iter = 0; iter < size; ++iter) {
+		ch = data[iter];
+
+		switch (cl->telnet_state) {
+			case TS_IAC: {
+				if (ch == SB_BYTE) {
+					cl->telnet_state = TS_SB;
+				}
+				else if (ch >= WILL_BYTE && ch <= DONT_BYTE) {
+					cl->telnet_state = TS_OPT;
+				}
+				else {
+					cl->telnet_state = TS_DATA;
+				}
+				continue;
+			}
+			case TS_OPT: {
+				cl->telnet_state = TS_DATA;
+				continue;
+			}
+			case TS_SB: {
+				if (ch == IAC_BYTE) {
+					cl->telnet_state = TS_SB_IAC;
+				}
+				continue;
+			}
+			case TS_SB_IAC: {
+				cl->telnet_state = (ch == SE_BYTE) ? TS_DATA : TS_SB;
+				continue;
+			}
+			default: {
+				if (ch == IAC_BYTE) {
+					cl->telnet_state = TS_IAC;
+					continue;
+				}
+				break;
+			}
+		}
+
+		switch (cl->ansi_state) {
+			case AS_ESC: {
+				cl->ansi_state = (ch == '[') ? AS_CSI : AS_DATA;
+				continue;
+			}
+			case AS_CSI: {
+				if (isalpha(ch)) {
+					cl->ansi_state = AS_DATA;
+				}
+				continue;
+			}
+			default: {
+				if (ch == '\033') {
+					cl->ansi_state = AS_ESC;
+					continue;
+				}
+				break;
+			}
+		}
+
+		if (ch == '\0') {
+			continue;
+		}
+
+		// keep the newest half if it fills up
+		if (cl->len >= sizeof(cl->text) - 1) {
+			memmove(cl->text, cl->text + sizeof(cl->text) / 2, cl->len - sizeof(cl->text) / 2);
+			cl->len -= sizeof(cl->text) / 2;
+		}
+		cl->text[cl->len++] = ch;
+	}
+	cl->text[cl->len] = '\0';
+}
+
+
+/**
+* The observer keeps its own prompt (it's a real account and the prompt would
+* be saved), so it's "at the prompt" once the 'uptime' output has arrived.
+*
+* @param struct lg_client *cl The client.
+* @return int TRUE if its output ends with the marked prompt.
+*/
+int at_prompt(struct lg_client *cl) {
+	size_t end = cl->len, mark = strlen(LG_PROMPT_MARK);
+	char *pos;
+
+	if (cl->is_observer) {
+		return ((pos = strstr(cl->text, "Pulse overruns:")) && strchr(pos, '\n'));
+	}
+
+	while (end > 0 && isspace(cl->text[end-1])) {
+		--end;
+	}
+	return (end >= mark && !strncmp(cl->text + end - mark, LG_PROMPT_MARK, mark));
+}
+
+
+/**
+* Picks an option from an archetype menu (lines like " Name - Description").
+*
+* @param struct lg_client *cl The client, with the menu in its buffer.
+* @param char *pick A buffer to save the name in.
+* @param size_t size The size of that buffer.
+* @return int TRUE if it found one.
+*/
+int pick_menu_option(struct lg_client *cl, char *pick, size_t size) {
+	char *line, *dash, *eol;
+	int count = 0, want;
+
+	// count them first, so each client picks a different one
+	for (line = cl->text; line && *line; line = (eol = strchr(line, '\n')) ? eol + 1 : NULL) {
+		if (*line == ' ' && (dash = strstr(line, " - ")) && (!(eol = strchr(line, '\n')) || dash < eol)) {
+			++count;
+		}
+	}
+	if (count == 0) {
+		return FALSE;
+	}
+
+	want = cl->id % count;
+	for (line = cl->text; line && *line; line = (eol = strchr(line, '\n')) ? eol + 1 : NULL) {
+		if (*line == ' ' && (dash = strstr(line, " - ")) && (!(eol = strchr(line, '\n')) || dash < eol)) {
+			if (want-- == 0) {
+				snprintf(pick, size, "%.*s", (int)(dash - line - 1), line + 1);
+				return TRUE;
+			}
+		}
+	}
+	return FALSE;
+}
+
+
+/**
+* Answers the login and character creation prompts.
+*
+* @param struct lg_client *cl The client.
+*/
+void handle_login(struct lg_client *cl) {
+	char pick[MAX_INPUT_LENGTH];
+	char *text = cl->text;
+	int paged = strstr(text, "[ Return to continue") ? TRUE : FALSE;
+
+	if (strstr(text, "Multiplaying detected")) {
+		fail_client(cl, "multiplaying check (try without -b)");
+	}
+	else if (strstr(text, "Wrong password")) {
+		fail_client(cl, "wrong password for existing character");
+	}
+	else if (strstr(text, "Invalid name") || strstr(text, "not allowed from your site") || strstr(text, "can't be created")) {
+		fail_client(cl, "name or site refused");
+	}
+	else if (strstr(text, "Enter your character name")) {
+		send_line(cl, cl->name);
+	}
+	else if (strstr(text, "Did I get that right")) {
+		send_line(cl, "y");
+	}
+	else if (strstr(text, "Give me a password") || strstr(text, "retype password") || strstr(text, "Password:") || strstr(text, "password for that character")) {
+		send_line(cl, cl->password);
+	}
+	else if (strstr(text, "last name (y/n)")) {
+		send_line(cl, "n");
+	}
+	else if (strstr(text, "your sex")) {
+		send_line(cl, (cl->id % 2) ? "f" : "m");
+	}
+	else if (strstr(text, "screen reader (y/n)") || strstr(text, "existing character (y/n)")) {
+		send_line(cl, "n");
+	}
+	else if (strstr(text, "Choose your") || strstr(text, "Type info, list, or")) {
+		// archetype menu: wait for its prompt, or for the pager if the list is long
+		if (!paged && !strstr(text, "Type info, list, or")) {
+			return;
+		}
+		if (paged) {
+			send_line(cl, "q");	// the first page is enough to pick from
+		}
+		send_line(cl, pick_menu_option(cl, pick, sizeof(pick)) ? pick : "list all");
+	}
+	else if (strstr(text, "Is this correct (y/n)") || strstr(text, "Proceed without one")) {
+		send_line(cl, "y");
+	}
+	else if (strstr(text, "to choose later")) {
+		send_line(cl, "skip");
+	}
+	else if (strstr(text, "promo code") || strstr(text, "hear about us")) {
+		send_line(cl, "");
+	}
+	else if (strstr(text, "Press ENTER") && strstr(text, "=====")) {
+		// the motd: this enters the game; players set the prompt, the observer checks uptime
+		send_line(cl, "");
+		send_line(cl, cl->is_observer ? "uptime" : "prompt " LG_PROMPT_MARK);
+		cl->state = LG_ENTERING;
+	}
+	else if (strstr(text, "Press ENTER")) {
+		send_line(cl, "");
+	}
+	else if (strstr(text, "Reconnecting")) {
+		send_line(cl, cl->is_observer ? "uptime" : "prompt " LG_PROMPT_MARK);
+		cl->state = LG_ENTERING;
+	}
+	else if (paged) {
+		send_line(cl, "q");
+	}
+}
+
+
+/**
+* Sends the client's next setup or script command.
+*
+* @param struct lg_client *cl The client.
+* @param double now The current time in ms.
+*/
+void next_command(struct lg_client *cl, double now) {
+	struct lg_step *step;
+
+	if (cl->setup_pos < cl->script->num_setup) {
+		send_line(cl, cl->script->setup[cl->setup_pos++]);
+		cl->pending = NULL;	// not timed
+		cl->sent_at = now;
+		cl->state = LG_BUSY;
+		return;
+	}
+
+	step = &cl->script->steps[cl->step_pos];
+	cl->step_pos = (cl->step_pos + 1) % cl->script->num_steps;
+
+	if (!step->cmd) {
+		cl->wake_at = now + step->wait_ms;
+		cl->state = LG_IDLE;
+	}
+	else {
+		send_line(cl, step->cmd);
+		cl->pending = find_stat(step->cmd);
+		cl->sent_at = now;
+		cl->state = LG_BUSY;
+	}
+}
+
+
+/**
+* Reads 'Pulse overruns: X (Y pulses behind)' out of the observer's buffer.
+*
+* @param struct lg_client *cl The observer.
+* @param unsigned long *overruns Saves the overrun count here.
+* @param unsigned long *behind Saves the pulses-behind count here.
+* @return int TRUE if it found it.
+*/
+int read_overruns(struct lg_client *cl, unsigned long *overruns, unsigned long *behind) {
+	char *pos = strstr(cl->text, "Pulse overruns:");
+	return (pos && sscanf(pos, "Pulse overruns: %lu (%lu", overruns, behind) == 2);
+}
+
+
+/**
+* Has the observer check 'uptime' for the server's pulse overruns.
+*
+* @param struct lg_client *cl The observer.
+* @param double now The current time in ms.
+*/
+void send_uptime(struct lg_client *cl, double now) {
+	send_line(cl, "uptime");
+	cl->pending = NULL;	// not timed
+	cl->sent_at = now;
+	cl->state = LG_BUSY;
+}
+
+
+/**
+* Processes whatever a client has received.
+*
+* @param struct lg_client *cl The client.
+* @param double now The current time in ms.
+*/
+void handle_output(struct lg_client *cl, double now) {
+	// pager: just quit out of it (the command isn't finished until the prompt);
+	// during login, handle_login() does this itself because menus can be paged
+	if (cl->state != LG_LOGIN && strstr(cl->text, "[ Return to continue")) {
+		send_line(cl, "q");
+		return;
+	}
+
+	switch (cl->state) {
+		case LG_LOGIN: {
+			handle_login(cl);
+			break;
+		}
+		case LG_ENTERING: {
+			if (strstr(cl->text, "Multiplaying detected")) {
+				fail_client(cl, "multiplaying check (try without -b)");
+			}
+			else if (at_prompt(cl)) {
+				cl->len = 0;
+				*cl->text = '\0';
+				cl->wake_at = now;
+				cl->state = LG_IDLE;
+			}
+			break;
+		}
+		case LG_BUSY: {
+			if (at_prompt(cl)) {
+				if (cl->pending) {
+					add_sample(cl->pending, now - cl->sent_at);
+					cl->pending = NULL;
+				}
+				cl->wake_at = now + opt_think_ms;
+				cl->state = LG_IDLE;
+			}
+			break;
+		}
+	}
+}
+
+
+/**
+* Reads from a client's socket.
+*
+* @param struct lg_client *cl The client.
+* @param double now The current time in ms.
+*/
+void read_client(struct lg_client *cl, double now) {
+	unsigned char buf[4096];
+	ssize_t bytes;
+
+	for (;;) {
+		bytes = read(cl->fd, buf, sizeof(buf));
+		if (bytes > 0) {
+			filter_output(cl, buf, bytes);
+		}
+		else if (bytes == 0) {
+			fail_client(cl, "disconnected by server");
+			return;
+		}
+		else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+			break;
+		}
+		else if (errno != EINTR) {
+			fail_client(cl, "read failed");
+			return;
+		}
+	}
+
+	handle_output(cl, now);
+}
+
+
+ //////////////////////////////////////////////////////////////////////////////
+//// MAIN LOOP ///////////////////////////////////////////////////////////////
+
+/**
+* Runs the clients until the duration is up.
+*
+* @param struct lg_client *observer The immortal client, or NULL.
+*/
+void run_clients(struct lg_client *observer) {
+	double now, start, next_connect, end_at = 0;
+	int iter, maxfd, connected = 0, running, phase = 0;
+	struct lg_client *cl;
+	struct timeval timeout;
+	fd_set input_set;
+
+	start = next_connect = now_ms();
+
+	for (;;) {
+		now = now_ms();
+
+		// ramp up
+		while (connected < num_clients && now >= next_connect) {
+			connect_client(&clients[connected++]);
+			next_connect += opt_ramp_ms;
+		}
+
+		// start the clock once everyone is in (or has failed)
+		if (!end_at && connected == num_clients) {
+			for (iter = 0, running = TRUE; iter < num_clients && running; ++iter) {
+				if (clients[iter].state == LG_LOGIN || clients[iter].state == LG_ENTERING) {
+					running = FALSE;
+				}
+			}
+			if (running) {
+				end_at = now + opt_duration * 1000.0;
+				printf("All clients logged in after %.1f seconds; running for %d seconds.\n", (now - start) / 1000.0, opt_duration);
+				fflush(stdout);
+				if (observer && observer->state == LG_IDLE) {
+					send_uptime(observer, now);
+					phase = 1;
+				}
+			}
+		}
+
+		// observer: read overruns at the start and end
+		if (observer && observer->state == LG_IDLE && phase == 1) {
+			have_overruns = read_overruns(observer, &overruns_at_start, &behind_at_start);
+			phase = 2;
+		}
+		else if (observer && observer->state == LG_IDLE && phase == 3) {
+			have_overruns = have_overruns && read_overruns(observer, &overruns_at_end, &behind_at_end);
+			phase = 4;
+		}
+
+		// time's up?
+		if (end_at && now >= end_at) {
+			if (observer && phase == 2 && observer->state == LG_IDLE) {
+				send_uptime(observer, now);
+				phase = 3;
+			}
+			for (iter = 0, running = 0; iter < num_clients; ++iter) {
+				cl = &clients[iter];
+				if (cl == observer && (phase == 2 || phase == 3)) {
+					++running;	// still reading the final 'uptime'
+				}
+				else if (cl->state == LG_IDLE || (cl->state == LG_BUSY && cl != observer && now - cl->sent_at > opt_timeout * 1000.0)) {
+					if (cl->state == LG_BUSY && cl->pending) {
+						++cl->pending->timeouts;
+					}
+					send_line(cl, "quit");
+					close(cl->fd);
+					cl->fd = -1;
+					cl->state = LG_DONE;
+				}
+				else if (cl->state == LG_BUSY || cl->state == LG_LOGIN || cl->state == LG_ENTERING) {
+					++running;	// finish the command in flight
+				}
+			}
+			if (!running) {
+				break;
+			}
+		}
+
+		// timers
+		for (iter = 0; iter < connected; ++iter) {
+			cl = &clients[iter];
+
+			if ((cl->state == LG_LOGIN || cl->state == LG_ENTERING) && now >= cl->wake_at) {
+				fail_client(cl, "timed out logging in");
+			}
+			else if (cl->state == LG_BUSY && now - cl->sent_at > opt_timeout * 1000.0) {
+				// no prompt: count it and move on
+				if (cl->pending) {
+					++cl->pending->timeouts;
+					cl->pending = NULL;
+				}
+				cl->wake_at = now;
+				cl->state = LG_IDLE;
+			}
+			else if (cl->state == LG_IDLE && now >= cl->wake_at && !cl->is_observer && !(end_at && now >= end_at)) {
+				next_command(cl, now);
+			}
+		}
+
+		// wait for output
+		FD_ZERO(&input_set);
+		maxfd = -1;
+		for (iter = 0; iter < connected; ++iter) {
+			if (clients[iter].fd != -1) {
+				FD_SET(clients[iter].fd, &input_set);
+				maxfd = MAX(maxfd, clients[iter].fd);
+			}
+		}
+
+		timeout.tv_sec = 0;
+		timeout.tv_usec = 10000;
+		if (select(maxfd + 1, &input_set, NULL, NULL, &timeout) < 0 && errno != EINTR) {
+			perror("select");
+			exit(1);
+		}
+
+		now = now_ms();
+		for (iter = 0; iter < connected; ++iter) {
+			if (clients[iter].fd != -1 && FD_ISSET(clients[iter].fd, &input_set)) {
+				read_client(&clients[iter], now);
+			}
+		}
+	}
+}
+
+
+/**
+* Prints the latency report.
+*/
+void print_report(void) {
+	struct lg_stat *st, all;
+	int iter, pos, failed = 0, total_timeouts = 0;
+	double sum;
+
+	memset(&all, 0, sizeof(all));
+	strcpy(all.label, "(all)");
+
+	printf("\n%-12s %7s %5s %8s %8s %8s %8s %8s\n", "Command", "Count", "T/O", "Mean", "p50", "p90", "p99", "Max");
+	for (iter = 0; iter <= num_stats; ++iter) {
+		st = (iter < num_stats) ? &stats[iter] : &all;
+
+		if (iter < num_stats) {
+			all.samples = lg_realloc(all.samples, sizeof(double) * (all.count + st->count + 1));
+			memcpy(all.samples + all.count, st->samples, sizeof(double) * st->count);
+			all.count += st->count;
+			all.timeouts += st->timeouts;
+		}
+
+		qsort(st->samples, st->count, sizeof(double), compare_doubles);
+		for (sum = 0.0, pos = 0; pos < st->count; ++pos) {
+			sum += st->samples[pos];
+		}
+		printf("%-12s %7d %5d %8.1f %8.1f %8.1f %8.1f %8.1f\n", st->label, st->count, st->timeouts, st->count ? sum / st->count : 0.0, percentile(st->samples, st->count, 50), percentile(st->samples, st->count, 90), percentile(st->samples, st->count, 99), st->count ? st->samples[st->count - 1] : 0.0);
+	}
+	total_timeouts = all.timeouts;
+	printf("(latencies in ms from sending a command until its prompt arrives)\n");
+
+	for (iter = 0, failed = 0; iter < num_clients; ++iter) {
+		if (clients[iter].state == LG_FAILED) {
+			if (!failed++) {
+				printf("\nFailed clients:\n");
+			}
+			printf(" %s: %s\n", clients[iter].name, clients[iter].fail_reason ? clients[iter].fail_reason : "unknown");
+		}
+	}
+
+	printf("\nClients: %d, failed: %d, commands: %d, timeouts: %d, throughput: %.1f commands/sec\n", num_clients - (opt_observer ? 1 : 0), failed, all.count, total_timeouts, opt_duration > 0 ? (double) all.count / opt_duration : 0.0);
+	if (have_overruns) {
+		printf("Server pulse overruns during the run: %lu (%lu pulse%s behind)\n", overruns_at_end - overruns_at_start, behind_at_end - behind_at_start, (behind_at_end - behind_at_start != 1) ? "s" : "");
+	}
+	else if (opt_observer) {
+		printf("Server pulse overruns: unavailable (the immortal could not read 'uptime')\n");
+	}
+}
+
+
+/**
+* Prints usage and exits.
+*
+* @param char *prog The program name.
+*/
+void usage(char *prog) {
+	fprintf(stderr, "Usage: %s [-h host] [-p port] [-c clients] [-d seconds] [-r ramp ms] [-t think ms]\n", prog);
+	fprintf(stderr, "       [-T timeout seconds] [-s script,script,...] [-n name prefix] [-w password]\n");
+	fprintf(stderr, "       [-i immortal:password] [-b]\n");
+	fprintf(stderr, "Scripts: walk, look, combat, craft, chat, workforce, or a script file\n");
+	exit(1);
+}
+
+
+int main(int argc, char **argv) {
+	struct hostent *host;
+	struct lg_client *observer = NULL;
+	char *list, *name, *pass;
+	int opt, iter, pos;
+
+	while ((opt = getopt(argc, argv, "h:p:c:d:r:t:T:s:n:w:i:b")) != -1) {
+		switch (opt) {
+			case 'h':	opt_host = optarg;	break;
+			case 'p':	opt_port = atoi(optarg);	break;
+			case 'c':	opt_clients = atoi(optarg);	break;
+			case 'd':	opt_duration = atoi(optarg);	break;
+			case 'r':	opt_ramp_ms = atoi(optarg);	break;
+			case 't':	opt_think_ms = atoi(optarg);	break;
+			case 'T':	opt_timeout = atoi(optarg);	break;
+			case 's':	opt_scripts = optarg;	break;
+			case 'n':	opt_prefix = optarg;	break;
+			case 'w':	opt_password = optarg;	break;
+			case 'i':	opt_observer = optarg;	break;
+			case 'b':	opt_bind = FALSE;	break;
+			default:	usage(argv[0]);
+		}
+	}
+
+	if (opt_clients < 1 || opt_clients > LG_MAX_CLIENTS - 1 || opt_port < 1 || opt_duration < 1 || opt_timeout < 1) {
+		fprintf(stderr, "Clients must be 1-%d; port, duration, and timeout must be positive.\n", LG_MAX_CLIENTS - 1);
+		exit(1);
+	}
+	if (strlen(opt_prefix) + 3 > MAX_NAME_LENGTH) {
+		fprintf(stderr, "Name prefix is too long.\n");
+		exit(1);
+	}
+	if (opt_observer && !strchr(opt_observer, ':')) {
+		fprintf(stderr, "Immortal must be given as name:password.\n");
+		exit(1);
+	}
+
+	// server
+	memset(&server_addr, 0, sizeof(server_addr));
+	server_addr.sin_family = AF_INET;
+	server_addr.sin_port = htons(opt_port);
+	if (!(host = gethostbyname(opt_host))) {
+		fprintf(stderr, "Unknown host: %s\n", opt_host);
+		exit(1);
+	}
+	memcpy(&server_addr.sin_addr, host->h_addr, sizeof(server_addr.sin_addr));
+
+	// scripts
+	list = lg_strdup(opt_scripts);
+	for (name = strtok(list, ","); name; name = strtok(NULL, ",")) {
+		scripts = lg_realloc(scripts, sizeof(struct lg_script*) * (num_scripts + 1));
+		scripts[num_scripts++] = load_script(name);
+	}
+	if (!num_scripts) {
+		usage(argv[0]);
+	}
+
+	// clients (the observer goes last)
+	num_clients = opt_clients + (opt_observer ? 1 : 0);
+	clients = lg_realloc(NULL, sizeof(struct lg_client) * num_clients);
+	memset(clients, 0, sizeof(struct lg_client) * num_clients);
+	for (iter = 0; iter < opt_clients; ++iter) {
+		clients[iter].id = iter;
+		clients[iter].fd = -1;
+		clients[iter].script = scripts[iter % num_scripts];
+		clients[iter].password = opt_password;
+		pos = snprintf(clients[iter].name, sizeof(clients[iter].name), "%s", opt_prefix);
+		snprintf(clients[iter].name + pos, sizeof(clients[iter].name) - pos, "%c%c%c", 'a' + (iter / 676) % 26, 'a' + (iter / 26) % 26, 'a' + iter % 26);
+	}
+	if (opt_observer) {
+		observer = &clients[opt_clients];
+		observer->id = opt_clients;
+		observer->fd = -1;
+		observer->is_observer = TRUE;
+		observer->script = scripts[0];
+		name = lg_strdup(opt_observer);
+		pass = strchr(name, ':');
+		*pass++ = '\0';
+		snprintf(observer->name, sizeof(observer->name), "%s", name);
+		observer->password = pass;
+	}
+
+	signal(SIGPIPE, SIG_IGN);
+
+	printf("Connecting %d client%s to %s:%d...\n", opt_clients, (opt_clients != 1 ? "s" : ""), opt_host, opt_port);
+	fflush(stdout);
+	run_clients(observer);
+	print_report();
+
+	return 0;
+}
@@ -19,26 +19,26 @@
 *  1. go to lib/world/wld
 *  2. run ./map
 *  2a. you may have to "chmod u+x map" to run it
-*  2b. you may need to raise the stack size limit: ulimit -s <limit>
-*  2c. this will generate new .wld files and a new index -- you must to delete
-*      your lib/world/base_map file or it will combine with your new .wld files
+*  2b. to rebuild an earlier map exactly, run ./map seed <number> using the
+*      seed it printed the first time
+*  2c. this writes lib/world/base_map directly, which is the file the mud
+*      boots its map from -- any old map rooms (vnums below the map size) left
+*      in your .wld files will still override it, so remove those first
 *  3. make sure the stats output looks good
 *  4. you can use the map.txt data file with your map.php image generator to
 *     see if the world looks good to you
 *  5. when you're happy with it, start up the mud
 *
-*  NOTE: A new version of the map generator which creates the base_map file
-*  itself is planned for EmpireMUD 2.0b5.
-*
 * Bonus feature: shift an existing map east/west
 *  1. generate a new map (do NOT use this on a live game map)
 *  2. run ./map shift <distance>
 *  3. distance is number of map tiles to shift east (negative for west)
-*  3. it will load the map, shift it, and then save it again
+*  3. it will load the base_map, shift it, and then save it again
 */
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <time.h>
 #include <math.h>
 
@@ -53,7 +53,6 @@
 *  Macros
 *  Main Generator
 *  Random Generator
-*  Island Numbering
 *  Helper Functions
 *  Map Generator Functions
 *  Bonus Features
@@ -71,10 +70,8 @@ double get_percent_type(int type);
 void init_grid(void);
 int number(int from, int to);
 void output_stats(void);
+void print_base_map(void);
 void print_map_graphic(void);
-void print_map_to_files(void);
-struct num_data_t *pop_ndt(void);
-void push_ndt(int loc);
 int sect_to_terrain(int sect_vnum);
 inline int shift(int origin, int x_shift, int y_shift);
 void shift_map_x(int amt);
@@ -109,6 +106,10 @@ void load_and_shift_map(int dist);
 #define USE_WRAP_Y  WRAP_Y	// from structs.h
 
 
+// output: the generator is run from lib/world/wld
+#define BASE_MAP_FILE  "../base_map"	// same file as WORLD_MAP_FILE in db.h
+#define BASE_MAP_TEMP  BASE_MAP_FILE ".temp"	// for safe filewrites
+
 // master controls
 #define TARGET_LAND_SIZE  333000	// how much ocean to convert to land -- THIS WILL DETERMINE HOW MUCH RAM YOUR MUD USES (333k = about 130 MB RAM)
 #define NUM_START_POINTS  1
@@ -243,10 +244,10 @@ const int shift_dir[][2] = {
 #define IS_IN_Y_PRC_RANGE(ycoord, startprc, endprc)  (ycoord >= round(startprc / 100.0 * USE_HEIGHT) && ycoord <= round(endprc / 100.0 * USE_HEIGHT))
 
 
-/* The master grid (USE_WIDTH, USE_HEIGHT) */
+/* The master grid (USE_WIDTH, USE_HEIGHT), stored row-major: see MAP() */
 struct grid_type {
 	int type;
-	int pass;	// used to control fresh paint and prevent hideous conglomermountains
+	int pass;	// matches current_pass for fresh paint; prevents hideous conglomermountains
 	int island_id;	// island data
 };
 
@@ -268,7 +269,8 @@ struct island_data {
 
 
 // locals
-struct grid_type grid[USE_SIZE];	// main working grid
+struct grid_type *grid = NULL;	// main working grid: allocated by init_grid()
+int current_pass = 0;	// see clear_pass()
 int total_ocean = 0;	// keep track of ocean to speed up counts
 struct island_data *island_list = NULL;	// Master list
 
@@ -357,9 +359,15 @@ void create_map(void) {
 
 // main game execution
 int main(int argc, char **argv) {
-	empire_srandom(time(0));
+	unsigned long use_seed = time(0);
 	
-	if (argc > 1 && !strcmp(argv[1], "shift")) {
+	if (argc > 1 && !strcmp(argv[1], "seed")) {
+		if (argc <= 2 || (use_seed = strtoul(argv[2], NULL, 10)) == 0) {
+			printf("Usage: %s seed <number>\n", argv[0]);
+			exit(1);
+		}
+	}
+	else if (argc > 1 && !strcmp(argv[1], "shift")) {
 		if (argc <= 2) {
 			printf("Usage: %s shift <distance>\n", argv[0]);
 			exit(1);
@@ -371,11 +379,15 @@ int main(int argc, char **argv) {
 	else if (argc > 1) {
 		printf("Unknown mode: %s\n", argv[1]);
 	}
+	
+	// the whole map is determined by this seed
+	printf("Using seed %lu (./map seed %lu will rebuild this map)\n", use_seed, use_seed);
+	empire_srandom(use_seed);
 
 	create_map();
 
 	print_map_graphic();
-	print_map_to_files();
+	print_base_map();
 
 	printf("Done.\n");
 	output_stats();
@@ -433,40 +445,6 @@ int number(int from, int to) {
 }
 
 
- //////////////////////////////////////////////////////////////////////////////
-//// ISLAND NUMBERING ////////////////////////////////////////////////////////
-
-struct num_data_t {
-	int loc;
-	struct num_data_t *next;	// LL
-};
-
-struct num_data_t *ndt_stack = NULL;	// global list
-
-
-// pops an item from the stack and returns it, or NULL if empty
-struct num_data_t *pop_ndt(void) {
-	struct num_data_t *temp = NULL;
-	
-	if (ndt_stack) {
-		temp = ndt_stack;
-		ndt_stack = temp->next;
-	}
-	
-	return temp;
-}
-
-
-// push a location onto the stack
-void push_ndt(int loc) {
-	struct num_data_t *ndt;
-	CREATE(ndt, struct num_data_t, 1);
-	ndt->loc = loc;
-	ndt->next = ndt_stack;
-	ndt_stack = ndt;
-}
-
-
  //////////////////////////////////////////////////////////////////////////////
 //// HELPER FUNCTIONS ////////////////////////////////////////////////////////
 
@@ -494,13 +472,13 @@ inline void change_grid(int loc, int type) {
 }
 
 
-// clears all pass data
+/**
+* Starts a fresh paint pass. Rather than wiping every tile (a full-map sweep
+* for each mountain and river), this just advances the pass counter: a tile
+* was painted this pass only if its pass matches current_pass.
+*/
 void clear_pass(void) {
-	int iter;
-	
-	for (iter = 0; iter < USE_SIZE; ++iter) {
-		grid[iter].pass = 0;
-	}
+	++current_pass;
 }
 
 
@@ -580,6 +558,12 @@ double get_percent_type(int type) {
 // Set the whole world to one GIANT ocean
 void init_grid(void) {
 	int i;
+	
+	// the grid lives on the heap so large maps don't depend on stack/static limits
+	if (!grid) {
+		CREATE(grid, struct grid_type, USE_SIZE);
+	}
+	current_pass = 0;
 
 	for (i = 0; i < USE_SIZE; i++) {
 		grid[i].type = OCEAN;
@@ -611,65 +595,58 @@ void output_stats(void) {
 }
 
 
-// creates the data file for the graphic map
-void print_map_graphic(void) {
+/**
+* Writes the land portion of the map as the base_map file the mud boots from,
+* in the same format as save_world_map_to_file(). Ocean is omitted. Crops are
+* left unset (-1); verify_sectors() picks them when the mud boots.
+*/
+void print_base_map(void) {
+	static char buf[1024 * 1024];
+	int i, vnum;
 	FILE *out;
-	int i;
-
-	out = fopen("map.txt", "w");
-
-	fprintf(out, "%dx%d\n", USE_WIDTH, USE_HEIGHT);
+	
+	if (!(out = fopen(BASE_MAP_TEMP, "w"))) {
+		printf("Unable to write %s!\n", BASE_MAP_TEMP);
+		exit(1);
+	}
+	setvbuf(out, buf, _IOFBF, sizeof(buf));
+	
 	for (i = 0; i < USE_SIZE; i++) {
-		fprintf(out, "%s", terrains[grid[i].type].mapout_icon);
-		if (!((i+1) % USE_WIDTH))
-			fprintf(out, "\n");
+		if (grid[i].type != OCEAN) {
+			vnum = terrains[grid[i].type].sector_vnum;
+			// x y island sect base natural crop
+			fprintf(out, "%d %d %d %d %d %d -1\n", X_COORD(i), Y_COORD(i), grid[i].island_id, vnum, vnum, vnum);
 		}
-
+	}
+	
 	fclose(out);
-
-	return;
+	rename(BASE_MAP_TEMP, BASE_MAP_FILE);
 }
 
 
-// outputs the .wld data files
-void print_map_to_files(void) {
-	FILE *out, *index_fl;
-	int i, j, pos;
-	char fname[256];
-	
-	if (!(index_fl = fopen("index", "w"))) {
-		printf("Unable to write index file!\n");
-		exit(0);
-	}
+// creates the data file for the graphic map
+void print_map_graphic(void) {
+	char row[USE_WIDTH + 1];
+	FILE *out;
+	int x, y;
 
-	for (i = 0; i < NUM_BLOCKS; i++) {
-		sprintf(fname, "%d.wld", i);
-		if (!(out = fopen(fname, "w"))) {
-			printf("Unable to write file %s!\n", fname);
-			exit(0);
-		}
-		
-		// add to index
-		fprintf(index_fl, "%s\n", fname);
+	if (!(out = fopen("map.txt", "w"))) {
+		printf("Unable to write map.txt!\n");
+		return;
+	}
 
-		for (j = 0; j < USE_BLOCK_SIZE; j++) {
-			pos = i * USE_BLOCK_SIZE + j;
-			
-			if (grid[pos].type != OCEAN) {
-				fprintf(out, "#%d\n", pos);
-				fprintf(out, "%d %d %d\n", grid[pos].island_id, terrains[grid[pos].type].sector_vnum, terrains[grid[pos].type].sector_vnum);
-				fprintf(out, "S\n");
-			}
+	fprintf(out, "%dx%d\n", USE_WIDTH, USE_HEIGHT);
+	row[USE_WIDTH] = '\n';
+	
+	// one write per row
+	for (y = 0; y < USE_HEIGHT; ++y) {
+		for (x = 0; x < USE_WIDTH; ++x) {
+			row[x] = *terrains[grid[MAP(x, y)].type].mapout_icon;
 		}
-		fprintf(out, "$~\n");
-		fclose(out);
+		fwrite(row, sizeof(char), USE_WIDTH + 1, out);
 	}
-	
-	// end index file
-	fprintf(index_fl, "$\n");
-	fclose(index_fl);
 
-	return;
+	fclose(out);
 }
 
 
@@ -829,14 +806,14 @@ void add_mountains(struct island_data *isle) {
 	while (room != -1) {
 		if (!terrains[grid[room].type].is_land)
 			return;
-		if (grid[room].type == MOUNTAIN && grid[room].pass == 0) {
+		if (grid[room].type == MOUNTAIN && grid[room].pass != current_pass) {
 			return;
 		}
 		
 		if (grid[room].type == PLAINS) {
 			change_grid(room, MOUNTAIN);
 		}
-		grid[room].pass = 1;
+		grid[room].pass = current_pass;
 
 		for (hor = -2; hor <= 2; ++hor) {
 			for (ver = -2; ver  <= 2; ++ver) {
@@ -848,11 +825,11 @@ void add_mountains(struct island_data *isle) {
 				to = shift(room, hor, ver);
 				if (to != -1 && number(0, 10) && grid[to].type == PLAINS) {
 					// if we find a mountain that already exists, we stop AFTER this round
-					if (grid[to].type == MOUNTAIN && grid[to].pass == 0) {
+					if (grid[to].type == MOUNTAIN && grid[to].pass != current_pass) {
 						found = 1;
 					}
 					change_grid(to, MOUNTAIN);
-					grid[to].pass = 1;
+					grid[to].pass = current_pass;
 				}
 			}
 		}
@@ -957,7 +934,7 @@ void add_river(struct island_data *isle) {
 			return;
 		
 		change_grid(room, RIVER);
-		grid[room].pass = 1;
+		grid[room].pass = current_pass;
 		
 		for (hor = number(-1, 0); hor <= 1; ++hor) {
 			for (ver = number(-1, 0); ver <= 1; ++ver) {
@@ -969,13 +946,13 @@ void add_river(struct island_data *isle) {
 				to = shift(room, hor, ver);
 				if (to != -1) {
 					// if we hit another river, stop AFTER this sect
-					if (grid[to].type == RIVER && grid[to].pass == 0) {
+					if (grid[to].type == RIVER && grid[to].pass != current_pass) {
 						found = 1;
 					}
 				
 					if (terrains[grid[to].type].is_land) {
 						change_grid(to, RIVER);
-						grid[to].pass = 1;
+						grid[to].pass = current_pass;
 					}
 				}
 			}
@@ -1295,71 +1272,86 @@ void land_mass(struct island_data *isle, int min_radius, int max_radius) {
 
 // sets up island numbers and converts trapped ocean to lake
 void number_islands_and_fix_lakes(void) {
-	int first_ocean_done = FALSE, changed = FALSE;
-	struct num_data_t *ndt;
-	int old, x, y, pos;
+	int first_ocean_done, changed;
+	int *stack, top, x, y, pos, loc;
 	int iter, use_id, use_land;
-	int top_id = 0;
-	
-	// initialize
-	for (iter = 0; iter < USE_SIZE; ++iter) {
-		grid[iter].island_id = 0;	// anything that stays zero will be made a lake
-	}
+	int top_id;
 	
-	// find and create basic stack
-	for (iter = 0; iter < USE_SIZE; ++iter) {
-		if (grid[iter].island_id == 0) {
-			if (terrains[grid[iter].type].is_land) {
-				use_id = ++top_id;
-				use_land = TRUE;
-			}
-			else if (!first_ocean_done) {	// non-land
-				use_id = -1;
-				use_land = FALSE;
-				first_ocean_done = TRUE;
-			}
-			else {
-				continue;	// skip
-			}
-			
-			old = grid[iter].island_id;
-			
-			push_ndt(iter);
-			while ((ndt = pop_ndt())) {
-				grid[ndt->loc].island_id = use_id;
+	// each tile is pushed at most once per round, so this never overflows
+	CREATE(stack, int, USE_SIZE);
 	
-				for (x = -1; x <= 1; ++x) {
-					for (y = -1; y <= 1; ++y) {
-						if (x != 0 || y != 0) {
-							pos = shift(ndt->loc, x, y);
-							if (pos != -1 && grid[pos].island_id == old && terrains[grid[pos].type].is_land == use_land) {
-								push_ndt(pos);
+	do {
+		first_ocean_done = changed = FALSE;
+		top_id = 0;
+		
+		// initialize
+		for (iter = 0; iter < USE_SIZE; ++iter) {
+			grid[iter].island_id = 0;	// anything that stays zero will be made a lake
+		}
+		
+		// flood each unnumbered island (and the first ocean)
+		for (iter = 0; iter < USE_SIZE; ++iter) {
+			if (grid[iter].island_id == 0) {
+				if (terrains[grid[iter].type].is_land) {
+					use_id = ++top_id;
+					use_land = TRUE;
+				}
+				else if (!first_ocean_done) {	// non-land
+					use_id = -1;
+					use_land = FALSE;
+					first_ocean_done = TRUE;
+				}
+				else {
+					continue;	// skip
+				}
+				
+				// tiles are numbered as they're pushed so none is pushed twice
+				grid[iter].island_id = use_id;
+				stack[0] = iter;
+				top = 1;
+				
+				while (top > 0) {
+					loc = stack[--top];
+					
+					for (x = -1; x <= 1; ++x) {
+						for (y = -1; y <= 1; ++y) {
+							if (x != 0 || y != 0) {
+								pos = shift(loc, x, y);
+								if (pos != -1 && grid[pos].island_id == 0 && terrains[grid[pos].type].is_land == use_land) {
+									grid[pos].island_id = use_id;
+									stack[top++] = pos;
+								}
 							}
 						}
 					}
 				}
-				free(ndt);
 			}
 		}
-	}
-	
-	// now find unreachable land and turn to lake
-	for (iter = 0; iter < USE_SIZE; ++iter) {
-		if (grid[iter].island_id == 0) {
-			change_grid(iter, LAKE);
-			changed = TRUE;
+		
+		// now find unreachable land and turn to lake
+		for (iter = 0; iter < USE_SIZE; ++iter) {
+			if (grid[iter].island_id == 0) {
+				change_grid(iter, LAKE);
+				changed = TRUE;
+			}
 		}
-	}
+		
+		// new lakes join their islands: renumber (should only take 1 more round)
+	} while (changed);
 	
-	// should only take 1 second time
-	if (changed) {
-		number_islands_and_fix_lakes();
-	}
+	free(stack);
 }
 
 
 /**
 * Convert terrain from one thing to another near other terrain.
+*
+* This is a distance transform rather than a neighborhood scan: one sweep each
+* way along every row finds the horizontal distance to the nearest 'near' tile,
+* then each 'from' tile only checks that distance on the rows within range,
+* using the same test as compute_distance(): floor(sqrt(dx^2 + dy^2)) <= dist.
+* Unlike the old scan, this also sees across a wrapped map edge. The 'near'
+* terrain must differ from 'from' and 'to', so the distances never go stale.
 * 
 * @param int from Terrain to convert from.
 * @param int to Terrain to convert to.
@@ -1367,28 +1359,60 @@ void number_islands_and_fix_lakes(void) {
 * @param int dist Distance it must be within.
 */
 void replace_near(int from, int to, int near, int dist) {
-	int x, y, hor, ver, at, loc;
-	int found;
+	int *row_dist, *out;
+	int x, y, iter, ver, row, cap, cur;
 	
-	for (x = 0; x < USE_WIDTH; ++x) {
-		for (y = 0; y < USE_HEIGHT; ++y) {
-			at = MAP(x, y);
+	cap = dist + 1;	// anything farther than dist is just "too far"
+	CREATE(row_dist, int, USE_SIZE);
+	
+	for (y = 0; y < USE_HEIGHT; ++y) {
+		out = row_dist + MAP(0, y);
+		
+		// west-to-east (starting a lap early when wrapping, to see the far side)
+		cur = cap;
+		for (iter = (USE_WRAP_X ? -USE_WIDTH : 0); iter < USE_WIDTH; ++iter) {
+			x = (iter + USE_WIDTH) % USE_WIDTH;
+			cur = (grid[MAP(x, y)].type == near) ? 0 : MIN(cur + 1, cap);
+			if (iter >= 0) {
+				out[x] = cur;
+			}
+		}
+		
+		// east-to-west
+		cur = cap;
+		for (iter = (USE_WRAP_X ? 2 * USE_WIDTH : USE_WIDTH) - 1; iter >= 0; --iter) {
+			x = iter % USE_WIDTH;
+			cur = (grid[MAP(x, y)].type == near) ? 0 : MIN(cur + 1, cap);
+			if (iter < USE_WIDTH) {
+				out[x] = MIN(out[x], cur);
+			}
+		}
+	}
+	
+	for (y = 0; y < USE_HEIGHT; ++y) {
+		for (x = 0; x < USE_WIDTH; ++x) {
+			if (grid[MAP(x, y)].type != from) {
+				continue;
+			}
 			
-			if (grid[at].type == from) {
-				found = 0;
-				for (hor = -dist; hor <= dist && !found; ++hor) {
-					for (ver = -dist; ver <= dist && !found; ++ver) {
-						loc = shift(at, hor, ver);
-						
-						if (loc != -1 && grid[loc].type == near && compute_distance(X_COORD(at), Y_COORD(at), X_COORD(loc), Y_COORD(loc)) <= dist) {
-							change_grid(at, to);
-							found = 1;
-						}
+			for (ver = -dist; ver <= dist; ++ver) {
+				row = y + ver;
+				if (row < 0 || row >= USE_HEIGHT) {
+					if (!USE_WRAP_Y) {
+						continue;
 					}
+					row = (row + USE_HEIGHT) % USE_HEIGHT;
+				}
+				
+				if (row_dist[MAP(x, row)] <= dist && row_dist[MAP(x, row)] * row_dist[MAP(x, row)] + ver * ver < cap * cap) {
+					change_grid(MAP(x, y), to);
+					break;
 				}
 			}
 		}
 	}
+	
+	free(row_dist);
 }
 
 
@@ -1450,9 +1474,9 @@ void splotch(int room, int type, struct island_data *isle) {
 //// BONUS FEATURES //////////////////////////////////////////////////////////
 
 void load_and_shift_map(int dist) {
-	char fname[256], line[1024];
-	FILE *index, *wld;
-	int block, vnum, island, type, junk;
+	char line[256];
+	int var[7];
+	FILE *fl;
 	
 	// nowork
 	if (dist == 0) {
@@ -1461,52 +1485,39 @@ void load_and_shift_map(int dist) {
 	}
 	
 	init_grid();
-	printf("Loaded existing map...\n");
 	
 	// load in existing map
-	if (!(index = fopen("index", "r"))) {
-		printf("ERROR: Unable to load index file.\n");
+	if (!(fl = fopen(BASE_MAP_FILE, "r"))) {
+		printf("ERROR: Unable to load %s.\n", BASE_MAP_FILE);
 		exit(1);
 	}
 	
-	while (fscanf(index, "%d.wld\n", &block) == 1) {
-		sprintf(fname, "%d.wld", block);
-		printf("Loading file %s ...\n", fname);
-		if (!(wld = fopen(fname, "r"))) {
-			printf("ERROR: Unable to open world file %s.\n", fname);
-			exit(1);
+	while (get_line(fl, line)) {
+		if (*line == '$') {
+			break;
 		}
 		
-		while (get_line(wld, line)) {
-			if (*line == '$') {
-				break;
-			}
-			else if (*line == '#') {
-				// found entry
-				vnum = atoi(line + 1);
-				
-				if (!get_line(wld, line) || sscanf(line, "%d %d %d", &island, &type, &junk) != 3) {
-					printf("Error reading room #%d\n", vnum);
-					exit(1);
-				}
-				
-				change_grid(vnum, sect_to_terrain(type));
-				grid[vnum].island_id = island;
-				
-				// trailing 'S' line
-				get_line(wld, line);
-			}
-			else {
-				printf("Unknown line in %s: %s\n", fname, line);
-				exit(1);
-			}
+		// x y island sect base natural crop
+		if (sscanf(line, "%d %d %d %d %d %d %d", &var[0], &var[1], &var[2], &var[3], &var[4], &var[5], &var[6]) != 7) {
+			printf("Bad line in %s: %s\n", BASE_MAP_FILE, line);
+			exit(1);
+		}
+		if (var[0] < 0 || var[0] >= USE_WIDTH || var[1] < 0 || var[1] >= USE_HEIGHT) {
+			printf("Bad location in %s: (%d, %d)\n", BASE_MAP_FILE, var[0], var[1]);
+			exit(1);
 		}
+		
+		change_grid(MAP(var[0], var[1]), sect_to_terrain(var[3]));
+		grid[MAP(var[0], var[1])].island_id = var[2];
 	}
 	
+	fclose(fl);
+	printf("Loaded existing map...\n");
+	
 	shift_map_x(dist);
 	
 	print_map_graphic();
-	print_map_to_files();
+	print_base_map();
 
 	printf("Map shifted %d on X-axis.\n", dist);
 	output_stats();	
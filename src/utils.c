@@ -25,6 +25,7 @@
 #include "skills.h"
 #include "vnums.h"
 #include "dg_scripts.h"
+#include "dg_event.h"
 
 /**
 * Contents:
@@ -42,6 +43,7 @@
 *   Player Utils
 *   Resource Utils
 *   Sector Utils
+*   Slab Utils
 *   String Utils
 *   Type Utils
 *   World Utils
@@ -152,10 +154,10 @@ int att_max(char_data *ch) {
 	int max = 1;
 
 	if (ch && !IS_NPC(ch)) {
-		max = config_get_int("max_player_attribute");
+		max = CONFIG_INT(CONF_MAX_PLAYER_ATTRIBUTE);
 	}
 	else {
-		max = config_get_int("max_npc_attribute");
+		max = CONFIG_INT(CONF_MAX_NPC_ATTRIBUTE);
 	}
 
 	return max;
@@ -476,7 +478,7 @@ void score_empires(void) {
 	empire_data *emp, *next_emp;
 	long long num;
 	
-	int time_to_empire_emptiness = config_get_int("time_to_empire_emptiness") * SECS_PER_REAL_WEEK;
+	int time_to_empire_emptiness = CONFIG_INT(CONF_TIME_TO_EMPIRE_EMPTINESS) * SECS_PER_REAL_WEEK;
 
 	// clear data	
 	for (iter = 0; iter < NUM_SCORES; ++iter) {
@@ -491,6 +493,7 @@ void score_empires(void) {
 			EMPIRE_SCORE(emp, iter) = 0;
 		}
 		EMPIRE_SORT_VALUE(emp) = 0;
+		++EMPIRE_MSDP_VERSION(emp);
 	}
 	
 	#define SCORE_SKIP_EMPIRE(ee)  (EMPIRE_IMM_ONLY(ee) || EMPIRE_LAST_LOGON(ee) + time_to_empire_emptiness < time(0))
@@ -769,7 +772,7 @@ void process_imports(void) {
 	empire_data *emp, *next_emp;
 	int amount;
 	
-	int time_to_empire_emptiness = config_get_int("time_to_empire_emptiness") * SECS_PER_REAL_WEEK;
+	int time_to_empire_emptiness = CONFIG_INT(CONF_TIME_TO_EMPIRE_EMPTINESS) * SECS_PER_REAL_WEEK;
 	
 	HASH_ITER(hh, empire_table, emp, next_emp) {
 		if (EMPIRE_IMM_ONLY(emp)) {
@@ -1009,7 +1012,7 @@ bool is_at_war(empire_data *emp) {
 * @return bool TRUE if the two empires are trading and able to trade.
 */
 bool is_trading_with(empire_data *emp, empire_data *partner) {
-	int time_to_empire_emptiness = config_get_int("time_to_empire_emptiness") * SECS_PER_REAL_WEEK;
+	int time_to_empire_emptiness = CONFIG_INT(CONF_TIME_TO_EMPIRE_EMPTINESS) * SECS_PER_REAL_WEEK;
 	
 	// no self-trades or invalid empires
 	if (emp == partner || !emp || !partner) {
@@ -2178,6 +2181,7 @@ void determine_gear_level(char_data *ch) {
 	level = avg + 50 - 100;	// 50 higher than the average scaled level of their gear, -100 to compensate for skill level
 	
 	GET_GEAR_LEVEL(ch) = MAX(level, 0);
+	MSDP_DIRTY(ch, MSDP_DIRTY_CHARACTER);
 }
 
 
@@ -3175,6 +3179,165 @@ sector_data *find_first_matching_sector(bitvector_t with_flags, bitvector_t with
 }
 
 
+ //////////////////////////////////////////////////////////////////////////////
+//// SLAB UTILS //////////////////////////////////////////////////////////////
+
+// Objects, mobs, affects, etc are created and extracted constantly. Rather than
+// calloc/free each one, they come from per-type pools that carve slots out of
+// large blocks and keep freed slots on a list for reuse.
+
+#define SLAB_BLOCK_BYTES  (64 * 1024)	// target size of each block
+#define SLAB_MIN_PER_BLOCK  16	// even huge structs get at least this many per block
+#define SLAB_ALIGN  16	// slot sizes are rounded up to this
+#define SLAB_POISON_BYTE  0x6B	// freed slots are filled with this when SLAB_POISON is on
+
+// slot size and slots-per-block for a type (slots must hold a free-list pointer)
+#define SLAB_SIZE(type)  (((MAX(sizeof(type), sizeof(void*)) + SLAB_ALIGN - 1) / SLAB_ALIGN) * SLAB_ALIGN)
+#define SLAB_POOL(name, type)  { name, SLAB_SIZE(type), MAX(SLAB_MIN_PER_BLOCK, SLAB_BLOCK_BYTES / SLAB_SIZE(type)) }
+
+// SLAB_x: these must match the SLAB_x consts in structs.h
+struct slab_pool slab_pools[NUM_SLABS] = {
+	SLAB_POOL("obj_data", obj_data),
+	SLAB_POOL("char_data", char_data),
+	SLAB_POOL("room_data", room_data),
+	SLAB_POOL("affected_type", struct affected_type),
+	SLAB_POOL("track_data", struct track_data),
+	SLAB_POOL("q_element", struct q_element),
+};
+
+
+/**
+* Determines whether a pointer is the start of a slot in one of the pool's
+* blocks. This is only used when SLAB_POISON is on, as it walks every block.
+*
+* @param struct slab_pool *sp The pool.
+* @param void *ptr The pointer to check.
+* @return bool TRUE if ptr is a slot in that pool.
+*/
+static bool slab_owns(struct slab_pool *sp, void *ptr) {
+	struct slab_block *block;
+	char *pos = (char*)ptr;
+	
+	for (block = sp->blocks; block; block = block->next) {
+		if (pos >= block->data && pos < block->data + sp->per_block * sp->size) {
+			return ((pos - block->data) % sp->size) == 0;
+		}
+	}
+	return FALSE;
+}
+
+
+/**
+* Checks that a freed slot still holds nothing but poison (other than the
+* free-list pointer at the front of it).
+*
+* @param struct slab_pool *sp The pool.
+* @param void *ptr The freed slot.
+* @return bool TRUE if the slot is untouched since it was freed.
+*/
+static bool slab_is_poisoned(struct slab_pool *sp, void *ptr) {
+	unsigned char *pos;
+	
+	for (pos = (unsigned char*)ptr + sizeof(void*); pos < (unsigned char*)ptr + sp->size; ++pos) {
+		if (*pos != SLAB_POISON_BYTE) {
+			return FALSE;
+		}
+	}
+	return TRUE;
+}
+
+
+/**
+* Gets one zeroed slot from a slab pool. Use this through the CREATE_SLAB()
+* macro, and release the slot with FREE_SLAB() -- never with free().
+*
+* @param int pool Which SLAB_x pool to use.
+* @return void* The new, zeroed memory.
+*/
+void *slab_alloc(int pool) {
+	struct slab_pool *sp = &slab_pools[pool];
+	struct slab_block *block;
+	void *ptr;
+	
+	if (sp->free_list) {
+		ptr = sp->free_list;
+		sp->free_list = *(void**)ptr;
+		
+		if (SLAB_POISON && !slab_is_poisoned(sp, ptr)) {
+			log("SYSERR: slab_alloc: %s slot %p was written to after being freed", sp->name, ptr);
+		}
+	}
+	else {
+		if (sp->unused_in_block == 0) {
+			CREATE(block, struct slab_block, 1);
+			if (!(block->data = malloc(sp->per_block * sp->size))) {
+				log("SYSERR: malloc failure: %s: %d", __FILE__, __LINE__);
+				abort();
+			}
+			block->next = sp->blocks;
+			sp->blocks = block;
+			++sp->num_blocks;
+			sp->unused_in_block = sp->per_block;
+		}
+		
+		// slots are handed out from the front of the newest block
+		ptr = sp->blocks->data + (sp->per_block - sp->unused_in_block) * sp->size;
+		--sp->unused_in_block;
+	}
+	
+	memset(ptr, 0, sp->size);
+	
+	++sp->total_allocs;
+	if (++sp->in_use > sp->peak) {
+		sp->peak = sp->in_use;
+	}
+	return ptr;
+}
+
+
+/**
+* Returns a slot to its slab pool for reuse. This must only be called on
+* memory that came from slab_alloc() for the same pool.
+*
+* @param int pool Which SLAB_x pool the memory came from.
+* @param void *ptr The memory to release (may be NULL).
+*/
+void slab_free(int pool, void *ptr) {
+	struct slab_pool *sp = &slab_pools[pool];
+	
+	if (!ptr) {
+		return;
+	}
+	
+	if (SLAB_POISON) {
+		if (!slab_owns(sp, ptr)) {
+			log("SYSERR: slab_free: %p is not a %s slot", ptr, sp->name);
+			return;
+		}
+		if (slab_is_poisoned(sp, ptr)) {
+			log("SYSERR: slab_free: %s slot %p appears to be freed twice", sp->name, ptr);
+			return;
+		}
+		memset(ptr, SLAB_POISON_BYTE, sp->size);
+	}
+	
+	*(void**)ptr = sp->free_list;
+	sp->free_list = ptr;
+	
+	--sp->in_use;
+	++sp->total_frees;
+}
+
+
+/**
+* @param int pool Any SLAB_x pool.
+* @return struct slab_pool* The pool and its stats, or NULL for a bad pool.
+*/
+struct slab_pool *slab_pool_info(int pool) {
+	return (pool >= 0 && pool < NUM_SLABS) ? &slab_pools[pool] : NULL;
+}
+
+
  //////////////////////////////////////////////////////////////////////////////
 //// STRING UTILS ////////////////////////////////////////////////////////////
 
@@ -3341,7 +3504,7 @@ int color_code_length(const char *str) {
 				++ptr;
 				++len;	// only 1 char counts as a color code, the other is removed
 			}
-			else if (*(ptr+1) == '[' && config_get_bool("allow_extended_color_codes")) {
+			else if (*(ptr+1) == '[' && CONFIG_BOOL(CONF_ALLOW_EXTENDED_COLOR_CODES)) {
 				++len;	// 1 for the &
 				if (UPPER(*(ptr+2)) != 'U') {
 					++len;	// we skip 1 len if there is a U because 1 char will be visible
@@ -4697,6 +4860,7 @@ bool is_deep_mine(room_data *room) {
 * @param struct icon_data *use_icon Optional: Force it to use this icon (may be NULL).
 */
 void lock_icon(room_data *room, struct icon_data *use_icon) {
+	void clear_map_icon_cache(room_data *room, struct map_data *map);
 	extern struct icon_data *get_icon_from_set(struct icon_data *set, int type);
 	extern int pick_season(room_data *room);
 	
@@ -4713,6 +4877,7 @@ void lock_icon(room_data *room, struct icon_data *use_icon) {
 		icon = get_icon_from_set(GET_SECT_ICONS(SECT(room)), season);
 	}
 	ROOM_CUSTOM_ICON(room) = str_dup(icon->icon);
+	clear_map_icon_cache(room, NULL);
 }
 
 
@@ -431,6 +431,9 @@ extern int GET_MAX_BLOOD(char_data *ch);	// this one is different than the other
 #define STATE(d)  ((d)->connected)
 #define SUBMENU(d)  ((d)->submenu)
 
+// marks MSDP_DIRTY_x groups for recompute on a character's next msdp_update()
+#define MSDP_DIRTY(ch, flags)  do { if ((ch)->desc) { SET_BIT((ch)->desc->msdp_dirty, (flags)); } } while (0)
+
 
 // OLC_x: olc getters
 #define GET_OLC_TYPE(desc)  ((desc)->olc_type)
@@ -469,6 +472,7 @@ extern int GET_MAX_BLOOD(char_data *ch);	// this one is different than the other
 #define EMPIRE_ADJECTIVE(emp)  ((emp)->adjective)
 #define EMPIRE_BANNER(emp)  ((emp)->banner)
 #define EMPIRE_BANNER_HAS_UNDERLINE(emp)  ((emp)->banner_has_underline)
+#define EMPIRE_MAPOUT_TOKEN(emp)  ((emp)->mapout_token)
 #define EMPIRE_NUM_RANKS(emp)  ((emp)->num_ranks)
 #define EMPIRE_RANK(emp, num)  ((emp)->rank[(num)])
 #define EMPIRE_FRONTIER_TRAITS(emp)  ((emp)->frontier_traits)
@@ -480,6 +484,7 @@ extern int GET_MAX_BLOOD(char_data *ch);	// this one is different than the other
 #define EMPIRE_TRADE(emp)  ((emp)->trade)
 #define EMPIRE_LOGS(emp)  ((emp)->logs)
 #define EMPIRE_TERRITORY_LIST(emp)  ((emp)->territory_list)
+#define EMPIRE_TERRITORY_HASH(emp)  ((emp)->territory_hash)
 #define EMPIRE_CITY_LIST(emp)  ((emp)->city_list)
 #define EMPIRE_CITY_TERRITORY(emp)  ((emp)->city_terr)
 #define EMPIRE_OUTSIDE_TERRITORY(emp)  ((emp)->outside_terr)
@@ -487,6 +492,7 @@ extern int GET_MAX_BLOOD(char_data *ch);	// this one is different than the other
 #define EMPIRE_POPULATION(emp)  ((emp)->population)
 #define EMPIRE_MILITARY(emp)  ((emp)->military)
 #define EMPIRE_MOTD(emp)  ((emp)->motd)
+#define EMPIRE_MSDP_VERSION(emp)  ((emp)->msdp_version)
 #define EMPIRE_NEEDS_SAVE(emp)  ((emp)->needs_save)
 #define EMPIRE_GREATNESS(emp)  ((emp)->greatness)
 #define EMPIRE_TECH(emp, num)  ((emp)->tech[(num)])
@@ -502,11 +508,13 @@ extern int GET_MAX_BLOOD(char_data *ch);	// this one is different than the other
 #define EMPIRE_UNIQUE_STORAGE(emp)  ((emp)->unique_store)
 #define EMPIRE_WORKFORCE_TRACKER(emp)  ((emp)->ewt_tracker)
 #define EMPIRE_ISLANDS(emp)  ((emp)->islands)
+#define EMPIRE_NPC_CELLS(emp)  ((emp)->npc_cells)
+#define EMPIRE_CHORE_ROOMS(emp, chore)  ((emp)->chore_rooms[(chore)])
 #define EMPIRE_TOP_SHIPPING_ID(emp)  ((emp)->top_shipping_id)
 
 // helpers
 #define EMPIRE_HAS_TECH(emp, num)  (EMPIRE_TECH((emp), (num)) > 0)
-#define EMPIRE_IS_TIMED_OUT(emp)  (EMPIRE_LAST_LOGON(emp) + (config_get_int("whole_empire_timeout") * SECS_PER_REAL_DAY) < time(0))
+#define EMPIRE_IS_TIMED_OUT(emp)  (EMPIRE_LAST_LOGON(emp) + (CONFIG_INT(CONF_WHOLE_EMPIRE_TIMEOUT) * SECS_PER_REAL_DAY) < time(0))
 #define GET_TOTAL_WEALTH(emp)  (EMPIRE_WEALTH(emp) + (EMPIRE_COINS(emp) * COIN_VALUE))
 #define EXPLICIT_BANNER_TERMINATOR(emp)  (EMPIRE_BANNER_HAS_UNDERLINE(emp) ? "\t0" : "")
 
@@ -598,6 +606,10 @@ extern int Y_COORD(room_data *room);	// formerly #define Y_COORD(room)  FLAT_Y_C
   if (!((result) = (type *) realloc ((result), sizeof(type) * (number))))\
 		{ log("SYSERR: realloc failure: %s: %d", __FILE__, __LINE__); abort(); } } while(0)
 
+// allocates one zeroed struct from a slab pool (SLAB_x); free it with FREE_SLAB
+#define CREATE_SLAB(result, type, pool)  ((result) = (type *) slab_alloc(pool))
+#define FREE_SLAB(pool, ptr)  slab_free((pool), (ptr))
+
 /*
  * the source previously used the same code in many places to remove an item
  * from a list: if it's the list head, change the head, else traverse the
@@ -695,7 +707,6 @@ extern int Y_COORD(room_data *room);	// formerly #define Y_COORD(room)  FLAT_Y_C
 #define GET_OBJ_QUEST_LOOKUPS(obj)  ((obj)->quest_lookups)
 #define GET_OBJ_REQUIRES_QUEST(obj)  ((obj)->obj_flags.requires_quest)
 #define GET_OBJ_SHORT_DESC(obj)  ((obj)->short_description)
-#define GET_OBJ_TIMER(obj)  ((obj)->obj_flags.timer)
 #define GET_OBJ_TYPE(obj)  ((obj)->obj_flags.type_flag)
 #define GET_OBJ_VAL(obj, val)  ((obj)->obj_flags.value[(val)])
 #define GET_OBJ_WEAR(obj)  ((obj)->obj_flags.wear_flags)
@@ -705,13 +716,17 @@ extern int Y_COORD(room_data *room);	// formerly #define Y_COORD(room)  FLAT_Y_C
 #define OBJ_BOUND_TO(obj)  ((obj)->bound_to)
 #define OBJ_VERSION(obj)  ((obj)->version)
 
+// decay timer: these run through the timer wheel in limits.c
+extern int GET_OBJ_TIMER(obj_data *obj);	// formerly #define GET_OBJ_TIMER(obj)  ((obj)->obj_flags.timer)
+void SET_OBJ_TIMER(obj_data *obj, int timer);	// formerly set directly through GET_OBJ_TIMER
+
 // compound attributes
 #define GET_OBJ_DESC(obj, ch, mode)  get_obj_desc((obj), (ch), (mode))
 #define GET_OBJ_VNUM(obj)  ((obj)->vnum)
 
 // definitions
 #define IS_BLOOD_WEAPON(obj)  (GET_OBJ_VNUM(obj) == o_BLOODSWORD || GET_OBJ_VNUM(obj) == o_BLOODSTAFF || GET_OBJ_VNUM(obj) == o_BLOODSPEAR || GET_OBJ_VNUM(obj) == o_BLOODSKEAN || GET_OBJ_VNUM(obj) == o_BLOODMACE)
-#define IS_STOLEN(obj)  (GET_STOLEN_TIMER(obj) > 0 && (config_get_int("stolen_object_timer") * SECS_PER_REAL_MIN) + GET_STOLEN_TIMER(obj) > time(0))
+#define IS_STOLEN(obj)  (GET_STOLEN_TIMER(obj) > 0 && (CONFIG_INT(CONF_STOLEN_OBJECT_TIMER) * SECS_PER_REAL_MIN) + GET_STOLEN_TIMER(obj) > time(0))
 
 // helpers
 #define OBJ_FLAGGED(obj, flag)  (IS_SET(GET_OBJ_EXTRA(obj), (flag)))
@@ -931,6 +946,7 @@ extern int Y_COORD(room_data *room);	// formerly #define Y_COORD(room)  FLAT_Y_C
 #define GET_MOUNT_LIST(ch)  CHECK_PLAYER_SPECIAL((ch), ((ch)->player_specials->mount_list))
 #define GET_MOUNT_VNUM(ch)  CHECK_PLAYER_SPECIAL((ch), ((ch)->player_specials->mount_vnum))
 #define GET_MOVE_TIME(ch, pos)  CHECK_PLAYER_SPECIAL((ch), ((ch)->player_specials->move_time[(pos)]))
+#define GET_NAME_INDEX_REFS(ch)  CHECK_PLAYER_SPECIAL((ch), ((ch)->player_specials->name_index_refs))
 #define GET_OFFERS(ch)  CHECK_PLAYER_SPECIAL((ch), ((ch)->player_specials->offers))
 #define GET_OLC_FLAGS(ch)  CHECK_PLAYER_SPECIAL((ch), ((ch)->player_specials->olc_flags))
 #define GET_OLC_MAX_VNUM(ch)  CHECK_PLAYER_SPECIAL((ch), ((ch)->player_specials->olc_max_vnum))
@@ -945,6 +961,7 @@ extern int Y_COORD(room_data *room);	// formerly #define Y_COORD(room)  FLAT_Y_C
 #define GET_REFERRED_BY(ch)  CHECK_PLAYER_SPECIAL((ch), ((ch)->player_specials->referred_by))
 #define GET_RESOURCE(ch, i)  CHECK_PLAYER_SPECIAL((ch), ((ch)->player_specials->resources[i]))
 #define GET_REWARDED_TODAY(ch, pos)  CHECK_PLAYER_SPECIAL((ch), ((ch)->player_specials->rewarded_today[(pos)]))
+#define GET_SKILL_CACHE(ch)  CHECK_PLAYER_SPECIAL((ch), ((ch)->player_specials->skill_cache))
 #define GET_SKILL_HASH(ch)  CHECK_PLAYER_SPECIAL((ch), ((ch)->player_specials->skill_hash))
 #define GET_SKILL_LEVEL(ch)  CHECK_PLAYER_SPECIAL((ch), ((ch)->player_specials->skill_level))
 #define GET_SLASH_CHANNELS(ch)  CHECK_PLAYER_SPECIAL((ch), ((ch)->player_specials->slash_channels))
@@ -990,7 +1007,7 @@ extern int Y_COORD(room_data *room);	// formerly #define Y_COORD(room)  FLAT_Y_C
 #define IS_IMMORTAL(ch)  (GET_ACCESS_LEVEL(ch) >= LVL_START_IMM)
 #define IS_RIDING(ch)  (!IS_NPC(ch) && GET_MOUNT_VNUM(ch) != NOTHING && MOUNT_FLAGGED(ch, MOUNT_RIDING))
 #define IS_THIRSTY(ch)  (GET_COND(ch, THIRST) >= 360 && !has_ability(ch, ABIL_UNNATURAL_THIRST) && !has_ability(ch, ABIL_SATED_THIRST))
-#define IS_BLOOD_STARVED(ch)  (IS_VAMPIRE(ch) && GET_BLOOD(ch) <= config_get_int("blood_starvation_level"))
+#define IS_BLOOD_STARVED(ch)  (IS_VAMPIRE(ch) && GET_BLOOD(ch) <= CONFIG_INT(CONF_BLOOD_STARVATION_LEVEL))
 
 // for act() and act-like things (requires to_sleeping and is_spammy set to true/false)
 #define SENDOK(ch)  (((ch)->desc || SCRIPT_CHECK((ch), MTRIG_ACT)) && (to_sleeping || AWAKE(ch)) && (!PRF_FLAGGED(ch, PRF_NOSPAM) || !is_spammy))
@@ -1078,9 +1095,9 @@ extern int Y_COORD(room_data *room);	// formerly #define Y_COORD(room)  FLAT_Y_C
 // definitions
 #define BLD_ALLOWS_MOUNTS(room)  (ROOM_IS_CLOSED(room) ? (ROOM_BLD_FLAGGED((room), BLD_ALLOW_MOUNTS | BLD_OPEN) || RMT_FLAGGED((room), RMT_OUTDOOR)) : TRUE)
 #define CAN_CHOP_ROOM(room)  (has_evolution_type(SECT(room), EVO_CHOPPED_DOWN) || CAN_INTERACT_ROOM((room), INTERACT_CHOP) || (ROOM_SECT_FLAGGED((room), SECTF_CROP) && ROOM_CROP_FLAGGED((room), CROPF_IS_ORCHARD)))
-#define DEPLETION_LIMIT(room)  (ROOM_BLD_FLAGGED((room), BLD_HIGH_DEPLETION) ? config_get_int("high_depletion") : config_get_int("common_depletion"))
-#define HAS_MINOR_DISREPAIR(room)  (HOME_ROOM(room) == room && GET_BUILDING(room) && BUILDING_DAMAGE(room) > 0 && (BUILDING_DAMAGE(room) >= (GET_BLD_MAX_DAMAGE(GET_BUILDING(room)) * config_get_int("disrepair_minor") / 100)))
-#define HAS_MAJOR_DISREPAIR(room)  (HOME_ROOM(room) == room && GET_BUILDING(room) && BUILDING_DAMAGE(room) > 0 && (BUILDING_DAMAGE(room) >= (GET_BLD_MAX_DAMAGE(GET_BUILDING(room)) * config_get_int("disrepair_major") / 100)))
+#define DEPLETION_LIMIT(room)  (ROOM_BLD_FLAGGED((room), BLD_HIGH_DEPLETION) ? CONFIG_INT(CONF_HIGH_DEPLETION) : CONFIG_INT(CONF_COMMON_DEPLETION))
+#define HAS_MINOR_DISREPAIR(room)  (HOME_ROOM(room) == room && GET_BUILDING(room) && BUILDING_DAMAGE(room) > 0 && (BUILDING_DAMAGE(room) >= (GET_BLD_MAX_DAMAGE(GET_BUILDING(room)) * CONFIG_INT(CONF_DISREPAIR_MINOR) / 100)))
+#define HAS_MAJOR_DISREPAIR(room)  (HOME_ROOM(room) == room && GET_BUILDING(room) && BUILDING_DAMAGE(room) > 0 && (BUILDING_DAMAGE(room) >= (GET_BLD_MAX_DAMAGE(GET_BUILDING(room)) * CONFIG_INT(CONF_DISREPAIR_MAJOR) / 100)))
 #define IS_CITY_CENTER(room)  (BUILDING_VNUM(room) == BUILDING_CITY_CENTER)
 #define IS_DARK(room)  (MAGIC_DARKNESS(room) || (!IS_ANY_BUILDING(room) && ROOM_LIGHTS(room) == 0 && (!ROOM_OWNER(room) || !EMPIRE_HAS_TECH(ROOM_OWNER(room), TECH_CITY_LIGHTS)) && !RMT_FLAGGED((room), RMT_LIGHT) && (weather_info.sunlight == SUN_DARK || RMT_FLAGGED((room), RMT_DARK))))
 #define IS_LIGHT(room)  (!MAGIC_DARKNESS(room) && WOULD_BE_LIGHT_WITHOUT_MAGIC_DARKNESS(room))
@@ -1285,6 +1302,7 @@ void SET_ISLAND_ID(room_data *room, int island);	// formerly a #define and a roo
  //////////////////////////////////////////////////////////////////////////////
 //// CONST EXTERNS ///////////////////////////////////////////////////////////
 
+extern union config_slot_data config_slots[NUM_CONFIG_SLOTS];	// config.c
 extern FILE *logfile;	// comm.c
 extern const int shift_dir[][2];	// constants.c
 extern struct weather_data weather_info;	// db.c
@@ -1386,6 +1404,11 @@ void halve_resource_list(struct resource_data **list, bool remove_nonrefundables
 extern bool has_resources(char_data *ch, struct resource_data *list, bool ground, bool send_msgs);
 void show_resource_list(struct resource_data *list, char *save_buffer);
 
+// slab functions from utils.c
+void *slab_alloc(int pool);
+void slab_free(int pool, void *ptr);
+extern struct slab_pool *slab_pool_info(int pool);
+
 // string functions from utils.c
 extern bitvector_t asciiflag_conv(char *flag);
 extern char *bitv_to_alpha(bitvector_t flags);
@@ -1564,6 +1587,12 @@ extern char *get_vehicle_name_by_proto(obj_vnum vnum);
 // shortcudt for messaging
 #define send_config_msg(ch, conf)  msg_to_char((ch), "%s\r\n", config_get_string(conf))
 
+// fast reads of pre-resolved configs: CONF_x (see CONFIG_SLOT_LIST)
+#define CONFIG_BITVECTOR(slot)  (config_slots[(slot)].bitvector_val)
+#define CONFIG_BOOL(slot)  (config_slots[(slot)].bool_val)
+#define CONFIG_DOUBLE(slot)  (config_slots[(slot)].double_val)
+#define CONFIG_INT(slot)  (config_slots[(slot)].int_val)
+
 
  //////////////////////////////////////////////////////////////////////////////
 //// CONSTS FOR UTILS.C //////////////////////////////////////////////////////
@@ -169,7 +169,7 @@ room_data *get_vehicle_interior(vehicle_data *veh) {
 	// otherwise, create the interior
 	room = create_room();
 	attach_building_to_room(bld, room, TRUE);
-	COMPLEX_DATA(room)->home_room = NULL;
+	set_room_home(room, NULL);
 	SET_BIT(ROOM_AFF_FLAGS(room), ROOM_AFF_IN_VEHICLE);
 	SET_BIT(ROOM_BASE_FLAGS(room), ROOM_AFF_IN_VEHICLE);
 	
@@ -818,6 +818,7 @@ vehicle_data *read_vehicle(any_vnum vnum, bool with_triggers) {
 
 	*veh = *proto;
 	LL_PREPEND2(vehicle_list, veh, next);
+	veh->list_seq = ++top_list_seq;
 	
 	// new vehicle setup
 	VEH_OWNER(veh) = NULL;
@@ -2036,6 +2037,7 @@ void save_olc_vehicle(descriptor_data *desc) {
 		// update pointers
 		if (VEH_KEYWORDS(iter) == VEH_KEYWORDS(proto)) {
 			VEH_KEYWORDS(iter) = VEH_KEYWORDS(veh);
+			index_vehicle_keywords(iter);
 		}
 		if (VEH_SHORT_DESC(iter) == VEH_SHORT_DESC(proto)) {
 			VEH_SHORT_DESC(iter) = VEH_SHORT_DESC(veh);
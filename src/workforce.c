@@ -34,8 +34,8 @@
 *   Vehicle Chore Functions
 */
 
-// for territory iteration
-struct empire_territory_data *global_next_territory_entry = NULL;
+// for chore worklist iteration
+struct empire_chore_room *global_next_chore_room = NULL;
 
 // protos
 void do_chore_brickmaking(empire_data *emp, room_data *room);
@@ -125,124 +125,371 @@ int einv_interaction_chore_type = 0;
 
 
 /**
-* This runs once an hour on every empire room. It will try to run a chore on
-* that room, if applicable. This is only called if the empire has Workforce.
+* Determines whether a room could need a given chore, based only on things that
+* change when the room is built on, re-terrained, re-cropped, or set on fire.
+* This must be a superset of the checks in process_one_chore(), which handles
+* things that change constantly (damage, mine amounts, techs, limits).
+*
+* @param room_data *room The room to check.
+* @param int chore Any CHORE_x.
+* @return bool TRUE if the room belongs on that chore's worklist.
+*/
+bool room_may_need_chore(room_data *room, int chore) {
+	switch (chore) {
+		case CHORE_FIRE_BRIGADE: {
+			return (BUILDING_BURNING(room) > 0);
+		}
+		case CHORE_CHOPPING: {
+			// All choppables -- except crops, which are handled by farming
+			return (!ROOM_CROP(room) && (has_evolution_type(SECT(room), EVO_CHOPPED_DOWN) || CAN_INTERACT_ROOM(room, INTERACT_CHOP)));
+		}
+		case CHORE_FARMING: {
+			return ROOM_SECT_FLAGGED(room, SECTF_CROP);
+		}
+		case CHORE_BUILDING: {
+			return (IS_INCOMPLETE(room) || IS_DISMANTLING(room));
+		}
+	}
+	
+	// everything else is only for complete buildings
+	if (!IS_COMPLETE(room)) {
+		return FALSE;
+	}
+	
+	switch (chore) {
+		case CHORE_MAINTENANCE: {
+			return (COMPLEX_DATA(room) && HOME_ROOM(room) == room);
+		}
+		case CHORE_HERB_GARDENING: {
+			// this covers all the herbs
+			return (IS_ANY_BUILDING(room) && CAN_INTERACT_ROOM(room, INTERACT_FIND_HERB));
+		}
+		case CHORE_MINTING: {
+			return HAS_FUNCTION(room, FNC_MINT);
+		}
+		case CHORE_MINING: {
+			return HAS_FUNCTION(room, FNC_MINE);
+		}
+		case CHORE_DISMANTLE_MINES: {
+			return (HAS_FUNCTION(room, FNC_MINE) && IS_MAP_BUILDING(room));
+		}
+		case CHORE_BRICKMAKING: {
+			return HAS_FUNCTION(room, FNC_POTTER);
+		}
+		case CHORE_SMELTING: {
+			return HAS_FUNCTION(room, FNC_SMELT);
+		}
+		case CHORE_WEAVING: {
+			return HAS_FUNCTION(room, FNC_TAILOR);
+		}
+		case CHORE_NAILMAKING: {
+			return HAS_FUNCTION(room, FNC_FORGE);
+		}
+		case CHORE_SCRAPING:
+		case CHORE_SAWING: {
+			return HAS_FUNCTION(room, FNC_SAW);
+		}
+		case CHORE_DIGGING: {
+			return HAS_FUNCTION(room, FNC_DIGGING);
+		}
+		case CHORE_TRAPPING: {
+			return (BUILDING_VNUM(room) == BUILDING_TRAPPERS_POST);
+		}
+		case CHORE_TANNING: {
+			return HAS_FUNCTION(room, FNC_TANNERY);
+		}
+		case CHORE_SHEARING: {
+			return HAS_FUNCTION(room, FNC_STABLE);
+		}
+		case CHORE_QUARRYING: {
+			return CAN_INTERACT_ROOM(room, INTERACT_QUARRY);
+		}
+		case CHORE_MILLING: {
+			return HAS_FUNCTION(room, FNC_MILL);
+		}
+		case CHORE_OILMAKING: {
+			return HAS_FUNCTION(room, FNC_PRESS);
+		}
+		case CHORE_NEXUS_CRYSTALS: {
+			return (BUILDING_VNUM(room) == RTYPE_SORCERER_TOWER);
+		}
+		default: {
+			// abandon/replanting/vehicle chores are not run on territory
+			return FALSE;
+		}
+	}
+}
+
+
+/**
+* Adds a territory entry to each of its empire's chore worklists that it may
+* need (see room_may_need_chore). Call this any time a room might gain a chore.
+* Entries that no longer qualify are dropped lazily by chore_update().
+*
+* @param empire_data *emp The empire whose worklists to use.
+* @param struct empire_territory_data *ter The territory entry to add.
+*/
+void schedule_territory_chores(empire_data *emp, struct empire_territory_data *ter) {
+	struct empire_chore_room *ecr;
+	int chore;
+	
+	if (!emp || !ter || !ter->room) {
+		return;
+	}
+	
+	for (chore = 0; chore < NUM_CHORES; ++chore) {
+		if (IS_SET(ter->chores, BIT(chore)) || !room_may_need_chore(ter->room, chore)) {
+			continue;
+		}
+		
+		CREATE(ecr, struct empire_chore_room, 1);
+		ecr->ter = ter;
+		ecr->chore = chore;
+		
+		// prepend: a chore_update already in progress won't reach it this time
+		DL_PREPEND(EMPIRE_CHORE_ROOMS(emp, chore), ecr);
+		LL_PREPEND2(ter->chore_rooms, ecr, next_in_ter);
+		SET_BIT(ter->chores, BIT(chore));
+	}
+}
+
+
+/**
+* Checks a room's owner's chore worklists for anything it may now need. This
+* is safe to call on any room, owned or not.
+*
+* @param room_data *room The room that changed.
+*/
+void schedule_room_chores(room_data *room) {
+	struct empire_territory_data *ter;
+	
+	if (room && ROOM_OWNER(room) && (ter = find_territory_entry(ROOM_OWNER(room), room))) {
+		schedule_territory_chores(ROOM_OWNER(room), ter);
+	}
+}
+
+
+/**
+* Puts a building that just caught fire on the fire brigade's worklist, along
+* with all of its interior rooms (each of which can send a worker).
+*
+* @param room_data *home The home room of the burning building.
+*/
+void schedule_fire_brigade(room_data *home) {
+	room_data *iter;
+	
+	schedule_room_chores(home);
+	
+	if (COMPLEX_DATA(home)) {
+		DL_FOREACH2(COMPLEX_DATA(home)->interior_rooms, iter, next_in_home) {
+			schedule_room_chores(iter);
+		}
+	}
+}
+
+
+/**
+* Re-checks every empire's territory for the chore worklists. This runs
+* whenever OLC changes something that might affect a lot of rooms at once.
+*/
+void schedule_all_territory_chores(void) {
+	struct empire_territory_data *ter;
+	empire_data *emp, *next_emp;
+	
+	HASH_ITER(hh, empire_table, emp, next_emp) {
+		for (ter = EMPIRE_TERRITORY_LIST(emp); ter; ter = ter->next) {
+			schedule_territory_chores(emp, ter);
+		}
+	}
+}
+
+
+/**
+* Takes one entry off its chore worklist.
+*
+* @param empire_data *emp The empire whose worklist it's on.
+* @param struct empire_chore_room *ecr The entry to remove (will be freed).
+*/
+static void remove_chore_room(empire_data *emp, struct empire_chore_room *ecr) {
+	// prevent loss
+	if (ecr == global_next_chore_room) {
+		global_next_chore_room = ecr->next;
+	}
+	
+	DL_DELETE(EMPIRE_CHORE_ROOMS(emp, ecr->chore), ecr);
+	LL_DELETE2(ecr->ter->chore_rooms, ecr, next_in_ter);
+	REMOVE_BIT(ecr->ter->chores, BIT(ecr->chore));
+	free(ecr);
+}
+
+
+/**
+* Takes a territory entry off all of its empire's chore worklists, e.g. before
+* deleting it.
+*
+* @param empire_data *emp The empire whose worklists it's on.
+* @param struct empire_territory_data *ter The territory entry.
+*/
+void remove_territory_chores(empire_data *emp, struct empire_territory_data *ter) {
+	while (ter->chore_rooms) {
+		remove_chore_room(emp, ter->chore_rooms);
+	}
+}
+
+
+/**
+* This runs once an hour for each room on a chore's worklist. It will try to
+* run that chore on the room, if applicable. This is only called if the empire
+* has Workforce, and the room is known to pass room_may_need_chore().
 *
 * @param empire_data *emp the empire -- a shortcut to prevent re-detecting
-* @param room_data *room
+* @param struct empire_territory_data *ter The territory entry to work on.
+* @param int chore Which CHORE_x to run.
 */
-void process_one_chore(empire_data *emp, room_data *room) {	
+void process_one_chore(empire_data *emp, struct empire_territory_data *ter, int chore) {
+	room_data *room = ter->room;
 	int island = GET_ISLAND_ID(room);	// just look this up once
 	
 	#define CHORE_ACTIVE(chore)  (empire_chore_limit(emp, island, (chore)) != 0)
+	// for chores that take over the whole room for the cycle
+	#define CHORE_PREEMPTS(chore)  (IS_SET(ter->chores, BIT(chore)) && CHORE_ACTIVE(chore) && room_may_need_chore(room, (chore)))
+	
+	if (!CHORE_ACTIVE(chore)) {
+		return;
+	}
 	
 	// fire!
-	if (BUILDING_BURNING(room) > 0 && CHORE_ACTIVE(CHORE_FIRE_BRIGADE)) {
+	if (chore == CHORE_FIRE_BRIGADE) {
 		do_chore_fire_brigade(emp, room);
 		return;
 	}
+	else if (BUILDING_BURNING(room) > 0 && CHORE_ACTIVE(CHORE_FIRE_BRIGADE)) {
+		return;	// fire brigade only
+	}
 	
 	// wait wait don't work here
 	if (ROOM_AFF_FLAGGED(room, ROOM_AFF_NO_WORK | ROOM_AFF_HAS_INSTANCE) || !check_in_city_requirement(room, TRUE)) {
 		return;
 	}
 	
-	// All choppables -- except crops, which are handled by farming
-	if (CHORE_ACTIVE(CHORE_CHOPPING) && !ROOM_CROP(room) && (has_evolution_type(SECT(room), EVO_CHOPPED_DOWN) || CAN_INTERACT_ROOM((room), INTERACT_CHOP))) {
-		do_chore_chopping(emp, room);
+	// choppables and crops get nothing else while those chores are on
+	if (chore != CHORE_CHOPPING && CHORE_PREEMPTS(CHORE_CHOPPING)) {
 		return;
 	}
-	
-	// crops
-	if (ROOM_SECT_FLAGGED(room, SECTF_CROP) && CHORE_ACTIVE(CHORE_FARMING)) {
-		do_chore_farming(emp, room);
+	if (chore != CHORE_CHOPPING && chore != CHORE_FARMING && CHORE_PREEMPTS(CHORE_FARMING)) {
 		return;
 	}
 	
-	// building
-	if ((IS_INCOMPLETE(room) || IS_DISMANTLING(room)) && CHORE_ACTIVE(CHORE_BUILDING)) {
-		if (!IS_DISMANTLING(room)) {
-			do_chore_building(emp, room, CHORE_BUILDING);
+	switch (chore) {
+		case CHORE_CHOPPING: {
+			do_chore_chopping(emp, room);
+			break;
 		}
-		else {
-			do_chore_dismantle(emp, room);
+		case CHORE_FARMING: {
+			do_chore_farming(emp, room);
+			break;
 		}
-		
-		// do not trigger other actions in the same room in 1 cycle
-		return;
-	}
-	
-	// buildings
-	if (IS_COMPLETE(room)) {
-		if ((BUILDING_DAMAGE(room) > 0 || BUILDING_RESOURCES(room)) && HOME_ROOM(room) == room && CHORE_ACTIVE(CHORE_MAINTENANCE)) {
-			do_chore_building(emp, room, CHORE_MAINTENANCE);
+		case CHORE_BUILDING: {
+			if (!IS_DISMANTLING(room)) {
+				do_chore_building(emp, room, CHORE_BUILDING);
+			}
+			else {
+				do_chore_dismantle(emp, room);
+			}
+			break;
 		}
-		
-		// this covers all the herbs
-		if (EMPIRE_HAS_TECH(emp, TECH_SKILLED_LABOR) && CHORE_ACTIVE(CHORE_HERB_GARDENING) && IS_ANY_BUILDING(room) && CAN_INTERACT_ROOM(room, INTERACT_FIND_HERB)) {
-			do_chore_gardening(emp, room);
+		case CHORE_MAINTENANCE: {
+			if (BUILDING_DAMAGE(room) > 0 || BUILDING_RESOURCES(room)) {
+				do_chore_building(emp, room, CHORE_MAINTENANCE);
+			}
+			break;
 		}
-	
-		if (HAS_FUNCTION(room, FNC_MINT) && EMPIRE_HAS_TECH(emp, TECH_SKILLED_LABOR) && CHORE_ACTIVE(CHORE_MINTING)) {
-			do_chore_minting(emp, room);
+		case CHORE_HERB_GARDENING: {
+			if (EMPIRE_HAS_TECH(emp, TECH_SKILLED_LABOR)) {
+				do_chore_gardening(emp, room);
+			}
+			break;
 		}
-		
-		if (HAS_FUNCTION(room, FNC_MINE)) {
+		case CHORE_MINTING: {
+			if (EMPIRE_HAS_TECH(emp, TECH_SKILLED_LABOR)) {
+				do_chore_minting(emp, room);
+			}
+			break;
+		}
+		case CHORE_MINING: {
 			if (get_room_extra_data(room, ROOM_EXTRA_MINE_AMOUNT) > 0) {
-				if (CHORE_ACTIVE(CHORE_MINING)) {
-					do_chore_mining(emp, room);
-				}
+				do_chore_mining(emp, room);
 			}
-			else if (IS_MAP_BUILDING(room) && !ROOM_AFF_FLAGGED(room, ROOM_AFF_NO_DISMANTLE) && CHORE_ACTIVE(CHORE_DISMANTLE_MINES)) {
-				// no ore left
+			break;
+		}
+		case CHORE_DISMANTLE_MINES: {
+			// no ore left
+			if (get_room_extra_data(room, ROOM_EXTRA_MINE_AMOUNT) <= 0 && !ROOM_AFF_FLAGGED(room, ROOM_AFF_NO_DISMANTLE)) {
 				do_chore_dismantle_mines(emp, room);
 			}
+			break;
 		}
-		
-		if (HAS_FUNCTION(room, FNC_POTTER) && CHORE_ACTIVE(CHORE_BRICKMAKING)) {
+		case CHORE_BRICKMAKING: {
 			do_chore_brickmaking(emp, room);
+			break;
 		}
-		if (HAS_FUNCTION(room, FNC_SMELT) && CHORE_ACTIVE(CHORE_SMELTING)) {
+		case CHORE_SMELTING: {
 			do_chore_gen_craft(emp, room, CHORE_SMELTING, chore_smelting, FALSE);
+			break;
 		}
-		if (HAS_FUNCTION(room, FNC_TAILOR) && CHORE_ACTIVE(CHORE_WEAVING)) {
+		case CHORE_WEAVING: {
 			do_chore_gen_craft(emp, room, CHORE_WEAVING, chore_weaving, FALSE);
+			break;
 		}
-		if (HAS_FUNCTION(room, FNC_FORGE) && CHORE_ACTIVE(CHORE_NAILMAKING)) {
+		case CHORE_NAILMAKING: {
 			do_chore_nailmaking(emp, room);
+			break;
 		}
-		if (HAS_FUNCTION(room, FNC_SAW) && CHORE_ACTIVE(CHORE_SCRAPING)) {
+		case CHORE_SCRAPING: {
 			do_chore_einv_interaction(emp, room, CHORE_SCRAPING, INTERACT_SCRAPE);
+			break;
 		}
-		if (HAS_FUNCTION(room, FNC_DIGGING) && CHORE_ACTIVE(CHORE_DIGGING)) {
+		case CHORE_DIGGING: {
+			// this has always run twice per cycle
 			do_chore_digging(emp, room);
-		}
-		if (HAS_FUNCTION(room, FNC_DIGGING) && CHORE_ACTIVE(CHORE_DIGGING)) {
 			do_chore_digging(emp, room);
+			break;
 		}
-		if (BUILDING_VNUM(room) == BUILDING_TRAPPERS_POST && EMPIRE_HAS_TECH(emp, TECH_SKILLED_LABOR) && CHORE_ACTIVE(CHORE_TRAPPING)) {
-			do_chore_trapping(emp, room);
+		case CHORE_TRAPPING: {
+			if (EMPIRE_HAS_TECH(emp, TECH_SKILLED_LABOR)) {
+				do_chore_trapping(emp, room);
+			}
+			break;
 		}
-		if (HAS_FUNCTION(room, FNC_TANNERY) && CHORE_ACTIVE(CHORE_TANNING)) {
+		case CHORE_TANNING: {
 			do_chore_einv_interaction(emp, room, CHORE_TANNING, INTERACT_TAN);
+			break;
 		}
-		if (HAS_FUNCTION(room, FNC_STABLE) && CHORE_ACTIVE(CHORE_SHEARING)) {
+		case CHORE_SHEARING: {
 			do_chore_shearing(emp, room);
+			break;
 		}
-		if (CHORE_ACTIVE(CHORE_QUARRYING) && CAN_INTERACT_ROOM(room, INTERACT_QUARRY)) {
+		case CHORE_QUARRYING: {
 			do_chore_quarrying(emp, room);
+			break;
 		}
-		if (HAS_FUNCTION(room, FNC_SAW) && CHORE_ACTIVE(CHORE_SAWING)) {
+		case CHORE_SAWING: {
 			do_chore_einv_interaction(emp, room, CHORE_SAWING, INTERACT_SAW);
+			break;
 		}
-		if (HAS_FUNCTION(room, FNC_MILL) && CHORE_ACTIVE(CHORE_MILLING)) {
+		case CHORE_MILLING: {
 			do_chore_gen_craft(emp, room, CHORE_MILLING, chore_milling, FALSE);
+			break;
 		}
-		if (HAS_FUNCTION(room, FNC_PRESS) && CHORE_ACTIVE(CHORE_OILMAKING)) {
+		case CHORE_OILMAKING: {
 			do_chore_gen_craft(emp, room, CHORE_OILMAKING, chore_pressing, FALSE);
+			break;
 		}
-		if (BUILDING_VNUM(room) == RTYPE_SORCERER_TOWER && CHORE_ACTIVE(CHORE_NEXUS_CRYSTALS) && EMPIRE_HAS_TECH(emp, TECH_SKILLED_LABOR) && EMPIRE_HAS_TECH(emp, TECH_EXARCH_CRAFTS)) {
-			do_chore_gen_craft(emp, room, CHORE_NEXUS_CRYSTALS, chore_nexus_crystals, TRUE);
+		case CHORE_NEXUS_CRYSTALS: {
+			if (EMPIRE_HAS_TECH(emp, TECH_SKILLED_LABOR) && EMPIRE_HAS_TECH(emp, TECH_EXARCH_CRAFTS)) {
+				do_chore_gen_craft(emp, room, CHORE_NEXUS_CRYSTALS, chore_nexus_crystals, TRUE);
+			}
+			break;
 		}
 	}
 }
@@ -577,11 +824,12 @@ bool can_gain_chore_resource_from_interaction(empire_data *emp, room_data *room,
 void chore_update(void) {
 	void ewt_free_tracker(struct empire_workforce_tracker **tracker);
 	
-	struct empire_territory_data *ter;
+	struct empire_chore_room *ecr;
 	vehicle_data *veh, *next_veh;
 	empire_data *emp, *next_emp;
+	int chore;
 	
-	int time_to_empire_emptiness = config_get_int("time_to_empire_emptiness") * SECS_PER_REAL_WEEK;
+	int time_to_empire_emptiness = CONFIG_INT(CONF_TIME_TO_EMPIRE_EMPTINESS) * SECS_PER_REAL_WEEK;
 
 	HASH_ITER(hh, empire_table, emp, next_emp) {
 		// skip idle empires
@@ -593,10 +841,19 @@ void chore_update(void) {
 			// sort einv now to ensure it's in a useful order (most quantity first)
 			LL_SORT(EMPIRE_STORAGE(emp), sort_einv);
 			
-			global_next_territory_entry = NULL;
-			for (ter = EMPIRE_TERRITORY_LIST(emp); ter; ter = global_next_territory_entry) {
-				global_next_territory_entry = ter->next;
-				process_one_chore(emp, ter->room);
+			// only rooms on each chore's worklist can have that work
+			for (chore = 0; chore < NUM_CHORES; ++chore) {
+				for (ecr = EMPIRE_CHORE_ROOMS(emp, chore); ecr; ecr = global_next_chore_room) {
+					global_next_chore_room = ecr->next;
+					
+					if (!room_may_need_chore(ecr->ter->room, chore)) {
+						remove_chore_room(emp, ecr);
+						continue;
+					}
+					
+					process_one_chore(emp, ecr->ter, chore);
+				}
+				global_next_chore_room = NULL;
 			}
 			
 			LL_FOREACH_SAFE(vehicle_list, veh, next_veh) {
@@ -752,43 +1009,120 @@ char_data *find_chore_worker_in_room(room_data *room, mob_vnum vnum) {
 }
 
 
+/**
+* Checks the citizens in one workforce index cell for find_free_npc_for_chore,
+* updating the closest free one and the closest backup (one whose citizen mob
+* can be repurposed).
+*
+* @param struct empire_npc_cell *cell The cell to check (may be NULL).
+* @param room_data *loc The location of the chore.
+* @param int max_dist How far away a citizen may live.
+* @param struct empire_npc_data **found The closest free citizen so far.
+* @param int *found_dist Its distance.
+* @param struct empire_npc_data **backup The closest backup citizen so far.
+* @param int *backup_dist Its distance.
+*/
+static void find_free_npc_in_cell(struct empire_npc_cell *cell, room_data *loc, int max_dist, struct empire_npc_data **found, int *found_dist, struct empire_npc_data **backup, int *backup_dist) {
+	struct empire_npc_data *npc_iter;
+	int dist;
+	
+	if (!cell) {
+		return;
+	}
+	
+	for (npc_iter = cell->npcs; npc_iter; npc_iter = npc_iter->next_in_cell) {
+		// only citizens are indexed, but they must be free or just a citizen (not a laborer)
+		if (npc_iter->mob && (GET_MOB_VNUM(npc_iter->mob) != npc_iter->vnum || FIGHTING(npc_iter->mob))) {
+			continue;
+		}
+		if (!npc_iter->home || GET_ISLAND_ID(loc) != GET_ISLAND_ID(npc_iter->home)) {
+			continue;
+		}
+		if ((dist = compute_distance(loc, npc_iter->home)) > max_dist) {
+			continue;
+		}
+		
+		if (!npc_iter->mob && (!*found || dist < *found_dist)) {
+			*found = npc_iter;
+			*found_dist = dist;
+		}
+		else if (npc_iter->mob && (!*backup || dist < *backup_dist)) {
+			// already has a mob? save as backup
+			*backup = npc_iter;
+			*backup_dist = dist;
+		}
+	}
+}
+
+
 /**
 * This finds an NPC citizen who can do work in the area. It may return an
 * npc who already has a loaded mob. If so, it's ok to repurpose this npc.
 *
+* Citizens are indexed by where they live (EMPIRE_NPC_CELLS), so this only
+* checks the cells within chore_distance of the chore, and picks the closest.
+*
 * @param empire_data *emp The empire looking for a worker.
 * @param room_data *loc The location of the chore.
 * @return struct empire_npc_data* The npc who will help, or NULL.
 */
 struct empire_npc_data *find_free_npc_for_chore(empire_data *emp, room_data *loc) {
-	struct empire_territory_data *ter_iter;
-	struct empire_npc_data *found = NULL, *backup = NULL, *npc_iter;
-	room_data *rm;
+	struct empire_npc_data *found = NULL, *backup = NULL;
+	int found_dist = 0, backup_dist = 0, cell_id, loc_x, loc_y;
+	int span, x_off, y_off, x_cell, y_cell, width, height;
+	struct empire_npc_cell *cell;
 
-	int chore_distance = config_get_int("chore_distance");
+	int chore_distance = CONFIG_INT(CONF_CHORE_DISTANCE);
+	int cells_high = (MAP_HEIGHT + WORKER_CELL_SIZE - 1) / WORKER_CELL_SIZE;
 	
 	if (!emp || !loc) {
 		return NULL;
 	}
 	
-	// massive iteration to try to find one
-	for (ter_iter = EMPIRE_TERRITORY_LIST(emp); ter_iter && !found; ter_iter = ter_iter->next) {
-		// only bother checking anything if npcs live here
-		if (ter_iter->npcs) {			
-			if ((rm = ter_iter->room) && GET_ISLAND_ID(loc) == GET_ISLAND_ID(rm) && compute_distance(loc, rm) <= chore_distance) {
-				// iterate over population
-				for (npc_iter = ter_iter->npcs; npc_iter && !found; npc_iter = npc_iter->next) {
-					// only use citizens for laber
-					if (npc_iter->vnum == CITIZEN_MALE || npc_iter->vnum == CITIZEN_FEMALE) {
-						if (!backup && npc_iter->mob && GET_MOB_VNUM(npc_iter->mob) == npc_iter->vnum && !FIGHTING(npc_iter->mob)) {
-							// already has a mob? save as backup (also making sure the npc's mob is just a citizen not a laborer)
-							backup = npc_iter;
-						}
-						else if (!npc_iter->mob) {
-							found = npc_iter;
+	// homes that can move are always checked
+	cell_id = WORKER_CELL_MOBILE;
+	HASH_FIND_INT(EMPIRE_NPC_CELLS(emp), &cell_id, cell);
+	find_free_npc_in_cell(cell, loc, chore_distance, &found, &found_dist, &backup, &backup_dist);
+	
+	// nearby cells (one extra on each side covers homes at the edge of a cell)
+	loc_x = X_COORD(loc);
+	loc_y = Y_COORD(loc);
+	if (loc_x >= 0 && loc_y >= 0) {
+		span = chore_distance / WORKER_CELL_SIZE + 1;
+		width = MIN(2 * span + 1, WORKER_CELLS_WIDE);
+		height = MIN(2 * span + 1, cells_high);
+		
+		for (y_off = 0; y_off < height; ++y_off) {
+			if (height == cells_high) {
+				y_cell = y_off;	// covers the whole height
+			}
+			else {
+				y_cell = loc_y / WORKER_CELL_SIZE - span + y_off;
+				if (y_cell < 0 || y_cell >= cells_high) {
+					if (!WRAP_Y) {
+						continue;
+					}
+					y_cell = (y_cell + cells_high) % cells_high;
+				}
+			}
+			
+			for (x_off = 0; x_off < width; ++x_off) {
+				if (width == WORKER_CELLS_WIDE) {
+					x_cell = x_off;	// covers the whole width
+				}
+				else {
+					x_cell = loc_x / WORKER_CELL_SIZE - span + x_off;
+					if (x_cell < 0 || x_cell >= WORKER_CELLS_WIDE) {
+						if (!WRAP_X) {
+							continue;
 						}
+						x_cell = (x_cell + WORKER_CELLS_WIDE) % WORKER_CELLS_WIDE;
 					}
 				}
+				
+				cell_id = x_cell + y_cell * WORKER_CELLS_WIDE;
+				HASH_FIND_INT(EMPIRE_NPC_CELLS(emp), &cell_id, cell);
+				find_free_npc_in_cell(cell, loc, chore_distance, &found, &found_dist, &backup, &backup_dist);
 			}
 		}
 	}
@@ -1834,7 +2168,7 @@ INTERACTION_FUNC(one_quarry_chore) {
 
 void do_chore_quarrying(empire_data *emp, room_data *room) {
 	char_data *worker = find_chore_worker_in_room(room, chore_data[CHORE_QUARRYING].mob);
-	bool depleted = (get_depletion(room, DPLTN_QUARRY) >= config_get_int("common_depletion")) ? TRUE : FALSE;
+	bool depleted = (get_depletion(room, DPLTN_QUARRY) >= CONFIG_INT(CONF_COMMON_DEPLETION)) ? TRUE : FALSE;
 	bool can_do = !depleted && can_gain_chore_resource_from_interaction(emp, room, CHORE_QUARRYING, INTERACT_QUARRY);
 	
 	if (worker && can_do) {